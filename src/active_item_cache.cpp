@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <utility>
 
+#include "calendar.h"
 #include "item.h"
 #include "safe_reference.h"
 
@@ -28,6 +29,10 @@ void active_item_cache::remove( const item *it )
             return false;
         } ), list.second.second.end() );
     }
+    const auto asleep = sleeping_by_item.find( it );
+    if( asleep != sleeping_by_item.end() ) {
+        erase_sleeping( asleep->second );
+    }
     if( it->can_revive() ) {
         std::vector<cache_reference<item>> &corpse = special_items[ special_item_type::corpse ];
         corpse.erase( std::remove( corpse.begin(), corpse.end(), it ), corpse.end() );
@@ -45,6 +50,10 @@ void active_item_cache::add( item &it )
     if( std::find( target_list.begin(), target_list.end(), it ) != target_list.end() ) {
         return;
     }
+    // Being added again means something changed, so a sleeping item is processed as usual.
+    if( wake( it ) ) {
+        return;
+    }
     if( it.can_revive() ) {
         special_items[ special_item_type::corpse ].emplace_back( it );
     }
@@ -56,7 +65,8 @@ void active_item_cache::add( item &it )
 
 bool active_item_cache::empty() const
 {
-    return std::all_of( active_items.begin(), active_items.end(), []( const auto & active_queue ) {
+    return sleeping.empty() &&
+    std::all_of( active_items.begin(), active_items.end(), []( const auto & active_queue ) {
         return active_queue.second.second.empty();
     } );
 }
@@ -75,12 +85,30 @@ std::vector<item *> active_item_cache::get()
             }
         }
     }
+    for( auto it = sleeping.begin(); it != sleeping.end(); ) {
+        if( it->second.ref ) {
+            all_cached_items.push_back( &*it->second.ref );
+            ++it;
+        } else {
+            const auto dead = it++;
+            erase_sleeping( dead );
+        }
+    }
     return all_cached_items;
 }
 
 std::vector<item *> active_item_cache::get_for_processing()
 {
     std::vector<item *> items_to_process;
+    while( !sleeping.empty() && sleeping.begin()->first <= calendar::turn ) {
+        auto due = sleeping.begin();
+        if( due->second.ref ) {
+            item &woken = *due->second.ref;
+            items_to_process.push_back( &woken );
+            active_items[woken.processing_speed()].second.emplace_back( woken );
+        }
+        erase_sleeping( due );
+    }
     for( std::pair < const int, std::pair<int, std::vector<cache_reference<item>>>> &kv :
          active_items ) {
         //The algorithm here is a bit weird. We're going to process a fraction of the list at a time, keeping track of where we are in the list with a simple int.
@@ -121,6 +149,54 @@ std::vector<item *> active_item_cache::get_for_processing()
     return items_to_process;
 }
 
+void active_item_cache::sleep( item &it, time_point until )
+{
+    std::pair<int, std::vector<cache_reference<item>>> &queue = active_items[it.processing_speed()];
+    std::vector<cache_reference<item>> &list = queue.second;
+    const auto found = std::find( list.begin(), list.end(), it );
+    if( found == list.end() ) {
+        return;
+    }
+    // Same bookkeeping as remove().
+    if( found - list.begin() >= queue.first ) {
+        queue.first = std::max( 0, queue.first - 1 );
+    }
+    list.erase( found );
+    // A destroyed item may have left an entry at the same address.
+    const auto stale = sleeping_by_item.find( &it );
+    if( stale != sleeping_by_item.end() ) {
+        erase_sleeping( stale->second );
+    }
+    sleeping_by_item.emplace( &it, sleeping.emplace( until, sleeper{ &it, it } ) );
+}
+
+bool active_item_cache::wake( const item &it )
+{
+    const auto asleep = sleeping_by_item.find( &it );
+    if( asleep == sleeping_by_item.end() ) {
+        return false;
+    }
+    const auto iter = asleep->second;
+    if( !( iter->second.ref == it ) ) {
+        // Left behind by a destroyed item that had the same address
+        erase_sleeping( iter );
+        return false;
+    }
+    item &woken = *iter->second.ref;
+    erase_sleeping( iter );
+    active_items[woken.processing_speed()].second.emplace_back( woken );
+    return true;
+}
+
+void active_item_cache::erase_sleeping( sleep_queue::iterator iter )
+{
+    const auto indexed = sleeping_by_item.find( iter->second.key );
+    if( indexed != sleeping_by_item.end() && indexed->second == iter ) {
+        sleeping_by_item.erase( indexed );
+    }
+    sleeping.erase( iter );
+}
+
 std::vector<item *> active_item_cache::get_special( special_item_type type )
 {
     std::vector<item *> matching_items;
@@ -2,9 +2,11 @@
 
 #include <iosfwd>
 #include <list>
+#include <map>
 #include <unordered_map>
 #include <vector>
 
+#include "calendar.h"
 #include "point.h"
 #include "safe_reference.h"
 
@@ -31,6 +33,18 @@ class active_item_cache
     private:
         std::unordered_map<int, std::pair<int, std::vector<cache_reference<item>>>> active_items;
         std::unordered_map<special_item_type, std::vector<cache_reference<item>>> special_items;
+        /** An item put to sleep, @ref key is its address when it fell asleep. */
+        struct sleeper {
+            const item *key;
+            cache_reference<item> ref;
+        };
+        using sleep_queue = std::multimap<time_point, sleeper>;
+        /** Items put to sleep, by the turn they need processing again. See @ref sleep. */
+        sleep_queue sleeping;
+        /** Entries of @ref sleeping by item, so waking one doesn't scan them all. */
+        std::unordered_map<const item *, sleep_queue::iterator> sleeping_by_item;
+        /** Erase from @ref sleeping and @ref sleeping_by_item together. */
+        void erase_sleeping( sleep_queue::iterator iter );
 
     public:
         /**
@@ -41,7 +55,8 @@ class active_item_cache
         void remove( const item *it );
 
         /**
-         * Adds the reference to the cache. Does nothing if the reference is already in the cache.
+         * Adds the reference to the cache. Does nothing if the reference is already in the cache,
+         * wakes it if it is asleep.
          * Relies on the fact that item::processing_speed() is a constant.
          */
         void add( item &it );
@@ -60,13 +75,27 @@ class active_item_cache
         /**
          * Returns the first size() / processing_speed() elements of each list, rounded up.
          * Items returned are rotated to the back of their respective lists, otherwise only the
-         * first n items will ever be processed.
+         * first n items will ever be processed. Sleeping items that are due are woken and
+         * returned as well.
          * Broken references encountered when collecting the items to be processed are removed from
          * the cache.
          * Relies on the fact that item::processing_speed() is a constant.
          */
         std::vector<item *> get_for_processing();
 
+        /**
+         * Leaves @p it out of @ref get_for_processing until @p until.
+         * For items that only change in ways that can be caught up on later, see
+         * @ref item::only_rots. Does nothing if the item is not in the cache.
+         */
+        void sleep( item &it, time_point until );
+
+        /**
+         * Makes a sleeping item part of the regular processing again.
+         * @returns Whether @p it was asleep.
+         */
+        bool wake( const item &it );
+
         /**
          * Returns the currently tracked list of special active items.
          */
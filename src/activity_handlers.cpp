@@ -3738,6 +3738,8 @@ void activity_handlers::craft_do_turn( player_activity *act, player *p )
 
     // This is to ensure we don't over count skill steps
     craft->item_counter = std::min( craft->item_counter, 10'000'000 );
+    // Progress is stored on the craft itself, which may sit on a workbench
+    craft->notify_location();
 
     // Skill and tools are gained/consumed after every 5% progress
     int five_percent_steps = craft->item_counter / 500'000 - old_counter / 500'000;
@@ -66,6 +66,7 @@
 #include "sdl_wrappers.h"
 #include "sdltiles.h"
 #include "sounds.h"
+#include "sprite_batching.h"
 #include "string_formatter.h"
 #include "string_id.h"
 #include "string_utils.h"
@@ -89,6 +90,11 @@ static const efftype_id effect_ridden( "ridden" );
 static const itype_id itype_corpse( "corpse" );
 
 static const std::string ITEM_HIGHLIGHT( "highlight_item" );
+// Tile ids of vehicle parts and corpses put these in front of the part or monster id
+static const std::string vpart_tile_prefix( "vp_" );
+static const std::string corpse_tile_prefix( "corpse_" );
+static const std::string ridden_tile_prefix( "rid_" );
+
 static const std::string ZOMBIE_REVIVAL_INDICATOR( "zombie_revival_indicator" );
 
 static const std::array<std::string, 8> multitile_keys = {{
@@ -106,6 +112,19 @@ static const std::array<std::string, 8> multitile_keys = {{
 extern int fontwidth;
 extern int fontheight;
 static const std::string empty_string;
+
+static const auto no_subcategory = []() -> const std::string & {
+    return empty_string;
+};
+
+// Monster tiles fall back to the tile of their first species
+static auto monster_subcategory( const mtype &type )
+{
+    return [&type]() -> const std::string & {
+        return type.species.empty() ? empty_string : type.species.begin()->str();
+    };
+}
+
 static const std::array<std::string, 13> TILE_CATEGORY_IDS = {{
         "", // C_NONE,
         "vehicle_part", // C_VEHICLE_PART,
@@ -226,6 +245,82 @@ struct tile_render_info {
     }
 };
 
+struct queued_sprite {
+    // null for a filled rectangle of `color`
+    const texture *tex;
+    SDL_Rect destination;
+    int rotation;
+    SDL_RendererFlip flip;
+    // alpha to set on the texture before drawing, or -1 to leave it as it is
+    int alpha;
+    SDL_Color color;
+    // screen position of the square the sprite was drawn for
+    point cell;
+    // how many sprites were drawn for the same square right before this one
+    int order_in_cell;
+    size_t sequence;
+    bool cell_local;
+
+    const SDL_Texture *sdl_texture() const {
+        return tex ? tex->sdl_texture() : nullptr;
+    }
+
+    /** Whether both put the same pixels on screen. */
+    bool draws_same( const queued_sprite &other ) const {
+        if( tex != other.tex || destination.x != other.destination.x ||
+            destination.y != other.destination.y || destination.w != other.destination.w ||
+            destination.h != other.destination.h ) {
+            return false;
+        }
+        if( !tex ) {
+            return color.r == other.color.r && color.g == other.color.g && color.b == other.color.b &&
+                   color.a == other.color.a;
+        }
+        return rotation == other.rotation && flip == other.flip && alpha == other.alpha;
+    }
+};
+
+/** Sprites of the map drawn this frame and last frame, by square. */
+struct map_frame {
+    std::vector<queued_sprite> sprites;
+    // sprites of square `i` are `sprites[cell_start[i]]` up to `sprites[cell_start[i + 1]]`
+    std::vector<int> cell_start;
+};
+
+struct sprite_draw_list {
+    std::vector<queued_sprite> sprites;
+    // scratch space of flush_draw_list and finish_map_frame, kept to avoid reallocating every frame
+    std::vector<point> run_cells;
+    std::vector<int> positions;
+
+    // While drawing into `backbuffer`, flushed sprites collect here until the map is done.
+    bool deferring = false;
+    std::vector<queued_sprite> frame;
+    SDL_Texture_Ptr backbuffer;
+    SDL_Rect backbuffer_area = { 0, 0, 0, 0 };
+    // What `backbuffer` currently shows, only valid if `previous_valid`.
+    map_frame previous;
+    map_frame current;
+    bool previous_valid = false;
+};
+
+static void render_queued_sprite( const SDL_Renderer_Ptr &renderer,
+                                  const GeometryRenderer_Ptr &geometry, const queued_sprite &qs, point offset )
+{
+    SDL_Rect destination = qs.destination;
+    destination.x -= offset.x;
+    destination.y -= offset.y;
+    if( !qs.tex ) {
+        geometry->rect( renderer, destination, qs.color );
+        return;
+    }
+    if( qs.alpha >= 0 ) {
+        qs.tex->set_alpha_mod( qs.alpha );
+    }
+    const int ret = qs.tex->render_copy_ex( renderer, &destination, qs.rotation, nullptr, qs.flip );
+    printErrorIf( ret != 0, "SDL_RenderCopyEx() failed" );
+}
+
 cata_tiles::cata_tiles( const SDL_Renderer_Ptr &renderer, const GeometryRenderer_Ptr &geometry ) :
     renderer( renderer ),
     geometry( geometry ),
@@ -272,6 +367,8 @@ void cata_tiles::on_options_changed()
     settings.scale_to_fit = get_option<bool>( "PIXEL_MINIMAP_SCALE_TO_FIT" );
 
     minimap->set_settings( settings );
+
+    dirty_region_rendering = get_option<bool>( "DIRTY_REGION_RENDERING" );
 }
 
 const tile_type *tileset::find_tile_type( const std::string &id ) const
@@ -362,6 +459,8 @@ void cata_tiles::load_tileset(
     loader.load( tileset_id, precheck, /*pump_events=*/pump_events );
     tileset_ptr = std::move( new_tileset_ptr );
     tileset_mod_list_stamp = mod_list;
+    clear_resolved_tiles();
+    invalidate_map_frame();
 
     set_draw_scale( 16 );
 
@@ -370,6 +469,7 @@ void cata_tiles::load_tileset(
 
 void cata_tiles::reinit()
 {
+    draw_list->backbuffer.reset();
     set_draw_scale( 16 );
     RenderClear( renderer );
 }
@@ -643,6 +743,7 @@ void cata_tiles::set_draw_scale( int scale )
 
     tile_ratiox = ( static_cast<float>( tile_width ) / static_cast<float>( fontwidth ) );
     tile_ratioy = ( static_cast<float>( tile_height ) / static_cast<float>( fontheight ) );
+    invalidate_map_frame();
 }
 
 std::optional<tile_search_result> cata_tiles::tile_type_search(
@@ -1438,6 +1539,9 @@ void cata_tiles::draw( point dest, const tripoint &center, int width, int height
     std::vector<tile_render_info> &draw_points = *draw_points_cache;
     int min_z = OVERMAP_HEIGHT;
 
+    // Each pass below draws every square at most once, so its sprites can be grouped by texture.
+    begin_map_frame( dest, width, height );
+
     for( int row = min_row; row < max_row; row ++ ) {
 
         draw_points.clear();
@@ -1687,6 +1791,7 @@ void cata_tiles::draw( point dest, const tripoint &center, int width, int height
         for( tile_render_info &p : draw_points ) {
             draw_terrain( p.pos, p.ll, p.height_3d, p.invisible, center.z - p.pos.z );
         }
+        flush_draw_list();
 
         for( int z = min_z; z <= center.z; z++ ) {
             for( tile_render_info &p : draw_points ) {
@@ -1711,6 +1816,7 @@ void cata_tiles::draw( point dest, const tripoint &center, int width, int height
                     }
                 }
             }
+            flush_draw_list();
         }
 
         for( tile_render_info &p : draw_points ) {
@@ -1718,7 +1824,9 @@ void cata_tiles::draw( point dest, const tripoint &center, int width, int height
                 ( this->*f )( p.pos, p.ll, p.height_3d, p.invisible, 0 );
             }
         }
+        flush_draw_list();
     }
+    finish_map_frame();
 
     // display number of monsters to spawn in mapgen preview
     for( const tile_render_info &p : draw_points ) {
@@ -2169,29 +2277,161 @@ bool cata_tiles::draw_from_id_string( const std::string &id, TILE_CATEGORY categ
         return false;
     }
 
+    const resolved_tile res = resolve_tile( id, category, subcategory, subtile, rota );
+    if( !res.tt ) {
+        return false;
+    }
+    return draw_resolved_tile( res, category, pos, rota, ll, apply_night_vision_goggles, height_3d,
+                               overlay_count, as_independent_entity );
+}
+
+template<typename T>
+bool cata_tiles::draw_from_int_id( const int_id<T> &id, TILE_CATEGORY category,
+                                   const tripoint &pos, int subtile, int rota, lit_level ll,
+                                   bool apply_night_vision_goggles, int &height_3d, int overlay_count )
+{
+    half_open_rectangle<point> screen_bounds( o, o + point( screentile_width, screentile_height ) );
+    if( !tile_iso && !screen_bounds.contains( pos.xy() ) ) {
+        return false;
+    }
+
+    const resolved_tile *res = find_resolved_tile( id, category, subtile );
+    if( !res ) {
+        return draw_from_id_string( id.id().str(), category, empty_string, pos, subtile, rota, ll,
+                                    apply_night_vision_goggles, height_3d, overlay_count );
+    }
+    if( !res->tt ) {
+        return false;
+    }
+    return draw_resolved_tile( *res, category, pos, rota, ll, apply_night_vision_goggles, height_3d,
+                               overlay_count, false );
+}
+
+template<typename T, typename Subcategory>
+bool cata_tiles::draw_from_string_id( const string_id<T> &id, const std::string &prefix,
+                                      TILE_CATEGORY category, Subcategory &&subcategory, const tripoint &pos, int subtile,
+                                      int rota, lit_level ll, bool apply_night_vision_goggles, int &height_3d, int overlay_count )
+{
+    half_open_rectangle<point> screen_bounds( o, o + point( screentile_width, screentile_height ) );
+    if( !tile_iso && !screen_bounds.contains( pos.xy() ) ) {
+        return false;
+    }
+
+    const resolved_tile &res = find_resolved_tile( id, prefix, category, subtile, rota,
+                               std::forward<Subcategory>( subcategory ) );
+    if( !res.tt ) {
+        return false;
+    }
+    return draw_resolved_tile( res, category, pos, rota, ll, apply_night_vision_goggles, height_3d,
+                               overlay_count, false );
+}
+
+resolved_tile cata_tiles::resolve_tile( const std::string &id, TILE_CATEGORY category,
+                                        const std::string &subcategory, int subtile, int rota )
+{
+    resolved_tile res;
     // Trying to search for tile type
     std::optional<tile_search_result> search_result;
     search_result = tile_type_search( id, category, subcategory, subtile, rota );
     if( search_result == std::nullopt ) {
-        return false;
+        return res;
     }
 
-    const tile_type *tt = search_result.value().tt;
-    std::string found_id = search_result.value().found_id;
-
-    const tile_type &display_tile = *tt;
+    const tile_type &display_tile = *search_result->tt;
     // check to see if the display_tile is multitile, and if so if it has the key related to subtile
     if( subtile != -1 && display_tile.multitile ) {
         const auto &display_subtiles = display_tile.available_subtiles;
         const auto end = std::end( display_subtiles );
         if( std::find( begin( display_subtiles ), end, multitile_keys[subtile] ) != end ) {
             // append subtile name to tile and re-find display_tile
-            return draw_from_id_string( found_id + "_" + multitile_keys[subtile],
-                                        category, subcategory, pos, -1, rota, ll, apply_night_vision_goggles,
-                                        height_3d, overlay_count );
+            return resolve_tile( search_result->found_id + "_" + multitile_keys[subtile],
+                                 category, subcategory, -1, rota );
         }
     }
 
+    res.tt = search_result->tt;
+    res.found_id = std::move( search_result->found_id );
+    if( category == C_FURNITURE ) {
+        // If the furniture is not movable, we'll allow seeding by the position
+        // since we won't get the behavior that occurs where the tile constantly
+        // changes when the player grabs the furniture and drags it, causing the
+        // seed to change.
+        const furn_str_id fid( res.found_id );
+        res.seed_from_position = fid.is_valid() && !fid.obj().is_movable();
+    }
+    return res;
+}
+
+template<typename T>
+const resolved_tile *cata_tiles::find_resolved_tile( const int_id<T> &id, TILE_CATEGORY category,
+        int subtile )
+{
+    if( subtile < -1 || subtile >= static_cast<int>( multitile_keys.size() ) ) {
+        return nullptr;
+    }
+    const season_type season = season_of_year( calendar::turn );
+    if( season != resolved_tiles_season ) {
+        clear_resolved_tiles();
+        resolved_tiles_season = season;
+    }
+
+    std::vector<resolved_tile_variants> &cache = resolved_tiles[category];
+    const size_t index = id.to_i();
+    if( index >= cache.size() ) {
+        cache.resize( index + 1 );
+    }
+    resolved_tile_variants &variants = cache[index];
+    const std::string &id_str = id.id().str();
+    if( variants.id != &id_str ) {
+        variants = resolved_tile_variants();
+        variants.id = &id_str;
+    }
+    std::optional<resolved_tile> &res = variants.by_subtile[subtile + 1];
+    if( !res ) {
+        res = resolve_tile( id_str, category, empty_string, subtile, 0 );
+    }
+    return &*res;
+}
+
+template<typename T, typename Subcategory>
+const resolved_tile &cata_tiles::find_resolved_tile( const string_id<T> &id,
+        const std::string &prefix, TILE_CATEGORY category, int subtile, int rota,
+        Subcategory &&subcategory )
+{
+    const season_type season = season_of_year( calendar::turn );
+    if( season != resolved_tiles_season ) {
+        clear_resolved_tiles();
+        resolved_tiles_season = season;
+    }
+
+    static_assert( !string_id_params<T>::dynamic, "only interned ids have a stable string" );
+    // Interned strings never move, their address identifies the id
+    const std::string &id_str = id.str();
+    const string_tile_key key( &id_str, &prefix, category, subtile, rota );
+    auto iter = resolved_string_tiles.find( key );
+    if( iter == resolved_string_tiles.end() ) {
+        iter = resolved_string_tiles.emplace( key, resolve_tile( prefix + id_str, category,
+                                              subcategory(), subtile, rota ) ).first;
+    }
+    return iter->second;
+}
+
+void cata_tiles::clear_resolved_tiles()
+{
+    for( std::vector<resolved_tile_variants> &cache : resolved_tiles ) {
+        cache.clear();
+    }
+    resolved_string_tiles.clear();
+}
+
+bool cata_tiles::draw_resolved_tile( const resolved_tile &res, TILE_CATEGORY category,
+                                     const tripoint &pos, int rota, lit_level ll,
+                                     bool apply_night_vision_goggles, int &height_3d, int overlay_count,
+                                     bool as_independent_entity )
+{
+    const tile_type &display_tile = *res.tt;
+    const std::string &found_id = res.found_id;
+
     // translate from player-relative to screen relative tile position
     const point screen_pos = as_independent_entity ? pos.xy() : player_to_screen( pos.xy() );
 
@@ -2244,20 +2484,11 @@ bool cata_tiles::draw_from_id_string( const std::string &id, TILE_CATEGORY categ
 
         }
         break;
-        case C_FURNITURE: {
-            // If the furniture is not movable, we'll allow seeding by the position
-            // since we won't get the behavior that occurs where the tile constantly
-            // changes when the player grabs the furniture and drags it, causing the
-            // seed to change.
-            const furn_str_id fid( found_id );
-            if( fid.is_valid() ) {
-                const furn_t &f = fid.obj();
-                if( !f.is_movable() ) {
-                    seed = simple_point_hash( here.getabs( pos ) );
-                }
+        case C_FURNITURE:
+            if( res.seed_from_position ) {
+                seed = simple_point_hash( here.getabs( pos ) );
             }
-        }
-        break;
+            break;
         case C_ITEM:
         case C_TRAP:
             if( seed_for_animation ) {
@@ -2475,6 +2706,14 @@ bool cata_tiles::draw_sprite_at(
     destination.h = height * tile_height / tileset_ptr->get_tile_height();
 
     auto render = [&]( const int rotation, const SDL_RendererFlip flip ) {
+        if( queueing_sprites ) {
+            queue_sprite( sprite_tex, p, destination, rotation, flip, -1, SDL_Color() );
+            if( !static_z_effect && overlay && overlay_alpha > 0 ) {
+                queue_sprite( overlay, p, destination, rotation, flip, std::min( 192, overlay_alpha ),
+                              SDL_Color() );
+            }
+            return 0;
+        }
         int ret = sprite_tex->render_copy_ex( renderer, &destination, rotation, nullptr, flip );
         if( !static_z_effect && overlay && overlay_alpha > 0 ) {
             overlay->set_alpha_mod( std::min( 192, overlay_alpha ) );
@@ -2545,8 +2784,200 @@ bool cata_tiles::draw_tile_at(
     return true;
 }
 
+void cata_tiles::queue_sprite( const texture *tex, point cell, const SDL_Rect &destination,
+                               int rotation, SDL_RendererFlip flip, int alpha, const SDL_Color &color )
+{
+    std::vector<queued_sprite> &sprites = draw_list->sprites;
+    int order_in_cell = 0;
+    if( !sprites.empty() && sprites.back().cell == cell ) {
+        order_in_cell = sprites.back().order_in_cell + 1;
+    }
+    // Sprites within their own square can't overlap other squares. Isometric tiles
+    // always overlap their neighbours, and turning a non-square tile makes it stick out.
+    const bool inside = destination.x >= cell.x && destination.y >= cell.y &&
+                        destination.x + destination.w <= cell.x + tile_width &&
+                        destination.y + destination.h <= cell.y + tile_height;
+    const bool cell_local = !tile_iso && inside &&
+                            ( rotation == 0 || ( tile_width == tile_height && destination.x == cell.x &&
+                                    destination.y == cell.y && destination.w == tile_width &&
+                                    destination.h == tile_height ) );
+    sprites.push_back( queued_sprite{ tex, destination, rotation, flip, alpha, color, cell,
+                                      order_in_cell, sprites.size(), cell_local } );
+}
+
+void cata_tiles::flush_draw_list()
+{
+    std::vector<queued_sprite> &sprites = draw_list->sprites;
+    if( sprites.empty() ) {
+        return;
+    }
+
+    bool can_reorder = std::all_of( sprites.begin(), sprites.end(), []( const queued_sprite & qs ) {
+        return qs.cell_local;
+    } );
+    if( can_reorder ) {
+        // A square drawn in two separate runs would get its sprites mixed up by the sort.
+        std::vector<point> &cells = draw_list->run_cells;
+        cells.clear();
+        for( const queued_sprite &qs : sprites ) {
+            if( qs.order_in_cell == 0 ) {
+                cells.push_back( qs.cell );
+            }
+        }
+        std::sort( cells.begin(), cells.end() );
+        can_reorder = std::adjacent_find( cells.begin(), cells.end() ) == cells.end();
+    }
+    if( can_reorder ) {
+        cata::sort_sprites_by_texture( sprites, []( const queued_sprite & qs ) {
+            return std::make_tuple( qs.alpha, qs.color.r, qs.color.g, qs.color.b, qs.color.a );
+        }, []( const queued_sprite & qs ) {
+            return std::make_tuple( qs.order_in_cell, qs.sdl_texture(), qs.sequence );
+        } );
+    }
+
+    if( draw_list->deferring ) {
+        draw_list->frame.insert( draw_list->frame.end(), sprites.begin(), sprites.end() );
+    } else {
+        for( const queued_sprite &qs : sprites ) {
+            render_queued_sprite( renderer, geometry, qs, point_zero );
+        }
+    }
+    sprites.clear();
+}
+
+void cata_tiles::begin_map_frame( point dest, int width, int height )
+{
+    queueing_sprites = true;
+    sprite_draw_list &dl = *draw_list;
+    dl.deferring = false;
+    if( !dirty_region_rendering || tile_iso ) {
+        dl.backbuffer.reset();
+        dl.previous_valid = false;
+        return;
+    }
+
+    const SDL_Rect area = { dest.x, dest.y, width, height };
+    if( !dl.backbuffer || area.x != dl.backbuffer_area.x || area.y != dl.backbuffer_area.y ||
+        area.w != dl.backbuffer_area.w || area.h != dl.backbuffer_area.h ) {
+        dl.backbuffer = CreateTexture( renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+                                       width, height );
+        if( !dl.backbuffer ) {
+            return;
+        }
+        SetTextureBlendMode( dl.backbuffer, SDL_BLENDMODE_NONE );
+        dl.backbuffer_area = area;
+        dl.previous_valid = false;
+    }
+    dl.deferring = true;
+}
+
+void cata_tiles::finish_map_frame()
+{
+    flush_draw_list();
+    queueing_sprites = false;
+    sprite_draw_list &dl = *draw_list;
+    if( !dl.deferring ) {
+        return;
+    }
+    dl.deferring = false;
+
+    // Squares can only be redrawn on their own if nothing drawn for them reaches into another.
+    const point origin( dl.backbuffer_area.x, dl.backbuffer_area.y );
+    const bool by_cell = std::all_of( dl.frame.begin(), dl.frame.end(), [&]( const queued_sprite & qs ) {
+        const point cell = qs.cell - origin;
+        return qs.cell_local && cell.x >= 0 && cell.y >= 0 &&
+               cell.x < screentile_width * tile_width && cell.y < screentile_height * tile_height &&
+               cell.x % tile_width == 0 && cell.y % tile_height == 0;
+    } );
+    if( !by_cell ) {
+        discard_map_frame();
+        return;
+    }
+
+    // Group the sprites by square, keeping their order within each square.
+    const int num_cells = screentile_width * screentile_height;
+    const auto cell_index = [&]( const queued_sprite & qs ) {
+        const point cell = qs.cell - origin;
+        return cell.y / tile_height * screentile_width + cell.x / tile_width;
+    };
+    map_frame &current = dl.current;
+    current.cell_start.assign( num_cells + 1, 0 );
+    for( const queued_sprite &qs : dl.frame ) {
+        current.cell_start[cell_index( qs ) + 1]++;
+    }
+    for( int i = 0; i < num_cells; i++ ) {
+        current.cell_start[i + 1] += current.cell_start[i];
+    }
+    dl.positions.assign( current.cell_start.begin(), current.cell_start.end() - 1 );
+    current.sprites.resize( dl.frame.size() );
+    for( const queued_sprite &qs : dl.frame ) {
+        current.sprites[dl.positions[cell_index( qs )]++] = qs;
+    }
+
+    const map_frame &previous = dl.previous;
+    const bool redraw_all = !dl.previous_valid || previous.cell_start.size() != current.cell_start.size();
+    SetRenderTarget( renderer, dl.backbuffer );
+    if( redraw_all ) {
+        geometry->rect( renderer, SDL_Rect{ 0, 0, dl.backbuffer_area.w, dl.backbuffer_area.h },
+                        SDL_Color() );
+        for( const queued_sprite &qs : dl.frame ) {
+            render_queued_sprite( renderer, geometry, qs, origin );
+        }
+    } else {
+        const auto same = []( const queued_sprite & a, const queued_sprite & b ) {
+            return a.draws_same( b );
+        };
+        for( int i = 0; i < num_cells; i++ ) {
+            const auto begin = current.sprites.begin() + current.cell_start[i];
+            const auto end = current.sprites.begin() + current.cell_start[i + 1];
+            const auto prev_begin = previous.sprites.begin() + previous.cell_start[i];
+            const auto prev_end = previous.sprites.begin() + previous.cell_start[i + 1];
+            if( std::equal( begin, end, prev_begin, prev_end, same ) ) {
+                continue;
+            }
+            const SDL_Rect cell_rect = { i % screentile_width * tile_width, i / screentile_width * tile_height,
+                                         tile_width, tile_height
+                                       };
+            geometry->rect( renderer, cell_rect, SDL_Color() );
+            for( auto it = begin; it != end; ++it ) {
+                render_queued_sprite( renderer, geometry, *it, origin );
+            }
+        }
+    }
+    set_displaybuffer_rendertarget();
+    // Switching the render target drops the clipping rectangle set by draw().
+    printErrorIf( SDL_RenderSetClipRect( renderer.get(), &dl.backbuffer_area ) != 0,
+                  "SDL_RenderSetClipRect failed" );
+    RenderCopy( renderer, dl.backbuffer, nullptr, &dl.backbuffer_area );
+
+    std::swap( dl.previous, dl.current );
+    dl.previous_valid = true;
+    dl.frame.clear();
+}
+
+void cata_tiles::discard_map_frame()
+{
+    sprite_draw_list &dl = *draw_list;
+    for( const queued_sprite &qs : dl.frame ) {
+        render_queued_sprite( renderer, geometry, qs, point_zero );
+    }
+    dl.frame.clear();
+    dl.deferring = false;
+    dl.previous_valid = false;
+}
+
+void cata_tiles::invalidate_map_frame()
+{
+    draw_list->previous_valid = false;
+}
+
 bool cata_tiles::draw_color_at( const SDL_Color &color, point pos, SDL_BlendMode blend_mode )
 {
+    flush_draw_list();
+    if( draw_list->deferring ) {
+        // Blended fills aren't queued, give up on the backbuffer for this frame.
+        discard_map_frame();
+    }
     SDL_Rect rect{
         pos.x,
         pos.y,
@@ -2637,6 +3068,10 @@ bool cata_tiles::draw_block( const tripoint &p, SDL_Color color, int scale )
         rect.y += tile_height / 8;
     }
 
+    if( queueing_sprites ) {
+        queue_sprite( nullptr, screen, rect, 0, SDL_FLIP_NONE, -1, color );
+        return true;
+    }
     geometry->rect( renderer, rect,  color );
     return true;
 }
@@ -2680,8 +3115,8 @@ bool cata_tiles::draw_terrain( const tripoint &p, const lit_level ll, int &heigh
             if( t == t_open_air ) {
                 return draw_block( p, curses_color_to_SDL( c_cyan ), 4 );
             } else {
-                return draw_from_id_string( tname, C_TERRAIN, empty_string, p, subtile, rotation, ll,
-                                            nv_goggles_activated, height_3d, z_drop );
+                return draw_from_int_id( t, C_TERRAIN, p, subtile, rotation, ll, nv_goggles_activated,
+                                         height_3d, z_drop );
             }
         }
     }
@@ -2699,19 +3134,17 @@ bool cata_tiles::draw_terrain( const tripoint &p, const lit_level ll, int &heigh
             } else {
                 get_terrain_orientation( p, rotation, subtile, terrain_override, invisible );
             }
-            const std::string &tname = t2.id().str();
             // tile overrides are never memorized
             // tile overrides are always shown with full visibility
             const lit_level lit = overridden ? lit_level::LIT : ll;
             const bool nv = overridden ? false : nv_goggles_activated;
-            return draw_from_id_string( tname, C_TERRAIN, empty_string, p, subtile, rotation, lit, nv,
-                                        height_3d, z_drop );
+            return draw_from_int_id( t2, C_TERRAIN, p, subtile, rotation, lit, nv, height_3d, z_drop );
         }
     } else if( invisible[0] && has_terrain_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
         const auto &t = get_terrain_memory_at( p );
 
-        return draw_from_id_string( t.tile, C_TERRAIN, empty_string, p, t.subtile, t.rotation,
+        return draw_from_id_string( t.tile(), C_TERRAIN, empty_string, p, t.subtile, t.rotation,
                                     lit_level::MEMORIZED, nv_goggles_activated, height_3d, z_drop );
     }
     return false;
@@ -2721,7 +3154,7 @@ bool cata_tiles::has_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        return !t.tile.empty();
+        return !t.tile().empty();
     }
     return false;
 }
@@ -2730,7 +3163,7 @@ bool cata_tiles::has_terrain_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( t.tile.starts_with( "t_" ) ) {
+        if( t.tile().starts_with( "t_" ) ) {
             return true;
         }
     }
@@ -2741,7 +3174,7 @@ bool cata_tiles::has_furniture_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( t.tile.starts_with( "f_" ) ) {
+        if( t.tile().starts_with( "f_" ) ) {
             return true;
         }
     }
@@ -2752,7 +3185,7 @@ bool cata_tiles::has_trap_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( t.tile.starts_with( "tr_" ) ) {
+        if( t.tile().starts_with( "tr_" ) ) {
             return true;
         }
     }
@@ -2763,7 +3196,7 @@ bool cata_tiles::has_vpart_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( t.tile.starts_with( "vp_" ) ) {
+        if( t.tile().starts_with( "vp_" ) ) {
             return true;
         }
     }
@@ -2774,7 +3207,7 @@ memorized_terrain_tile cata_tiles::get_terrain_memory_at( const tripoint &p ) co
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( t.tile.starts_with( "t_" ) ) {
+        if( t.tile().starts_with( "t_" ) ) {
             return t;
         }
     }
@@ -2785,7 +3218,7 @@ memorized_terrain_tile cata_tiles::get_furniture_memory_at( const tripoint &p )
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( t.tile.starts_with( "f_" ) ) {
+        if( t.tile().starts_with( "f_" ) ) {
             return t;
         }
     }
@@ -2796,7 +3229,7 @@ memorized_terrain_tile cata_tiles::get_trap_memory_at( const tripoint &p ) const
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( t.tile.starts_with( "tr_" ) ) {
+        if( t.tile().starts_with( "tr_" ) ) {
             return t;
         }
     }
@@ -2807,7 +3240,7 @@ memorized_terrain_tile cata_tiles::get_vpart_memory_at( const tripoint &p ) cons
 {
     if( g->u.should_show_map_memory() ) {
         const memorized_terrain_tile t = g->u.get_memorized_tile( get_map().getabs( p ) );
-        if( t.tile.starts_with( "vp_" ) ) {
+        if( t.tile().starts_with( "vp_" ) ) {
             return t;
         }
     }
@@ -2854,8 +3287,8 @@ bool cata_tiles::draw_furniture( const tripoint &p, const lit_level ll, int &hei
         }
         // draw the actual furniture if there's no override
         if( !neighborhood_overridden ) {
-            return draw_from_id_string( fname, C_FURNITURE, empty_string, p, subtile, rotation, ll,
-                                        nv_goggles_activated, height_3d, z_drop );
+            return draw_from_int_id( f, C_FURNITURE, p, subtile, rotation, ll, nv_goggles_activated,
+                                     height_3d, z_drop );
         }
     }
     if( invisible[0] ? overridden : neighborhood_overridden ) {
@@ -2886,18 +3319,16 @@ bool cata_tiles::draw_furniture( const tripoint &p, const lit_level ll, int &hei
             }
 
             get_tile_values( f2.to_i(), neighborhood, subtile, rotation );
-            const std::string &fname = f2.id().str();
             // tile overrides are never memorized
             // tile overrides are always shown with full visibility
             const lit_level lit = overridden ? lit_level::LIT : ll;
             const bool nv = overridden ? false : nv_goggles_activated;
-            return draw_from_id_string( fname, C_FURNITURE, empty_string, p, subtile, rotation, lit, nv,
-                                        height_3d, z_drop );
+            return draw_from_int_id( f2, C_FURNITURE, p, subtile, rotation, lit, nv, height_3d, z_drop );
         }
     } else if( invisible[0] && has_furniture_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
         const auto &t = get_furniture_memory_at( p );
-        return draw_from_id_string( t.tile, C_FURNITURE, empty_string, p, t.subtile, t.rotation,
+        return draw_from_id_string( t.tile(), C_FURNITURE, empty_string, p, t.subtile, t.rotation,
                                     lit_level::MEMORIZED, nv_goggles_activated, height_3d, z_drop );
     }
     return false;
@@ -2931,14 +3362,14 @@ bool cata_tiles::draw_trap( const tripoint &p, const lit_level ll, int &height_3
         int subtile = 0;
         int rotation = 0;
         get_tile_values( tr.to_i(), neighborhood, subtile, rotation );
-        const std::string trname = tr.id().str();
+        const std::string &trname = tr.id().str();
         if( here.check_seen_cache( p ) && tr != tr_ledge ) {
             g->u.memorize_tile( here.getabs( p ), trname, subtile, rotation );
         }
         // draw the actual trap if there's no override
         if( !neighborhood_overridden ) {
-            return draw_from_id_string( trname, C_TRAP, empty_string, p, subtile, rotation, ll,
-                                        nv_goggles_activated, height_3d, z_drop );
+            return draw_from_int_id( tr, C_TRAP, p, subtile, rotation, ll, nv_goggles_activated,
+                                     height_3d, z_drop );
         }
     }
     if( overridden || ( !invisible[0] && neighborhood_overridden && tr.obj().can_see( p, g->u ) ) ) {
@@ -2961,18 +3392,16 @@ bool cata_tiles::draw_trap( const tripoint &p, const lit_level ll, int &height_3
             int subtile = 0;
             int rotation = 0;
             get_tile_values( tr2.to_i(), neighborhood, subtile, rotation );
-            const std::string &trname = tr2.id().str();
             // tile overrides are never memorized
             // tile overrides are always shown with full visibility
             const lit_level lit = overridden ? lit_level::LIT : ll;
             const bool nv = overridden ? false : nv_goggles_activated;
-            return draw_from_id_string( trname, C_TRAP, empty_string, p, subtile, rotation, lit, nv,
-                                        height_3d, z_drop );
+            return draw_from_int_id( tr2, C_TRAP, p, subtile, rotation, lit, nv, height_3d, z_drop );
         }
     } else if( invisible[0] && has_trap_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
         const auto &t = get_trap_memory_at( p );
-        return draw_from_id_string( t.tile, C_TRAP, empty_string, p, t.subtile, t.rotation,
+        return draw_from_id_string( t.tile(), C_TRAP, empty_string, p, t.subtile, t.rotation,
                                     lit_level::MEMORIZED, nv_goggles_activated, height_3d, z_drop );
     }
     return false;
@@ -3025,8 +3454,9 @@ bool cata_tiles::draw_field_or_item( const tripoint &p, const lit_level ll, int
         int rotation = 0;
         get_tile_values( fld.to_i(), neighborhood, subtile, rotation );
 
-        ret_draw_field = draw_from_id_string( fld.id().str(), C_FIELD, empty_string, p, subtile,
-                                              rotation, lit, nv, z_drop );
+        int nullint = 0;
+        ret_draw_field = draw_from_int_id( fld, C_FIELD, p, subtile, rotation, lit, nv, nullint,
+                                           z_drop );
     }
     if( fld.obj().display_items ) {
         const auto it_override = item_override.find( p );
@@ -3053,14 +3483,19 @@ bool cata_tiles::draw_field_or_item( const tripoint &p, const lit_level ll, int
             it_type = nullptr;
         }
         if( it_type && !it_id.is_null() ) {
-            const std::string disp_id = it_id == itype_corpse && mon_id ?
-                                        "corpse_" + mon_id.str() : it_id.str();
-            const std::string it_category = it_type->get_item_type_string();
+            const auto it_category = [it_type]() {
+                return it_type->get_item_type_string();
+            };
             const lit_level lit = it_overridden ? lit_level::LIT : ll;
             const bool nv = it_overridden ? false : nv_goggles_activated;
 
-            ret_draw_items = draw_from_id_string( disp_id, C_ITEM, it_category, p, 0, 0, lit,
-                                                  nv, height_3d, z_drop );
+            if( it_id == itype_corpse && mon_id ) {
+                ret_draw_items = draw_from_string_id( mon_id, corpse_tile_prefix, C_ITEM, it_category, p, 0, 0,
+                                                      lit, nv, height_3d, z_drop );
+            } else {
+                ret_draw_items = draw_from_string_id( it_id, empty_string, C_ITEM, it_category, p, 0, 0, lit,
+                                                      nv, height_3d, z_drop );
+            }
             if( ret_draw_items && hilite ) {
                 draw_item_highlight( p );
             }
@@ -3088,17 +3523,16 @@ bool cata_tiles::draw_vpart( const tripoint &p, lit_level ll, int &height_3d,
         const vpart_id &vp_id = veh.part_id_string( veh_part, z_drop > 0 && critter == nullptr, part_mod );
         const int subtile = part_mod == 1 ? open_ : part_mod == 2 ? broken : 0;
         const int rotation = std::round( to_degrees( veh.face.dir() ) );
-        const std::string vpname = "vp_" + vp_id.str();
         avatar &you = get_avatar();
         if( !veh.forward_velocity() && !veh.player_in_control( you ) &&
             here.check_seen_cache( p ) ) {
-            you.memorize_tile( here.getabs( p ), vpname, subtile, rotation );
+            you.memorize_tile( here.getabs( p ), vpart_tile_prefix + vp_id.str(), subtile, rotation );
         }
         if( !overridden ) {
             const std::optional<vpart_reference> cargopart = vp.part_with_feature( "CARGO", true );
             const bool draw_highlight = cargopart && !veh.get_items( cargopart->part_index() ).empty();
-            const bool ret = draw_from_id_string( vpname, C_VEHICLE_PART, empty_string, p, subtile, rotation,
-                                                  ll, nv_goggles_activated, height_3d, z_drop );
+            const bool ret = draw_from_string_id( vp_id, vpart_tile_prefix, C_VEHICLE_PART, no_subcategory,
+                                                  p, subtile, rotation, ll, nv_goggles_activated, height_3d, z_drop );
             if( ret && draw_highlight ) {
                 draw_item_highlight( p );
             }
@@ -3113,11 +3547,10 @@ bool cata_tiles::draw_vpart( const tripoint &p, lit_level ll, int &height_3d,
             const int subtile = part_mod == 1 ? open_ : part_mod == 2 ? broken : 0;
             const units::angle rotation = std::get<2>( override->second );
             const int draw_highlight = std::get<3>( override->second );
-            const std::string vpname = "vp_" + vp2.str();
             // tile overrides are never memorized
             // tile overrides are always shown with full visibility
-            const bool ret = draw_from_id_string( vpname, C_VEHICLE_PART, empty_string, p,
-                                                  subtile, to_degrees( rotation ), lit_level::LIT,
+            const bool ret = draw_from_string_id( vp2, vpart_tile_prefix, C_VEHICLE_PART, no_subcategory,
+                                                  p, subtile, to_degrees( rotation ), lit_level::LIT,
                                                   false, height_3d, z_drop );
             if( ret && draw_highlight ) {
                 draw_item_highlight( p );
@@ -3127,7 +3560,7 @@ bool cata_tiles::draw_vpart( const tripoint &p, lit_level ll, int &height_3d,
     } else if( invisible[0] && has_vpart_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
         const auto &t = get_vpart_memory_at( p );
-        return draw_from_id_string( t.tile, C_VEHICLE_PART, empty_string, p, t.subtile, t.rotation,
+        return draw_from_id_string( t.tile(), C_VEHICLE_PART, empty_string, p, t.subtile, t.rotation,
                                     lit_level::MEMORIZED, nv_goggles_activated, height_3d, z_drop );
     }
     return false;
@@ -3152,11 +3585,8 @@ bool cata_tiles::draw_critter_at( const tripoint &p, lit_level ll, int &height_3
         is_player = false;
         sees_player = false;
         attitude = std::get<3>( override->second );
-        const std::string &chosen_id = id.str();
-        const std::string &ent_subcategory = id.obj().species.empty() ?
-                                             empty_string : id.obj().species.begin()->str();
-        result = draw_from_id_string( chosen_id, C_MONSTER, ent_subcategory, p, corner, 0,
-                                      lit_level::LIT, false, height_3d, z_drop );
+        result = draw_from_string_id( id, empty_string, C_MONSTER, monster_subcategory( id.obj() ), p,
+                                      corner, 0, lit_level::LIT, false, height_3d, z_drop );
     } else if( !invisible[0] ) {
         const Creature *pcritter = g->critter_at( p, true );
         if( pcritter == nullptr ) {
@@ -3177,11 +3607,6 @@ bool cata_tiles::draw_critter_at( const tripoint &p, lit_level ll, int &height_3
         attitude = Attitude::A_ANY;
         const monster *m = dynamic_cast<const monster *>( &critter );
         if( m != nullptr ) {
-            const auto ent_category = C_MONSTER;
-            std::string ent_subcategory = empty_string;
-            if( !m->type->species.empty() ) {
-                ent_subcategory = m->type->species.begin()->str();
-            }
             const int subtile = corner;
             // depending on the toggle flip sprite left or right
             int rot_facing = -1;
@@ -3191,23 +3616,19 @@ bool cata_tiles::draw_critter_at( const tripoint &p, lit_level ll, int &height_3
                 rot_facing = 4;
             }
             if( rot_facing >= 0 ) {
-                const auto ent_name = m->type->id;
-                std::string chosen_id = ent_name.str();
+                const mtype_id &ent_name = m->type->id;
+                const std::string *prefix = &empty_string;
                 if( m->has_effect( effect_ridden ) ) {
                     int pl_under_height = 6;
                     if( m->mounted_player ) {
                         draw_entity_with_overlays( *m->mounted_player, p, ll, pl_under_height );
                     }
-                    const std::string prefix = "rid_";
-                    std::string copy_id = chosen_id;
-                    const std::string ridden_id = copy_id.insert( 0, prefix );
-                    const tile_type *tt = tileset_ptr->find_tile_type( ridden_id );
-                    if( tt ) {
-                        chosen_id = ridden_id;
+                    if( tileset_ptr->find_tile_type( ridden_tile_prefix + ent_name.str() ) ) {
+                        prefix = &ridden_tile_prefix;
                     }
                 }
-                result = draw_from_id_string( chosen_id, ent_category, ent_subcategory, p, subtile, rot_facing,
-                                              ll, false, height_3d, z_drop );
+                result = draw_from_string_id( ent_name, *prefix, C_MONSTER, monster_subcategory( *m->type ),
+                                              p, subtile, rot_facing, ll, false, height_3d, z_drop );
                 sees_player = m->sees( g->u );
                 attitude = m->attitude_to( g-> u );
             }
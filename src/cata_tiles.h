@@ -1,8 +1,10 @@
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -11,6 +13,7 @@
 
 #include "animation.h"
 #include "enums.h"
+#include "hash_utils.h"
 #include "lightmap.h"
 #include "line.h"
 #include "map_memory.h"
@@ -104,6 +107,11 @@ class texture
         int set_alpha_mod( int mod ) const {
             return SDL_SetTextureAlphaMod( sdl_texture_ptr.get(), mod );
         }
+
+        /// The SDL texture the sprite is part of, shared by all sprites of one tileset image.
+        const SDL_Texture *sdl_texture() const {
+            return sdl_texture_ptr.get();
+        }
 };
 
 class tileset
@@ -344,12 +352,25 @@ class idle_animation_manager
 using color_block_overlay_container = std::pair<SDL_BlendMode, std::multimap<point, SDL_Color>>;
 
 struct tile_render_info;
+struct sprite_draw_list;
 
 struct tile_search_result {
     const tile_type *tt;
     std::string found_id;
 };
 
+/**
+ * What an id is drawn as: the result of @ref cata_tiles::tile_type_search with the
+ * multitile subtile already applied.
+ */
+struct resolved_tile {
+    /** Null if the tileset has nothing to draw for the id, not even a fallback. */
+    const tile_type *tt = nullptr;
+    std::string found_id;
+    /** Immovable furniture picks its sprite variation by position. */
+    bool seed_from_position = false;
+};
+
 class cata_tiles
 {
     public:
@@ -402,6 +423,31 @@ class cata_tiles
 
         bool find_overlay_looks_like( bool male, const std::string &overlay, std::string &draw_id );
 
+        /** Runs the tile search for @p id and follows multitile subtiles. */
+        resolved_tile resolve_tile( const std::string &id, TILE_CATEGORY category,
+                                    const std::string &subcategory, int subtile, int rota );
+
+        /**
+         * Like @ref resolve_tile, but the result is remembered for the id, so drawing the
+         * same terrain, furniture, trap or field again doesn't search again.
+         * @return nullptr if the subtile is out of range for the cache.
+         */
+        template<typename T>
+        const resolved_tile *find_resolved_tile( const int_id<T> &id, TILE_CATEGORY category,
+                int subtile );
+        /**
+         * Like the int id version, for items, monsters and vehicle parts, which only have
+         * string ids. Remembered by the id's interned string, so drawing them again neither
+         * builds nor hashes an id string.
+         * @param prefix Put in front of the id to get the tile id, such as "vp_".
+         * @param subcategory Returns the subcategory, only called if the tile isn't remembered yet.
+         */
+        template<typename T, typename Subcategory>
+        const resolved_tile &find_resolved_tile( const string_id<T> &id, const std::string &prefix,
+                TILE_CATEGORY category, int subtile, int rota, Subcategory &&subcategory );
+        /** Forgets everything remembered by @ref find_resolved_tile. */
+        void clear_resolved_tiles();
+
         /**
          * @brief draw_from_id_string() without category, subcategory and height_3d
          *
@@ -449,6 +495,25 @@ class cata_tiles
                                   const std::string &subcategory, const tripoint &pos, int subtile, int rota,
                                   lit_level ll, bool apply_night_vision_goggles, int &height_3d, int overlay_count,
                                   bool as_independent_entity = false );
+        /**
+         * @brief draw_from_id_string() for types with int ids, remembers where the tile was found.
+         */
+        template<typename T>
+        bool draw_from_int_id( const int_id<T> &id, TILE_CATEGORY category, const tripoint &pos,
+                               int subtile, int rota, lit_level ll, bool apply_night_vision_goggles,
+                               int &height_3d, int overlay_count );
+        /**
+         * @brief draw_from_id_string() for types with string ids only, remembers where the tile was found.
+         */
+        template<typename T, typename Subcategory>
+        bool draw_from_string_id( const string_id<T> &id, const std::string &prefix,
+                                  TILE_CATEGORY category, Subcategory &&subcategory, const tripoint &pos,
+                                  int subtile, int rota, lit_level ll, bool apply_night_vision_goggles,
+                                  int &height_3d, int overlay_count );
+        /** The part of draw_from_id_string() after the tile has been found. */
+        bool draw_resolved_tile( const resolved_tile &res, TILE_CATEGORY category, const tripoint &pos,
+                                 int rota, lit_level ll, bool apply_night_vision_goggles, int &height_3d,
+                                 int overlay_count, bool as_independent_entity );
         /**
         * @brief Draw overmap tile, if it's transparent, then draw lower tile first
         *
@@ -508,6 +573,30 @@ class cata_tiles
         bool draw_color_at( const SDL_Color &color, point p,
                             SDL_BlendMode blend_mode = SDL_BLENDMODE_NONE );
 
+        /**
+         * While queueing, sprites go into the draw list instead of straight to the renderer.
+         * Anything else drawn in the meantime must flush the list first.
+         */
+        void queue_sprite( const texture *tex, point cell, const SDL_Rect &destination, int rotation,
+                           SDL_RendererFlip flip, int alpha, const SDL_Color &color );
+        /**
+         * Renders the queued sprites. When no two cells' sprites can overlap, they are
+         * grouped by texture, keeping the order of the sprites within each cell.
+         */
+        void flush_draw_list();
+
+        /**
+         * Starts queueing the sprites of the map. With dirty region rendering they are kept
+         * until @ref finish_map_frame, which only redraws the squares that look different
+         * from the previous frame into a backbuffer and copies that to the screen.
+         */
+        void begin_map_frame( point dest, int width, int height );
+        void finish_map_frame();
+        /** Renders what was kept of this frame straight away and forgets the previous one. */
+        void discard_map_frame();
+        /** Makes the next frame redraw every square, e.g. because the tile size changed. */
+        void invalidate_map_frame();
+
         /** Tile Picking */
         void get_tile_values( int t, const int *tn, int &subtile, int &rotation );
 
@@ -804,6 +893,23 @@ class cata_tiles
         // int represents spawn count
         std::map<tripoint, std::tuple<mtype_id, int, bool, Attitude>> monster_override;
         pimpl<std::vector<tile_render_info>> draw_points_cache;
+        pimpl<sprite_draw_list> draw_list;
+        bool queueing_sprites = false;
+        bool dirty_region_rendering = false;
+
+        struct resolved_tile_variants {
+            /** Interned id string the results are for, int ids change when data is reloaded. */
+            const std::string *id = nullptr;
+            /** By subtile + 1, -1 being no subtile. */
+            std::array<std::optional<resolved_tile>, 9> by_subtile;
+        };
+        /** Results of find_resolved_tile, by category and int id. */
+        std::array<std::vector<resolved_tile_variants>, C_OVERMAP_NOTE + 1> resolved_tiles;
+        /** Interned id string, prefix, category, subtile and rotation of a string id tile. */
+        using string_tile_key = std::tuple<const std::string *, const std::string *, int, int, int>;
+        /** Results of find_resolved_tile for string ids. */
+        std::unordered_map<string_tile_key, resolved_tile, cata::tuple_hash> resolved_string_tiles;
+        season_type resolved_tiles_season = season_type::NUM_SEASONS;
 
     private:
         /**
@@ -1,11 +1,18 @@
 #include "compress.h"
 
 #include <zlib.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 #include <string>
 #include <stdexcept>
 #include <cstddef>
 
+#include "string_formatter.h"
+
 void zlib_compress( const std::string &input, std::vector<std::byte> &output )
 {
     uLongf compressedSize = compressBound( input.size() );
@@ -50,4 +57,226 @@ void zlib_decompress( const void *compressed_data, int compressed_size, std::str
     } while( result == Z_BUF_ERROR );
 
     output.resize( decompressedSize );
-}
\ No newline at end of file
+}
+
+namespace
+{
+
+class zlib_codec : public compression_codec
+{
+    public:
+        const std::string &name() const override {
+            return compression::zlib_codec_name;
+        }
+
+        void compress( const std::string &input, std::vector<std::byte> &output ) const override {
+            zlib_compress( input, output );
+        }
+
+        void decompress( const void *compressed_data, int compressed_size,
+                         std::string &output ) const override {
+            zlib_decompress( compressed_data, compressed_size, output );
+        }
+};
+
+/**
+ * zlib with a preset dictionary. Map quads are small and very repetitive between
+ * each other, but not within a single blob, so priming the window helps a lot.
+ */
+class zlib_dict_codec : public compression_codec
+{
+    public:
+        explicit zlib_dict_codec( const std::string &dictionary ) :
+            codec_name( compression::dictionary_codec_name( dictionary ) ),
+            dictionary( dictionary ) {}
+
+        const std::string &name() const override {
+            return codec_name;
+        }
+
+        void compress( const std::string &input, std::vector<std::byte> &output ) const override {
+            z_stream strm = {};
+            if( deflateInit( &strm, Z_BEST_SPEED ) != Z_OK ) {
+                throw std::runtime_error( "Zlib compression error" );
+            }
+            if( deflateSetDictionary( &strm, reinterpret_cast<const Bytef *>( dictionary.data() ),
+                                      dictionary.size() ) != Z_OK ) {
+                deflateEnd( &strm );
+                throw std::runtime_error( "Zlib compression error" );
+            }
+            output.resize( deflateBound( &strm, input.size() ) );
+            // zlib's API isn't const-correct
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+            strm.next_in = const_cast<Bytef *>( reinterpret_cast<const Bytef *>( input.data() ) );
+            strm.avail_in = input.size();
+            strm.next_out = reinterpret_cast<Bytef *>( output.data() );
+            strm.avail_out = output.size();
+            const int result = deflate( &strm, Z_FINISH );
+            const size_t written = strm.total_out;
+            deflateEnd( &strm );
+            if( result != Z_STREAM_END ) {
+                throw std::runtime_error( "Zlib compression error" );
+            }
+            output.resize( written );
+        }
+
+        void decompress( const void *compressed_data, int compressed_size,
+                         std::string &output ) const override {
+            z_stream strm = {};
+            if( inflateInit( &strm ) != Z_OK ) {
+                throw std::runtime_error( "Zlib decompression failed" );
+            }
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+            strm.next_in = const_cast<Bytef *>( static_cast<const Bytef *>( compressed_data ) );
+            strm.avail_in = compressed_size;
+            output.resize( static_cast<size_t>( compressed_size ) * 8 );
+
+            int result;
+            do {
+                if( strm.total_out == output.size() ) {
+                    output.resize( output.size() * 2 );
+                }
+                strm.next_out = reinterpret_cast<Bytef *>( &output[strm.total_out] );
+                strm.avail_out = output.size() - strm.total_out;
+                result = inflate( &strm, Z_NO_FLUSH );
+                if( result == Z_NEED_DICT ) {
+                    result = inflateSetDictionary( &strm,
+                                                   reinterpret_cast<const Bytef *>( dictionary.data() ),
+                                                   dictionary.size() );
+                }
+            } while( result == Z_OK );
+
+            const size_t written = strm.total_out;
+            inflateEnd( &strm );
+            if( result != Z_STREAM_END ) {
+                throw std::runtime_error( "Zlib decompression failed" );
+            }
+            output.resize( written );
+        }
+
+    private:
+        std::string codec_name;
+        std::string dictionary;
+};
+
+struct codec_registry {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::unique_ptr<compression_codec>> codecs;
+
+    codec_registry() {
+        auto zlib = std::make_unique<zlib_codec>();
+        codecs.emplace( zlib->name(), std::move( zlib ) );
+    }
+};
+
+// Accessed from the background save thread as well
+codec_registry &get_codec_registry()
+{
+    static codec_registry registry;
+    return registry;
+}
+
+const std::string dictionary_prefix = "zlib_dict:";
+
+// FNV-1a, since the result is persisted and std::hash isn't stable
+uint64_t stable_hash( const std::string &data )
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for( const char c : data ) {
+        hash ^= static_cast<unsigned char>( c );
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+} // namespace
+
+namespace compression
+{
+
+const std::string zlib_codec_name = "zlib";
+
+const compression_codec *find_codec( const std::string &name )
+{
+    codec_registry &registry = get_codec_registry();
+    std::lock_guard<std::mutex> lk( registry.mutex );
+    const auto iter = registry.codecs.find( name );
+    return iter == registry.codecs.end() ? nullptr : iter->second.get();
+}
+
+const compression_codec &default_codec()
+{
+    return *find_codec( zlib_codec_name );
+}
+
+bool is_dictionary_codec( const std::string &name )
+{
+    return name.starts_with( dictionary_prefix );
+}
+
+std::string dictionary_codec_name( const std::string &dictionary )
+{
+    return dictionary_prefix + string_format( "%016llx",
+            static_cast<unsigned long long>( stable_hash( dictionary ) ) );
+}
+
+const compression_codec &register_dictionary( const std::string &dictionary )
+{
+    auto codec = std::make_unique<zlib_dict_codec>( dictionary );
+    codec_registry &registry = get_codec_registry();
+    std::lock_guard<std::mutex> lk( registry.mutex );
+    const auto iter = registry.codecs.emplace( codec->name(), std::move( codec ) ).first;
+    return *iter->second;
+}
+
+std::string train_dictionary( const std::vector<std::string> &samples, size_t max_size )
+{
+    // Count string tokens with their quotes and the following separator, since that's
+    // how they appear in the stream: "t_grass",
+    std::unordered_map<std::string, int> counts;
+    for( const std::string &sample : samples ) {
+        size_t pos = 0;
+        while( ( pos = sample.find( '"', pos ) ) != std::string::npos ) {
+            const size_t end = sample.find( '"', pos + 1 );
+            if( end == std::string::npos ) {
+                break;
+            }
+            const size_t len = std::min( end + 2, sample.size() ) - pos;
+            if( len <= 64 ) {
+                counts[sample.substr( pos, len )]++;
+            }
+            pos = end + 1;
+        }
+    }
+
+    std::vector<std::pair<int64_t, const std::string *>> scored;
+    for( const auto &entry : counts ) {
+        // Anything seen once is unlikely to show up in other blobs
+        if( entry.second > 1 ) {
+            scored.emplace_back( static_cast<int64_t>( entry.second ) * entry.first.size(), &entry.first );
+        }
+    }
+    std::sort( scored.begin(), scored.end(), []( const auto & lhs, const auto & rhs ) {
+        return lhs.first != rhs.first ? lhs.first > rhs.first : *lhs.second < *rhs.second;
+    } );
+
+    // Pick the best tokens first, then lay them out so the best end up last.
+    std::vector<const std::string *> picked;
+    size_t total = 0;
+    for( const auto &entry : scored ) {
+        if( total + entry.second->size() > max_size ) {
+            continue;
+        }
+        total += entry.second->size();
+        picked.push_back( entry.second );
+    }
+
+    std::string dictionary;
+    dictionary.reserve( total );
+    for( auto it = picked.rbegin(); it != picked.rend(); ++it ) {
+        dictionary += **it;
+    }
+    return dictionary;
+}
+
+} // namespace compression
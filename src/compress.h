@@ -1,10 +1,69 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "fstream_utils.h"
 
 void zlib_compress( const std::string &input, std::vector<std::byte> &output );
 void zlib_decompress( const void *compressed_data, int compressed_size, std::string &output );
 
+/**
+ * A compression method for blobs stored in the V2 save format.
+ *
+ * The codec name is stored alongside every blob, so each row is decompressed
+ * with whatever codec wrote it, regardless of what new writes use.
+ */
+class compression_codec
+{
+    public:
+        virtual ~compression_codec() = default;
 
+        virtual const std::string &name() const = 0;
+        virtual void compress( const std::string &input, std::vector<std::byte> &output ) const = 0;
+        virtual void decompress( const void *compressed_data, int compressed_size,
+                                 std::string &output ) const = 0;
+};
+
+namespace compression
+{
+
+/** Name of the plain zlib codec, used when nothing better is available. */
+extern const std::string zlib_codec_name;
+
+/**
+ * Find a registered codec by the name stored with a blob.
+ * @returns nullptr if no such codec has been registered.
+ */
+const compression_codec *find_codec( const std::string &name );
+
+/** The plain zlib codec. Always registered. */
+const compression_codec &default_codec();
+
+/**
+ * Whether @p name refers to a dictionary codec. Those are registered lazily,
+ * after their dictionary was loaded from wherever it was stored.
+ */
+bool is_dictionary_codec( const std::string &name );
+
+/** The codec name a dictionary would be registered under. Stable across platforms. */
+std::string dictionary_codec_name( const std::string &dictionary );
+
+/**
+ * Register a zlib codec primed with a preset dictionary, or return the
+ * existing one if this dictionary was already registered.
+ */
+const compression_codec &register_dictionary( const std::string &dictionary );
+
+/**
+ * Build a preset dictionary from sample blobs.
+ *
+ * Collects JSON string tokens that repeat across the samples, and packs the most
+ * valuable ones (frequency times length) at the end of the dictionary, where
+ * zlib can reference them with the shortest distances.
+ *
+ * @param max_size Upper bound on dictionary size. zlib only uses the last 32 KiB.
+ */
+std::string train_dictionary( const std::vector<std::string> &samples, size_t max_size );
+
+} // namespace compression
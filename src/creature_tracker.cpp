@@ -7,6 +7,8 @@
 #include <utility>
 
 #include "debug.h"
+#include "game_constants.h"
+#include "line.h"
 #include "mongroup.h"
 #include "monster.h"
 #include "mtype.h"
@@ -32,6 +34,90 @@ shared_ptr_fast<monster> Creature_tracker::find( const tripoint &pos ) const
     return nullptr;
 }
 
+std::vector<shared_ptr_fast<monster>> Creature_tracker::find_in_area(
+                                       const inclusive_cuboid<tripoint> &area ) const
+{
+    std::vector<shared_ptr_fast<monster>> ret;
+    const auto add_from = [&]( const std::vector<tripoint> &locations ) {
+        for( const tripoint &pos : locations ) {
+            if( !area.contains( pos ) ) {
+                continue;
+            }
+            if( shared_ptr_fast<monster> critter = find( pos ) ) {
+                ret.push_back( std::move( critter ) );
+            }
+        }
+    };
+
+    const inclusive_cuboid<tripoint> submaps( divide_xy_round_to_minus_infinity( area.p_min, SEEX ),
+            divide_xy_round_to_minus_infinity( area.p_max, SEEX ) );
+    const tripoint extent = submaps.p_max - submaps.p_min + tripoint( 1, 1, 1 );
+    if( extent.x <= 0 || extent.y <= 0 || extent.z <= 0 ) {
+        return ret;
+    }
+    // Loud sounds and long sight lines cover far more submaps than there are occupied
+    // ones, so look at whichever of the two is smaller.
+    const int64_t num_submaps = static_cast<int64_t>( extent.x ) * extent.y * extent.z;
+    if( num_submaps > static_cast<int64_t>( locations_by_submap.size() ) ) {
+        for( const auto &bucket : locations_by_submap ) {
+            if( submaps.contains( bucket.first ) ) {
+                add_from( bucket.second );
+            }
+        }
+        return ret;
+    }
+    for( int z = submaps.p_min.z; z <= submaps.p_max.z; z++ ) {
+        for( int y = submaps.p_min.y; y <= submaps.p_max.y; y++ ) {
+            for( int x = submaps.p_min.x; x <= submaps.p_max.x; x++ ) {
+                const auto iter = locations_by_submap.find( tripoint( x, y, z ) );
+                if( iter != locations_by_submap.end() ) {
+                    add_from( iter->second );
+                }
+            }
+        }
+    }
+    return ret;
+}
+
+std::vector<shared_ptr_fast<monster>> Creature_tracker::find_in_radius( const tripoint &center,
+                                   const int radius ) const
+{
+    const tripoint offset( radius, radius, radius );
+    std::vector<shared_ptr_fast<monster>> ret = find_in_area( inclusive_cuboid<tripoint>( center - offset,
+            center + offset ) );
+    std::erase_if( ret, [&]( const shared_ptr_fast<monster> &critter ) {
+        return rl_dist( center, critter->pos() ) > radius;
+    } );
+    return ret;
+}
+
+void Creature_tracker::set_location( const tripoint &pos, const shared_ptr_fast<monster> &critter )
+{
+    if( monsters_by_location.insert_or_assign( pos, critter ).second ) {
+        locations_by_submap[divide_xy_round_to_minus_infinity( pos, SEEX )].push_back( pos );
+    }
+}
+
+void Creature_tracker::erase_location( const tripoint &pos )
+{
+    if( monsters_by_location.erase( pos ) == 0 ) {
+        return;
+    }
+    const auto bucket = locations_by_submap.find( divide_xy_round_to_minus_infinity( pos, SEEX ) );
+    if( bucket == locations_by_submap.end() ) {
+        return;
+    }
+    std::vector<tripoint> &locations = bucket->second;
+    const auto iter = std::ranges::find( locations, pos );
+    if( iter != locations.end() ) {
+        *iter = locations.back();
+        locations.pop_back();
+    }
+    if( locations.empty() ) {
+        locations_by_submap.erase( bucket );
+    }
+}
+
 int Creature_tracker::temporary_id( const monster &critter ) const
 {
     const auto iter = std::ranges::find_if( monsters_list,
@@ -86,7 +172,7 @@ bool Creature_tracker::add( const shared_ptr_fast<monster> &critter_ptr )
     }
 
     monsters_list.emplace_back( critter_ptr );
-    monsters_by_location[critter.pos()] = critter_ptr;
+    set_location( critter.pos(), critter_ptr );
     add_to_faction_map( critter_ptr );
     return true;
 }
@@ -164,8 +250,8 @@ bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_p
         return ptr.get() == &critter;
     } );
     if( iter != monsters_list.end() ) {
-        monsters_by_location.erase( critter.pos() );
-        monsters_by_location[new_pos] = *iter;
+        erase_location( critter.pos() );
+        set_location( new_pos, *iter );
         return true;
     } else {
         const tripoint &old_pos = critter.pos();
@@ -184,7 +270,7 @@ void Creature_tracker::remove_from_location_map( const monster &critter )
 {
     const auto pos_iter = monsters_by_location.find( critter.pos() );
     if( pos_iter != monsters_by_location.end() && pos_iter->second.get() == &critter ) {
-        monsters_by_location.erase( pos_iter );
+        erase_location( critter.pos() );
         return;
     }
 
@@ -195,7 +281,7 @@ void Creature_tracker::remove_from_location_map( const monster &critter )
         return v.second.get() == &critter;
     } );
     if( iter != monsters_by_location.end() ) {
-        monsters_by_location.erase( iter );
+        erase_location( tripoint( iter->first ) );
     }
 }
 
@@ -227,17 +313,23 @@ void Creature_tracker::remove( const monster &critter )
 void Creature_tracker::clear()
 {
     monsters_list.clear();
-    monsters_by_location.clear();
+    clear_location_maps();
     monster_faction_map_.clear();
     removed_.clear();
 }
 
-void Creature_tracker::rebuild_cache()
+void Creature_tracker::clear_location_maps()
 {
     monsters_by_location.clear();
+    locations_by_submap.clear();
+}
+
+void Creature_tracker::rebuild_cache()
+{
+    clear_location_maps();
     monster_faction_map_.clear();
     for( const shared_ptr_fast<monster> &mon_ptr : monsters_list ) {
-        monsters_by_location[mon_ptr->pos()] = mon_ptr;
+        set_location( mon_ptr->pos(), mon_ptr );
         add_to_faction_map( mon_ptr );
     }
 }
@@ -256,13 +348,17 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
     shared_ptr_fast<monster> first_ptr;
     if( first_iter != monsters_by_location.end() ) {
         first_ptr = first_iter->second;
-        monsters_by_location.erase( first_iter );
     }
 
     shared_ptr_fast<monster> second_ptr;
     if( second_iter != monsters_by_location.end() ) {
         second_ptr = second_iter->second;
-        monsters_by_location.erase( second_iter );
+    }
+    if( first_ptr ) {
+        erase_location( first.pos() );
+    }
+    if( second_ptr ) {
+        erase_location( second.pos() );
     }
     // implied: (first_ptr != second_ptr) or (first_ptr == nullptr && second_ptr == nullptr)
 
@@ -272,10 +368,10 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
 
     // If the pointers have been taken out of the list, put them back in.
     if( first_ptr ) {
-        monsters_by_location[first.pos()] = first_ptr;
+        set_location( first.pos(), first_ptr );
     }
     if( second_ptr ) {
-        monsters_by_location[second.pos()] = second_ptr;
+        set_location( second.pos(), second_ptr );
     }
 }
 
@@ -6,6 +6,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "cuboid_rectangle.h"
 #include "memory_fast.h"
 #include "point.h"
 #include "type_id.h"
@@ -47,6 +48,18 @@ class Creature_tracker
          * Dead monsters are ignored and not returned.
          */
         shared_ptr_fast<monster> find( const tripoint &pos ) const;
+        /**
+         * Returns the living monsters inside @p area, in no particular order.
+         * Only the submaps the area overlaps are looked at, so the cost doesn't grow
+         * with the number of monsters elsewhere in the reality bubble.
+         */
+        std::vector<shared_ptr_fast<monster>> find_in_area( const inclusive_cuboid<tripoint> &area )
+                                           const;
+        /**
+         * Returns the living monsters within @p radius (as @ref rl_dist) of @p center,
+         * in no particular order.
+         */
+        std::vector<shared_ptr_fast<monster>> find_in_radius( const tripoint &center, int radius ) const;
         /**
          * Returns a temporary id of the given monster (which must exist in the tracker).
          * The id is valid until monsters are added or removed from the tracker.
@@ -94,8 +107,18 @@ class Creature_tracker
     private:
         std::vector<shared_ptr_fast<monster>> monsters_list;
         std::unordered_map<tripoint, shared_ptr_fast<monster>> monsters_by_location;
+        /**
+         * Keys of @ref monsters_by_location, bucketed by the submap they are on,
+         * for @ref find_in_area. Empty buckets are removed.
+         */
+        std::unordered_map<tripoint, std::vector<tripoint>> locations_by_submap;
         /** Remove the monsters entry in @ref monsters_by_location */
         void remove_from_location_map( const monster &critter );
+        /** Set or erase an entry of @ref monsters_by_location, keeping @ref locations_by_submap in sync. */
+        void set_location( const tripoint &pos, const shared_ptr_fast<monster> &critter );
+        void erase_location( const tripoint &pos );
+        /** Empty @ref monsters_by_location and @ref locations_by_submap together. */
+        void clear_location_maps();
 };
 
 
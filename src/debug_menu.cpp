@@ -77,6 +77,8 @@
 #include "overmap.h"
 #include "overmap_ui.h"
 #include "overmapbuffer.h"
+#include "path_info.h"
+#include "perf_telemetry.h"
 #include "pimpl.h"
 #include "player.h"
 #include "pldata.h"
@@ -191,6 +193,7 @@ enum debug_menu_index {
     DEBUG_NESTED_MAPGEN,
     DEBUG_RESET_IGNORED_MESSAGES,
     DEBUG_RELOAD_TILES,
+    DEBUG_DUMP_TURN_TIMINGS,
 };
 
 class mission_debug
@@ -238,6 +241,7 @@ static int info_uilist( bool display_all_entries = true )
             { uilist_entry( DEBUG_SHOW_MUT_CHANCES, true, 'u', _( "Show mutation trait chances" ) ) },
             { uilist_entry( DEBUG_BENCHMARK, true, 'b', _( "Draw benchmark" ) ) },
             { uilist_entry( DEBUG_BENCHMARK_FPS, true, 'B', _( "FPS benchmark" ) ) },
+            { uilist_entry( DEBUG_DUMP_TURN_TIMINGS, true, 'P', _( "Dump turn timings" ) ) },
             { uilist_entry( DEBUG_HOUR_TIMER, true, 'E', _( "Toggle hour timer" ) ) },
             { uilist_entry( DEBUG_TRAIT_GROUP, true, 't', _( "Test trait group" ) ) },
             { uilist_entry( DEBUG_SHOW_MSG, true, 'd', _( "Show debug message" ) ) },
@@ -1986,6 +1990,14 @@ void debug()
         }
         break;
 
+        case DEBUG_DUMP_TURN_TIMINGS: {
+            const std::string base = PATH_INFO::user_dir() + "turn_timings";
+            if( telemetry::dump_csv( base + ".csv" ) && telemetry::dump_json( base + ".json" ) ) {
+                popup( _( "Turn timings written to %s.csv and %s.json" ), base, base );
+            }
+        }
+        break;
+
         case DEBUG_OM_TELEPORT:
             debug_menu::teleport_overmap();
             break;
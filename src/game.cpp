@@ -12,6 +12,7 @@
 #include <ctime>
 #include <cwctype>
 #include <exception>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <iterator>
@@ -136,6 +137,7 @@
 #include "panels.h"
 #include "path_info.h"
 #include "pathfinding.h"
+#include "perf_telemetry.h"
 #include "pickup.h"
 #include "player.h"
 #include "player_activity.h"
@@ -159,6 +161,7 @@
 #include "string_id.h"
 #include "string_input_popup.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "tileray.h"
 #include "timed_event.h"
 #include "translations.h"
@@ -1605,8 +1608,10 @@ bool game::do_turn()
     // reset player noise
     u.volume = 0;
 
-    // Finally, clear pathfinding cache
-    Pathfinding::clear_d_maps();
+    // Finally, age out and repair pathfinding cache
+    Pathfinding::end_turn();
+
+    telemetry::end_turn( to_turn<int>( calendar::turn ) );
 
     return false;
 }
@@ -2752,6 +2757,7 @@ bool game::save_uistate_data() const
 
 bool game::save( bool quitting )
 {
+    telemetry::scoped_timer timer( telemetry::phase::save );
     world *world = get_active_world();
     if( !world ) {
         return false;
@@ -3121,6 +3127,7 @@ void game::draw( ui_adaptor &ui )
     if( test_mode ) {
         return;
     }
+    telemetry::scoped_timer timer( telemetry::phase::draw );
 
     //temporary fix for updating visibility for minimap
     ter_view_p.z = ( u.pos() + u.view_offset ).z;
@@ -4104,11 +4111,66 @@ void game::cleanup_dead()
     critter_died = false;
 }
 
+void game::precompute_monster_sight()
+{
+    ZoneScoped;
+
+    // Line of sight checks monster planning is about to make, each pair once
+    std::vector<std::pair<tripoint, tripoint>> checks;
+    std::vector<const Creature *> targets;
+    for( monster &critter : all_monsters() ) {
+        // Moves are only handed out once the monster's turn starts, so don't filter on them
+        if( critter.is_dead() || critter.has_effect( effect_ai_controlled ) ||
+            critter.has_effect( effect_ridden ) ) {
+            continue;
+        }
+        targets.clear();
+        critter.get_sight_targets( targets );
+        for( const Creature *target : targets ) {
+            const tripoint &from = critter.pos();
+            const tripoint &to = target->pos();
+            if( !m.has_cached_sees( from, to ) ) {
+                checks.emplace_back( std::min( from, to ), std::max( from, to ) );
+            }
+        }
+    }
+    std::ranges::sort( checks );
+    checks.erase( std::unique( checks.begin(), checks.end() ), checks.end() );
+
+    // Workers only read the map. Results are cached here in a fixed order,
+    // so the outcome doesn't depend on how the work was scheduled.
+    constexpr size_t chunk_size = 64;
+    std::vector<std::future<std::vector<char>>> results;
+    for( size_t begin = 0; begin < checks.size(); begin += chunk_size ) {
+        const size_t end = std::min( begin + chunk_size, checks.size() );
+        results.push_back( cata::get_thread_pool().submit( [this, &checks, begin, end]() {
+            std::vector<char> visible;
+            visible.reserve( end - begin );
+            for( size_t i = begin; i < end; i++ ) {
+                visible.push_back( m.sees_uncached( checks[i].first, checks[i].second ) );
+            }
+            return visible;
+        } ) );
+    }
+    for( size_t chunk = 0; chunk < results.size(); chunk++ ) {
+        const std::vector<char> visible = results[chunk].get();
+        for( size_t i = 0; i < visible.size(); i++ ) {
+            const auto &check = checks[chunk * chunk_size + i];
+            m.cache_sees( check.first, check.second, visible[i] != 0 );
+        }
+    }
+}
+
 void game::monmove()
 {
     ZoneScoped;
+    telemetry::scoped_timer timer( telemetry::phase::monmove );
     cleanup_dead();
 
+    if( get_option<bool>( "PARALLEL_MONSTER_PLANNING" ) ) {
+        precompute_monster_sight();
+    }
+
     for( monster &critter : all_monsters() ) {
         // Critters in impassable tiles get pushed away, unless it's not impassable for them
         if( !critter.is_dead() && m.impassable( critter.pos() ) && !critter.can_move_to( critter.pos() ) ) {
@@ -4188,6 +4250,7 @@ void game::monmove()
     }
 
     // Now, do active NPCs.
+    const npc_ai::world_snapshot_scope npc_snapshot( npc_ai::world_snapshot::take() );
     for( npc &guy : g->all_npcs() ) {
         int turns = 0;
         if( guy.is_mounted() ) {
@@ -10828,6 +10891,7 @@ point game::update_map( int &x, int &y )
         // We need this call because even if the map hasn't shifted we may have changed z-level and can now see farther
         // TODO: only make this call if we changed z-level
         update_overmap_seen();
+        prefetch_map_ahead();
         // Not actually shifting the submaps, all the stuff below would do nothing
         return point_zero;
     }
@@ -10891,10 +10955,60 @@ point game::update_map( int &x, int &y )
 
     // Update what parts of the world map we can see
     update_overmap_seen();
+    prefetch_map_ahead();
 
     return shift;
 }
 
+void game::prefetch_map_ahead()
+{
+    const tripoint pos = u.global_square_location();
+    rl_vec2d heading( pos.xy() - last_prefetch_pos.xy() );
+    float tiles_per_turn = heading.magnitude();
+    const bool same_level = pos.z == last_prefetch_pos.z;
+    last_prefetch_pos = pos;
+    if( !get_option<bool>( "PREFETCH_MAPS" ) || !same_level ) {
+        return;
+    }
+
+    // A vehicle's velocity is a better guess than the last step, which may have been a skid.
+    if( const optional_vpart_position vp = m.veh_at( u.pos() ) ) {
+        const vehicle &veh = vp->vehicle();
+        if( veh.velocity != 0 ) {
+            const units::angle dir = veh.velocity > 0 ? veh.move.dir() : veh.move.dir() + 180_degrees;
+            heading = rl_vec2d( units::cos( dir ), units::sin( dir ) );
+            tiles_per_turn = std::abs( veh.velocity ) / vehicles::vmiph_per_tile;
+        }
+    }
+
+    // Teleports and map jumps aren't movement worth predicting.
+    if( heading.is_null() || tiles_per_turn > MAPSIZE_X ) {
+        return;
+    }
+    pregenerate_map( MAPBUFFER.prefetch_ahead( m.get_abs_sub(), heading.normalized(),
+                     tiles_per_turn, m.has_zlevels() ) );
+}
+
+void game::pregenerate_map( const std::vector<tripoint> &omts )
+{
+    // Mapgen can't run off the main thread (see map::generate_omt), so instead of having
+    // map shifts generate a whole row at once, spread it over the turns before: at least
+    // one overmap terrain per turn, more while it's quick.
+    static constexpr std::chrono::milliseconds budget( 4 );
+    const auto start = std::chrono::steady_clock::now();
+    for( const tripoint &omt : omts ) {
+        // TODO: fix point types
+        if( MAPBUFFER.is_submap_loaded( omt_to_sm_copy( omt ) ) ||
+            !get_active_world()->is_map_quad_missing( omt ) ) {
+            continue;
+        }
+        map::generate_omt( tripoint_abs_omt( omt ) );
+        if( std::chrono::steady_clock::now() - start > budget ) {
+            break;
+        }
+    }
+}
+
 void game::update_overmap_seen()
 {
     const tripoint_abs_omt ompos = u.global_omt_location();
@@ -518,6 +518,10 @@ class game
         point update_map( player &p );
         point update_map( int &x, int &y );
         void update_overmap_seen(); // Update which overmap tiles we can see
+        // Read saved map data ahead of the player's movement, see mapbuffer::prefetch_ahead
+        void prefetch_map_ahead();
+        // Generate those of @p omts that were never generated, within a time budget
+        void pregenerate_map( const std::vector<tripoint> &omts );
 
         void process_artifact( item &it, player &p );
         void add_artifact_messages( const std::vector<art_effect_passive> &effects );
@@ -798,6 +802,8 @@ class game
                        int hor_padding = 0 ); // Prints a list of nearby monsters
         void mon_info_update( );    //Update seen monsters information
         void cleanup_dead();     // Delete any dead NPCs/monsters
+        // Works out the line of sight monster planning needs on worker threads, ahead of the serial monster moves
+        void precompute_monster_sight();
         bool is_dangerous_tile( const tripoint &dest_loc ) const;
         std::vector<std::string> get_dangerous_tile( const tripoint &dest_loc ) const;
         bool prompt_dangerous_tile( const tripoint &dest_loc ) const;
@@ -1039,6 +1045,9 @@ class game
         /** How far the tileset should be zoomed out, 16 is default. 32 is zoomed in by x2, 8 is zoomed out by x0.5 */
         int tileset_zoom = 0;
 
+        /** Player position at the last prefetch_map_ahead, to tell the direction of travel. */
+        tripoint last_prefetch_pos;
+
         /** Seed for all the random numbers that should have consistent randomness (weather). */
         unsigned int seed = 0;
 
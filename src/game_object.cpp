@@ -171,6 +171,14 @@ tripoint game_object<T>::position( ) const
     return loc->position( static_cast<const T *>( this ) );
 };
 
+template<typename T>
+void game_object<T>::notify_location() const
+{
+    if( loc ) {
+        loc->on_items_changed();
+    }
+}
+
 
 template
 class game_object<item>;
@@ -57,6 +57,8 @@ class game_object
         bool has_position() const;
 
         tripoint position( ) const;
+        /** Tells the location holding this object that the object changed in place. */
+        void notify_location() const;
         /** Returns the name that will be used when referring to the object in error messages */
         virtual std::string debug_name() const = 0;
 };
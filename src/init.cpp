@@ -1,9 +1,15 @@
 #include "init.h"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <exception>
+#include <filesystem>
 #include <fstream>
+#include <future>
 #include <iterator>
 #include <memory>
 #include <sstream> // for throwing errors
@@ -21,6 +27,7 @@
 #include "behavior.h"
 #include "bionics.h"
 #include "bodypart.h"
+#include "cached_options.h"
 #include "catalua.h"
 #include "cata_utility.h"
 #include "clothing_mod.h"
@@ -46,7 +53,9 @@
 #include "flag.h"
 #include "flag_trait.h"
 #include "gates.h"
+#include "get_version.h"
 #include "harvest.h"
+#include "hash_utils.h"
 #include "item_action.h"
 #include "item_category.h"
 #include "item_factory.h"
@@ -61,6 +70,7 @@
 #include "mapbuffer.h"
 #include "mapdata.h"
 #include "mapgen.h"
+#include "memory_stream.h"
 #include "martialarts.h"
 #include "material.h"
 #include "mission.h"
@@ -80,6 +90,7 @@
 #include "overmap_connection.h"
 #include "overmap_location.h"
 #include "overmap_special.h"
+#include "path_info.h"
 #include "profession.h"
 #include "recipe_dictionary.h"
 #include "recipe_groups.h"
@@ -96,6 +107,7 @@
 #include "start_location.h"
 #include "string_formatter.h"
 #include "text_snippets.h"
+#include "thread_pool.h"
 #include "translations.h"
 #include "trap.h"
 #include "type_id.h"
@@ -136,24 +148,35 @@ void DynamicDataLoader::load_object( const JsonObject &jo, const std::string &sr
 }
 
 struct DynamicDataLoader::cached_streams {
-    lru_cache<std::string, shared_ptr_fast<std::istringstream>> cache;
+    lru_cache<std::string, shared_ptr_fast<const std::string>> cache;
 };
 
+namespace
+{
+
+/** A stream over cached file contents, keeping them alive. */
+struct cached_file_stream {
+    shared_ptr_fast<const std::string> data;
+    memory_istream stream;
+
+    explicit cached_file_stream( const shared_ptr_fast<const std::string> &contents )
+        : data( contents ), stream( *contents ) {}
+};
+
+} // namespace
+
 shared_ptr_fast<std::istream> DynamicDataLoader::get_cached_stream( const std::string &path )
 {
     assert( !finalized && "Cannot open data file after finalization." );
     assert( stream_cache && "Stream cache is only available during finalization" );
-    shared_ptr_fast<std::istringstream> cached = stream_cache->cache.get( path, nullptr );
-    // Create a new stream if the file is not opened yet, or if some code is still
-    // using the previous stream (in such case, `cached` and `stream_cache` have
-    // two references to the stream, hence the test for > 2).
+    shared_ptr_fast<const std::string> cached = stream_cache->cache.get( path, nullptr );
     if( !cached ) {
-        cached = make_shared_fast<std::istringstream>( read_entire_file( path ) );
-    } else if( cached.use_count() > 2 ) {
-        cached = make_shared_fast<std::istringstream>( cached->str() );
+        cached = make_shared_fast<const std::string>( read_entire_file( path ) );
     }
     stream_cache->cache.insert( 8, path, cached );
-    return cached;
+    // Streams over memory are cheap, so every caller gets its own.
+    shared_ptr_fast<cached_file_stream> file = make_shared_fast<cached_file_stream>( cached );
+    return shared_ptr_fast<std::istream>( file, &file->stream );
 }
 
 void DynamicDataLoader::load_deferred( deferred_json &data )
@@ -466,8 +489,70 @@ void DynamicDataLoader::initialize()
 #endif
 }
 
+namespace
+{
+
+/**
+ * A data file read into memory, with the members of its top level objects indexed
+ * (which is most of the parsing work, see @ref JsonObject::JsonObject).
+ */
+struct parsed_json_file {
+    std::uintmax_t size = 0;
+    int64_t modified = 0;
+    std::unique_ptr<const std::string> data;
+    std::unique_ptr<memory_istream> stream;
+    std::unique_ptr<JsonIn> jsin;
+    // A deque, as the objects report their unvisited members when destroyed.
+    std::deque<JsonObject> objects;
+};
+
+/** Runs on a worker thread, must not touch anything outside the file. */
+parsed_json_file parse_json_file( const std::string &file )
+{
+    parsed_json_file ret;
+    std::error_code ec;
+    ret.size = std::filesystem::file_size( file, ec );
+    ret.modified = std::filesystem::last_write_time( file, ec ).time_since_epoch().count();
+    // open the file as a stream
+    cata_ifstream infile = std::move( cata_ifstream().mode( cata_ios_mode::binary ).open( file ) );
+    // and stuff it into ram
+    ret.data = std::make_unique<const std::string>(
+                   ( std::istreambuf_iterator<char>( *infile ) ),
+                   std::istreambuf_iterator<char>()
+               );
+    ret.stream = std::make_unique<memory_istream>( *ret.data );
+    ret.jsin = std::make_unique<JsonIn>( *ret.stream, file );
+    JsonIn &jsin = *ret.jsin;
+    // TEMPORARY until 0.G: Remove single object support for consistency
+    if( jsin.test_object() ) {
+        ret.objects.emplace_back( jsin );
+        // if there's anything else in the file, it's an error.
+        jsin.eat_whitespace();
+        if( jsin.good() ) {
+            jsin.error( string_format( "expected single-object file but found '%c'", jsin.peek() ) );
+        }
+    } else if( jsin.test_array() ) {
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            ret.objects.emplace_back( jsin );
+        }
+    } else {
+        // not an object or an array?
+        jsin.error( "expected object or array" );
+    }
+    return ret;
+}
+
+int64_t ms_since( const std::chrono::steady_clock::time_point &start )
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now() - start ).count();
+}
+
+} // namespace
+
 void DynamicDataLoader::load_data_from_path( const std::string &path, const std::string &src,
-        loading_ui &ui )
+        loading_ui & )
 {
     assert( !finalized && "Can't load additional data after finalization.  Must be unloaded first." );
     // We assume that each folder is consistent in itself,
@@ -476,6 +561,10 @@ void DynamicDataLoader::load_data_from_path( const std::string &path, const std:
     // the first loaded mode might provide a vehicle that uses that frame
     // But not the other way round.
 
+    const auto start = std::chrono::steady_clock::now();
+    cata::hash_combine( mod_set_fingerprint, src );
+    cata::hash_combine( mod_set_fingerprint, path );
+    cata::hash_combine( data_fingerprint, src );
     // get a list of all files in the directory
     str_vec files = get_files_from_path( ".json", path, true, true );
     if( files.empty() ) {
@@ -486,60 +575,69 @@ void DynamicDataLoader::load_data_from_path( const std::string &path, const std:
             files.push_back( path );
         }
     }
-    // iterate over each file
-    for( auto &files_i : files ) {
-        const std::string &file = files_i;
-        // open the file as a stream
-        cata_ifstream infile = std::move( cata_ifstream().mode( cata_ios_mode::binary ).open( file ) );
-        // and stuff it into ram
-        std::istringstream iss(
-            std::string(
-                ( std::istreambuf_iterator<char>( *infile ) ),
-                std::istreambuf_iterator<char>()
-            )
-        );
-        try {
-            // parse it
-            JsonIn jsin( iss, file );
-            load_all_from_json( jsin, src, ui, path, file );
-        } catch( const JsonError &err ) {
-            throw std::runtime_error( err.what() );
-        }
+    // Files are read and parsed on the workers, but the objects are loaded here and in
+    // file order, so later files (and mods) still override earlier ones.
+    std::vector<std::future<parsed_json_file>> parsed;
+    parsed.reserve( files.size() );
+    for( const std::string &file : files ) {
+        parsed.push_back( cata::get_thread_pool().submit( [file]() {
+            return parse_json_file( file );
+        } ) );
     }
-}
 
-void DynamicDataLoader::load_all_from_json( JsonIn &jsin, const std::string &src, loading_ui &,
-        const std::string &base_path, const std::string &full_path )
-{
-    // TEMPORARY until 0.G: Remove single object support for consistency
-    if( jsin.test_object() ) {
-        // find type and dispatch single object
-        JsonObject jo = jsin.get_object();
-        load_object( jo, src, base_path, full_path );
-        jo.finish();
-        // if there's anything else in the file, it's an error.
-        jsin.eat_whitespace();
-        if( jsin.good() ) {
-            jsin.error( string_format( "expected single-object file but found '%c'", jsin.peek() ) );
+    std::chrono::steady_clock::duration waiting{};
+    size_t next = 0;
+    // Don't let the files that won't be loaded complain about unvisited members.
+    const auto abandon_rest = [&parsed, &next]() {
+        for( next++; next < parsed.size(); next++ ) {
+            try {
+                for( const JsonObject &jo : parsed[next].get().objects ) {
+                    jo.allow_omitted_members();
+                }
+            } catch( const std::exception & ) {
+            }
         }
-    } else if( jsin.test_array() ) {
-        jsin.start_array();
-        // find type and dispatch each object until array close
-        while( !jsin.end_array() ) {
-            JsonObject jo = jsin.get_object();
-            load_object( jo, src, base_path, full_path );
-            jo.finish();
+    };
+    try {
+        for( ; next < files.size(); next++ ) {
+            const auto wait_start = std::chrono::steady_clock::now();
+            parsed_json_file file = parsed[next].get();
+            waiting += std::chrono::steady_clock::now() - wait_start;
+            cata::hash_combine( data_fingerprint, files[next] );
+            cata::hash_combine( data_fingerprint, file.size );
+            cata::hash_combine( data_fingerprint, file.modified );
+            for( JsonObject &jo : file.objects ) {
+                load_object( jo, src, path, files[next] );
+                jo.finish();
+            }
+            inp_mngr.pump_events();
         }
-    } else {
-        // not an object or an array?
-        jsin.error( "expected object or array" );
+    } catch( const JsonError &err ) {
+        abandon_rest();
+        throw std::runtime_error( err.what() );
+    } catch( ... ) {
+        abandon_rest();
+        throw;
     }
-    inp_mngr.pump_events();
+    // Scripts can change the data too.
+    for( const std::string &script : get_files_from_path( ".lua", path, true, true ) ) {
+        std::error_code ec;
+        cata::hash_combine( data_fingerprint, script );
+        cata::hash_combine( data_fingerprint, std::filesystem::file_size( script, ec ) );
+        cata::hash_combine( data_fingerprint,
+                            std::filesystem::last_write_time( script, ec ).time_since_epoch().count() );
+    }
+    DebugLog( DL::Info, DC::Main ) << "Loaded " << files.size() << " files from " << path << " in "
+                                   << ms_since( start ) << " ms, "
+                                   << std::chrono::duration_cast<std::chrono::milliseconds>( waiting ).count()
+                                   << " ms of it waiting for files to be read and parsed";
 }
 
 void DynamicDataLoader::unload_data()
 {
     finalized = false;
+    data_fingerprint = 0;
+    mod_set_fingerprint = 0;
 
     //Moved to the top as a temp hack until vehicles are made into game objects
     vehicle_prototype::reset();
@@ -732,7 +830,12 @@ void DynamicDataLoader::check_consistency( loading_ui &ui )
 {
     ui.new_context( _( "Verifying" ) );
 
-    using named_entry = std::pair<std::string, std::function<void()>>;
+    struct named_entry {
+        std::string first;
+        std::function<void()> second;
+        // Only reports problems, doesn't complete the data as some checks do.
+        bool only_reports = false;
+    };
     const std::vector<named_entry> entries = {{
             { _( "Flags" ), &json_flag::check_consistency },
             { _( "Mutation Flags" ), &json_trait_flag::check_consistency },
@@ -740,7 +843,7 @@ void DynamicDataLoader::check_consistency( loading_ui &ui )
                 _( "Crafting requirements" ), []()
                 {
                     requirement_data::check_consistency();
-                }
+                }, true
             },
             { _( "Vitamins" ), &vitamin::check_consistency },
             { _( "Weather types" ), &weather_types::check_consistency },
@@ -757,15 +860,15 @@ void DynamicDataLoader::check_consistency( loading_ui &ui )
             { _( "Materials" ), &materials::check },
             { _( "Engine faults" ), &fault::check_consistency },
             { _( "Vehicle parts" ), &vpart_info::check },
-            { _( "Mapgen definitions" ), &check_mapgen_definitions },
+            { _( "Mapgen definitions" ), &check_mapgen_definitions, true },
             { _( "Mapgen palettes" ), &mapgen_palette::check_definitions },
             {
                 _( "Monster types" ), []()
                 {
                     MonsterGenerator::generator().check_monster_definitions();
-                }
+                }, true
             },
-            { _( "Monster groups" ), &MonsterGroupManager::check_group_definitions },
+            { _( "Monster groups" ), &MonsterGroupManager::check_group_definitions, true },
             { _( "Furniture and terrain" ), &check_furniture_and_terrain },
             { _( "Constructions" ), &constructions::check_consistency },
             { _( "Construction sequences" ), &constructions::check_consistency },
@@ -774,11 +877,11 @@ void DynamicDataLoader::check_consistency( loading_ui &ui )
             { _( "Martial arts" ), &check_martialarts },
             { _( "Mutations" ), &mutation_branch::check_consistency },
             { _( "Mutation Categories" ), &mutation_category_trait::check_consistency },
-            { _( "Overmap land use codes" ), &overmap_land_use_codes::check_consistency },
+            { _( "Overmap land use codes" ), &overmap_land_use_codes::check_consistency, true },
             { _( "Overmap connections" ), &overmap_connections::check_consistency },
-            { _( "Overmap terrain" ), &overmap_terrains::check_consistency },
-            { _( "Overmap locations" ), &overmap_locations::check_consistency },
-            { _( "Overmap specials" ), &overmap_specials::check_consistency },
+            { _( "Overmap terrain" ), &overmap_terrains::check_consistency, true },
+            { _( "Overmap locations" ), &overmap_locations::check_consistency, true },
+            { _( "Overmap specials" ), &overmap_specials::check_consistency, true },
             { _( "Map extras" ), &MapExtras::check_consistency },
             { _( "Start locations" ), &start_locations::check_consistency },
             { _( "Regional settings" ), &check_regional_settings },
@@ -816,15 +919,66 @@ void DynamicDataLoader::check_consistency( loading_ui &ui )
         ui.add_entry( e.first );
     }
 
+    // Checks are deterministic, so they need to run again only if the data or the
+    // game changed. Tests and mod checking always run everything.
+    const std::string stamp = string_format( "%s %zu", getVersionString(), data_fingerprint );
+    data_check_stamps passed( PATH_INFO::data_check_stamps() );
+    const bool skip_reports = !test_mode && passed.passed( mod_set_fingerprint, stamp );
+    const bool had_errors = debug_has_error_been_observed();
+
     ui.show();
     for( const named_entry &e : entries ) {
-        e.second();
+        if( !( skip_reports && e.only_reports ) ) {
+            e.second();
+        }
         ui.proceed();
     }
 
+    if( !test_mode && !skip_reports && !had_errors && !debug_has_error_been_observed() ) {
+        passed.mark_passed( mod_set_fingerprint, stamp );
+    }
+
     finalized = true;
 }
 
+data_check_stamps::data_check_stamps( const std::string &path ) : path( path )
+{
+    read_from_file( path, [this]( std::istream & fin ) {
+        std::string line;
+        while( std::getline( fin, line ) ) {
+            // The mod set, then the stamp up to the end of the line
+            std::istringstream entry( line );
+            size_t mod_set = 0;
+            std::string stamp;
+            if( entry >> mod_set && entry.get() == ' ' && std::getline( entry, stamp ) ) {
+                stamps.emplace_back( mod_set, stamp );
+            }
+        }
+    }, true );
+}
+
+bool data_check_stamps::passed( const size_t mod_set, const std::string &stamp ) const
+{
+    return std::ranges::find( stamps, std::make_pair( mod_set, stamp ) ) != stamps.end();
+}
+
+bool data_check_stamps::mark_passed( const size_t mod_set, const std::string &stamp )
+{
+    std::erase_if( stamps, [mod_set]( const std::pair<size_t, std::string> &entry ) {
+        return entry.first == mod_set;
+    } );
+    stamps.emplace_back( mod_set, stamp );
+    if( stamps.size() > max_stamps ) {
+        stamps.erase( stamps.begin(), stamps.end() - max_stamps );
+    }
+    // Only a cache, failing to write it just means checking again next time.
+    return write_to_file( path, [this]( std::ostream & fout ) {
+        for( const auto &[set, set_stamp] : stamps ) {
+            fout << set << ' ' << set_stamp << '\n';
+        }
+    }, "" );
+}
+
 /**
  * Load & finalize specified content packs.
  * @param ui structure for load progress display
@@ -883,12 +1037,16 @@ static void load_and_finalize_packs( loading_ui &ui, const std::string &msg,
 
     cata::reg_lua_iuse_actors( *loader.lua, *item_controller );
 
+    auto phase_start = std::chrono::steady_clock::now();
     for( const mod_id &mod : available ) {
         loader.load_data_from_path( mod->path, mod.str(), ui );
         ui.proceed();
     }
+    DebugLog( DL::Info, DC::Main ) << "Loading content packs took " << ms_since( phase_start ) << " ms";
 
+    phase_start = std::chrono::steady_clock::now();
     loader.finalize_loaded_data( ui );
+    DebugLog( DL::Info, DC::Main ) << "Finalizing loaded data took " << ms_since( phase_start ) << " ms";
 
     if( cata::has_lua() ) {
         for( const mod_id &mod : available ) {
@@ -899,7 +1057,9 @@ static void load_and_finalize_packs( loading_ui &ui, const std::string &msg,
         }
     }
 
+    phase_start = std::chrono::steady_clock::now();
     loader.check_consistency( ui );
+    DebugLog( DL::Info, DC::Main ) << "Checking consistency took " << ms_since( phase_start ) << " ms";
 
     if( cata::has_lua() ) {
         init::load_main_lua_scripts( *loader.lua, packs );
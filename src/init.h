@@ -14,7 +14,6 @@
 
 class loading_ui;
 class JsonObject;
-class JsonIn;
 class world;
 
 /**
@@ -71,6 +70,13 @@ class DynamicDataLoader
 
     private:
         bool finalized = false;
+        /**
+         * Hash of the content packs and of the path, size and modification time of
+         * every file loaded from them, see @ref check_consistency.
+         */
+        size_t data_fingerprint = 0;
+        /** Hash of just the content packs and their paths, see @ref data_check_stamps. */
+        size_t mod_set_fingerprint = 0;
 
         struct cached_streams;
         std::unique_ptr<cached_streams> stream_cache;
@@ -86,17 +92,6 @@ class DynamicDataLoader
         void add( const std::string &type,
                   std::function<void( const JsonObject &, const std::string &, const std::string &, const std::string & )>
                   f );
-        /**
-         * Load all the types from that json data.
-         * @param jsin Might contain single object,
-         * or an array of objects. Each object must have a
-         * "type", that is part of the @ref type_function_map
-         * @param src String identifier for mod this data comes from
-         * @param ui Finalization status display.
-         * @throws std::exception on all kind of errors.
-         */
-        void load_all_from_json( JsonIn &jsin, const std::string &src, loading_ui &ui,
-                                 const std::string &base_path, const std::string &full_path );
         /**
          * Load a single object from a json object.
          * @param jo The json object to load the C++-object from.
@@ -118,6 +113,8 @@ class DynamicDataLoader
         /**
          * Check the consistency of all the loaded data.
          * May print a debugmsg if something seems wrong.
+         * Checks that only report problems are skipped if the same data (and game
+         * version) passed them before without errors, see @ref data_check_stamps.
          * @param ui Finalization status display.
          */
         void check_consistency( loading_ui &ui );
@@ -169,14 +166,38 @@ class DynamicDataLoader
         }
 
         /**
-         * Get a possibly cached stream for deferred data loading. If the cached
-         * stream is still in use by outside code, this returns a new stream to
-         * avoid conflict of stream cursor. The stream cursor is not reset if a
-         * cached stream is returned.
+         * Get a stream for deferred data loading. The file contents are cached,
+         * every call returns a new stream (with its own cursor) over them.
          */
         shared_ptr_fast<std::istream> get_cached_stream( const std::string &path );
 };
 
+/**
+ * Loaded data that passed the consistency checks which only report problems, one stamp
+ * per set of content packs. Switching between worlds with different mods keeps them.
+ */
+class data_check_stamps
+{
+    public:
+        /** Reads the stamps saved at @p path, if any. */
+        explicit data_check_stamps( const std::string &path );
+
+        /** Whether the data @p stamp of the content packs @p mod_set passed before. */
+        bool passed( size_t mod_set, const std::string &stamp ) const;
+        /**
+         * Remembers that @p stamp passed for @p mod_set, replacing what the same content
+         * packs passed with before, and saves the stamps.
+         */
+        bool mark_passed( size_t mod_set, const std::string &stamp );
+
+    private:
+        // Plenty for one player's worlds, the sets that passed longest ago are dropped.
+        static constexpr size_t max_stamps = 32;
+        std::string path;
+        // The sets that passed longest ago first
+        std::vector<std::pair<size_t, std::string>> stamps;
+};
+
 namespace init
 {
 
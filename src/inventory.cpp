@@ -16,6 +16,7 @@
 #include "distribution_grid.h"
 #include "game.h"
 #include "iexamine.h"
+#include "item_summary.h"
 #include "locations.h"
 #include "magic_enchantment.h"
 #include "map.h"
@@ -174,6 +175,8 @@ void inventory::clear()
     items.clear();
     binned = false;
     items_type_cached = false;
+    summarized_items.clear();
+    summarized_qualities.clear();
 }
 
 inventory &inventory::add_items( const inventory &rhs, bool keep_invlet, bool assign_invlet,
@@ -483,6 +486,8 @@ void inventory::form_from_map( map &m, std::vector<tripoint> pts, const Characte
     const time_point bday = calendar::start_of_cataclysm;
     std::unordered_map<const vehicle *, std::unordered_set<const vpart_reference *>> checked_vehi;
     items.clear();
+    summarized_items.clear();
+    summarized_qualities.clear();
     build_items_type_cache();
     for( const tripoint &p : pts ) {
         if( m.has_furn( p ) ) {
@@ -506,15 +511,25 @@ void inventory::form_from_map( map &m, std::vector<tripoint> pts, const Characte
         }
         if( m.has_items( p ) && m.accessible_items( p ) ) {
             bool allow_liquids = m.has_flag_ter_or_furn( "LIQUIDCONT", p );
-            for( auto &i : m.i_at( p ) ) {
-                // if it's *the* player requesting this from from map inventory
-                // then don't allow items owned by another faction to be factored into recipe components etc.
-                if( pl && !i->is_owned_by( *pl, true ) && i->get_owner()->likes_u >= -10 ) {
-                    continue;
-                }
-                if( allow_liquids || !i->made_of( LIQUID ) ) {
+            const item_summary &summary = m.items_summary( p );
+            if( summary.usable( pl != nullptr, allow_liquids ) ) {
+                // Nothing on this spot is filtered out.
+                add_quality_counts( summarized_qualities, summary.qualities );
+                for( item *const &i : m.i_at( p ) ) {
+                    summarized_items.push_back( i );
                     add_item_by_items_type_cache( *i, false, assign_invlet, false );
                 }
+            } else {
+                for( auto &i : m.i_at( p ) ) {
+                    // if it's *the* player requesting this from from map inventory
+                    // then don't allow items owned by another faction to be factored into recipe components etc.
+                    if( pl && !i->is_owned_by( *pl, true ) && i->get_owner()->likes_u >= -10 ) {
+                        continue;
+                    }
+                    if( allow_liquids || !i->made_of( LIQUID ) ) {
+                        add_item_by_items_type_cache( *i, false, assign_invlet, false );
+                    }
+                }
             }
         }
         // Kludges for now!
@@ -575,8 +590,16 @@ void inventory::form_from_map( map &m, std::vector<tripoint> pts, const Characte
         const std::optional<vpart_reference> cargo = vp.part_with_feature( "CARGO", true );
 
         if( cargo ) {
+            const item_summary &summary = cargo->part().items_summary();
+            const bool summarized = summary.usable( false, true );
+            if( summarized ) {
+                add_quality_counts( summarized_qualities, summary.qualities );
+            }
             const auto items = veh->get_items( cargo->part_index() );
             for( const auto &it : items ) {
+                if( summarized ) {
+                    summarized_items.push_back( it );
+                }
                 add_item_by_items_type_cache( *it, false, false, false );
             }
         }
@@ -1145,8 +1168,8 @@ enchantment inventory::get_active_enchantment_cache( const Character &owner ) co
 
 void inventory::update_quality_cache()
 {
-    quality_cache.clear();
-    visit_items( [ this ]( const item * e ) {
+    quality_cache = summarized_qualities;
+    const auto count_qualities = [this]( const item * e ) {
         const std::map<quality_id, int> &item_qualities = e->get_qualities();
         for( const std::pair<const quality_id, int> &quality : item_qualities ) {
             const int item_count = e->count_by_charges() ? e->charges : 1;
@@ -1155,7 +1178,26 @@ void inventory::update_quality_cache()
             quality_cache[quality.first][quality.second] += item_count;
         }
         return VisitResponse::NEXT;
-    } );
+    };
+    // Summarized items head their own stacks, in the order they were added
+    size_t summarized_found = 0;
+    for( const std::vector<item *> &stack : items ) {
+        auto first = stack.begin();
+        if( !stack.empty() && summarized_found < summarized_items.size() &&
+            *first == summarized_items[summarized_found] ) {
+            summarized_found++;
+            first++;
+        }
+        for( auto it = first; it != stack.end(); ++it ) {
+            ( *it )->visit_items( count_qualities );
+        }
+    }
+    if( summarized_found != summarized_items.size() ) {
+        // Some summarized items were removed or moved since, count everything the slow way.
+        summarized_items.clear();
+        summarized_qualities.clear();
+        update_quality_cache();
+    }
 }
 
 const std::map<quality_id, std::map<int, int>> &inventory::get_quality_cache() const
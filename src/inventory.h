@@ -239,6 +239,14 @@ class inventory : public temp_visitable<inventory>
         std::list<std::vector<item *>> items;
         std::map<itype_id, std::list<std::vector<item *> *>> items_type_cache;
         std::map<quality_id, std::map<int, int>> quality_cache;
+        /**
+         * Map and vehicle items @ref form_from_map took from piles with a usable
+         * @ref item_summary, in the order their stacks were added, and the qualities
+         * of those piles together. @ref update_quality_cache adds the totals instead
+         * of visiting these items.
+         */
+        std::vector<const item *> summarized_items;
+        std::map<quality_id, std::map<int, int>> summarized_qualities;
 
         bool items_type_cached = false;
         mutable bool binned = false;
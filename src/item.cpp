@@ -501,6 +501,7 @@ item &item::operator=( const item &source )
     for( item * const &it : source.components ) {
         components.push_back( item::spawn( *it ) );
     }
+    notify_location();
     return *this;
 }
 
@@ -545,6 +546,7 @@ void item::convert( const itype_id &new_type )
 {
     type = &*new_type;
     relic_data = type->relic_data;
+    notify_location();
 }
 
 void item::deactivate()
@@ -762,6 +764,7 @@ void item::set_damage( int qty )
 {
     on_damage( qty - damage_, DT_TRUE );
     damage_ = std::max( std::min( qty, max_damage() ), min_damage() );
+    notify_location();
 }
 
 detached_ptr<item> item::split( int qty )
@@ -1171,6 +1174,7 @@ void item::set_var( const std::string &name, const int value )
     tmpstream.imbue( std::locale::classic() );
     tmpstream << value;
     item_vars[name] = tmpstream.str();
+    notify_location();
 }
 
 void item::set_var( const std::string &name, const long long value )
@@ -1179,6 +1183,7 @@ void item::set_var( const std::string &name, const long long value )
     tmpstream.imbue( std::locale::classic() );
     tmpstream << value;
     item_vars[name] = tmpstream.str();
+    notify_location();
 }
 
 // NOLINTNEXTLINE(cata-no-long)
@@ -1188,11 +1193,13 @@ void item::set_var( const std::string &name, const long value )
     tmpstream.imbue( std::locale::classic() );
     tmpstream << value;
     item_vars[name] = tmpstream.str();
+    notify_location();
 }
 
 void item::set_var( const std::string &name, const double value )
 {
     item_vars[name] = string_format( "%f", value );
+    notify_location();
 }
 
 double item::get_var( const std::string &name, const double default_value ) const
@@ -1207,6 +1214,7 @@ double item::get_var( const std::string &name, const double default_value ) cons
 void item::set_var( const std::string &name, const tripoint &value )
 {
     item_vars[name] = string_format( "%d,%d,%d", value.x, value.y, value.z );
+    notify_location();
 }
 
 tripoint item::get_var( const std::string &name, const tripoint &default_value ) const
@@ -1224,6 +1232,7 @@ tripoint item::get_var( const std::string &name, const tripoint &default_value )
 void item::set_var( const std::string &name, const std::string &value )
 {
     item_vars[name] = value;
+    notify_location();
 }
 
 std::string item::get_var( const std::string &name, const std::string &default_value ) const
@@ -1248,11 +1257,13 @@ bool item::has_var( const std::string &name ) const
 void item::erase_var( const std::string &name )
 {
     item_vars.erase( name );
+    notify_location();
 }
 
 void item::clear_vars()
 {
     item_vars.clear();
+    notify_location();
 }
 
 void item::add_item_with_id( const itype_id &itype, int count )
@@ -1470,6 +1481,7 @@ void item::set_owner( const Character &c )
         return;
     }
     owner = c.get_faction()->id;
+    notify_location();
 }
 
 faction_id item::get_owner() const
@@ -4776,6 +4788,7 @@ void item::on_contents_changed()
     }
 
     encumbrance_update_ = true;
+    notify_location();
 }
 
 void item::on_damage( int qty, damage_type )
@@ -5689,6 +5702,7 @@ bool item::can_shatter() const
 void item::unset_flags()
 {
     item_tags.clear();
+    notify_location();
 }
 
 bool item::has_fault( const fault_id &fault ) const
@@ -5753,6 +5767,7 @@ void item::set_flag( const flag_id &flag )
 {
     if( flag.is_valid() ) {
         item_tags.insert( flag );
+        notify_location();
     } else {
         debugmsg( "Attempted to set invalid flag_id %s", flag.str() );
     }
@@ -5761,6 +5776,7 @@ void item::set_flag( const flag_id &flag )
 void item::unset_flag( const flag_id &flag )
 {
     item_tags.erase( flag );
+    notify_location();
 }
 
 void item::set_flag_recursive( const flag_id &flag )
@@ -6725,6 +6741,7 @@ bool item::mod_damage( int qty, damage_type dt )
 
         damage_ = std::max( std::min( damage_ + qty, max_damage() ), min_damage() );
     }
+    notify_location();
 
     return destroy;
 }
@@ -9497,6 +9514,48 @@ int item::processing_speed() const
     return 1;
 }
 
+bool item::only_rots() const
+{
+    static const std::array<flag_id, 11> processed_flags = {{
+            flag_ETHEREAL_ITEM, flag_FAKE_SMOKE, flag_FAKE_MILL, flag_WET, flag_LITCIG,
+            flag_WATER_EXTINGUISH, flag_WIND_EXTINGUISH, flag_CABLE_SPOOL, flag_IS_UPS,
+            flag_RADIO_ACTIVATION, flag_PROCESSING
+        }
+    };
+    // The starting shelf life variation is rolled on the first rot check, let that happen first.
+    if( !is_food() || !goes_bad() || is_corpse() || !contents.empty() ||
+        last_rot_check <= calendar::start_of_cataclysm ) {
+        return false;
+    }
+    if( is_tool() || is_artifact() || is_relic() || !faults.empty() ||
+        !type->emits.empty() || type->countdown_action ) {
+        return false;
+    }
+    return std::ranges::none_of( processed_flags, [this]( const flag_id & f ) {
+        return has_flag( f );
+    } );
+}
+
+time_duration item::time_until_rot_state_change() const
+{
+    const time_duration shelf_life = get_shelf_life();
+    const int rot_per_hour = get_hourly_rotpoints_at_temp( units::temperature_max );
+    if( shelf_life <= 0_turns || rot_per_hour <= 0 ) {
+        return 0_turns;
+    }
+    // Thresholds of is_fresh, is_going_bad, rotten and has_rotten_away.
+    static constexpr std::array<double, 4> thresholds = {{ 0.1, 0.9, 1.0, 2.0 }};
+    const double relative_rot = get_relative_rot();
+    const auto next = std::ranges::find_if( thresholds, [relative_rot]( double t ) {
+        return t > relative_rot;
+    } );
+    if( next == thresholds.end() ) {
+        return 0_turns;
+    }
+    const double remaining_rot = to_turns<double>( shelf_life ) * ( *next - relative_rot );
+    return std::min( 1_hours * ( remaining_rot / rot_per_hour ), calendar::INDEFINITELY_LONG_DURATION );
+}
+
 detached_ptr<item> item::process_rot( detached_ptr<item> &&self, const tripoint &pos )
 {
     return process_rot( std::move( self ), false, pos, nullptr, temperature_flag::TEMP_NORMAL,
@@ -9534,13 +9593,22 @@ detached_ptr<item>  item::process_rot( detached_ptr<item> &&self, const bool sea
     if( !self ) {
         return std::move( self );
     }
+    if( !self->accumulate_rot( pos, flag, weather, carrier == nullptr && !seals ) ) {
+        return detached_ptr<item>();
+    }
+    return std::move( self );
+}
+
+bool item::accumulate_rot( const tripoint &pos, const temperature_flag flag,
+                           const weather_manager &weather, const bool can_rot_away )
+{
     const time_point now = calendar::turn;
 
     // if player debug menu'd the time backward it breaks stuff, just reset the
     // last_temp_check and last_rot_check in this case
-    if( now - self->last_rot_check < 0_turns ) {
-        self->last_rot_check = now;
-        return std::move( self );
+    if( now - last_rot_check < 0_turns ) {
+        last_rot_check = now;
+        return true;
     }
 
     // process rot at most once every 100_turns (10 min)
@@ -9550,8 +9618,8 @@ detached_ptr<item>  item::process_rot( detached_ptr<item> &&self, const bool sea
     units::temperature temp = weather.get_temperature( pos );
     temp = clip_by_temperature_flag( temp, flag );
 
-    time_point time = self->last_rot_check;
-    item_internal::scoped_goes_bad_cache _cache( &*self );
+    time_point time = last_rot_check;
+    item_internal::scoped_goes_bad_cache _cache( this );
 
     if( now - time > 1_hours ) {
         // This code is for items that were left out of reality bubble for long time
@@ -9583,12 +9651,12 @@ detached_ptr<item>  item::process_rot( detached_ptr<item> &&self, const bool sea
             units::temperature env_temperature_clipped = clip_by_temperature_flag( env_temperature_raw, flag );
 
             // Calculate item rot
-            self->rot += self->calc_rot( time, env_temperature_clipped );
-            self->last_rot_check = time;
+            rot += calc_rot( time, env_temperature_clipped );
+            last_rot_check = time;
 
-            if( self->has_rotten_away() && carrier == nullptr && !seals ) {
+            if( can_rot_away && has_rotten_away() ) {
                 // No need to track item that will be gone
-                return detached_ptr<item>();
+                return false;
             }
         }
     }
@@ -9596,16 +9664,12 @@ detached_ptr<item>  item::process_rot( detached_ptr<item> &&self, const bool sea
     // Remaining <1 h from above
     // and items that are held near the player
     if( now - time > smallest_interval ) {
-        self->rot += self->calc_rot( now, temp );
-        self->last_rot_check = now;
+        rot += calc_rot( now, temp );
+        last_rot_check = now;
 
-        if( self->has_rotten_away() && carrier == nullptr && !seals ) {
-            return detached_ptr<item>();
-        } else {
-            return std::move( self );
-        }
+        return !( can_rot_away && has_rotten_away() );
     }
-    return std::move( self );
+    return true;
 }
 
 void item::process_artifact( player *carrier, const tripoint & /*pos*/ )
@@ -10404,6 +10468,7 @@ void item::mod_charges( int mod )
     } else {
         charges += mod;
     }
+    notify_location();
 }
 
 bool item::has_effect_when_wielded( art_effect_passive effect ) const
@@ -922,6 +922,20 @@ class item : public location_visitable<item>, public game_object<item>
                                                const weather_manager &weather_generator );
         /*@}*/
 
+        /**
+         * Adds the rot since the last check, like @ref process_rot but in place.
+         * @param can_rot_away Whether to stop once the item has rotted away.
+         * @returns false if it stopped because the item rotted away and should be removed.
+         */
+        bool accumulate_rot( const tripoint &pos, temperature_flag flag,
+                             const weather_manager &weather, bool can_rot_away );
+
+        /**
+         * Shortest time until the item is fresh no longer, going bad, rotten or rotten away,
+         * assuming the hottest possible storage.
+         */
+        time_duration time_until_rot_state_change() const;
+
         int get_comestible_fun() const;
 
         /** whether an item is perishable (can rot) */
@@ -1234,6 +1248,11 @@ class item : public location_visitable<item>, public game_object<item>
          * The rate at which an item should be processed, in number of turns between updates.
          */
         int processing_speed() const;
+        /**
+         * Whether processing does nothing but add rot. Such items can be left alone until
+         * @ref time_until_rot_state_change, the rot is caught up on when they are next processed.
+         */
+        bool only_rots() const;
         /**
          * Process and apply artifact effects. This should be called exactly once each turn, it may
          * modify character stats (like speed, strength, ...), so call it after those have been reset.
@@ -2177,6 +2196,7 @@ class item : public location_visitable<item>, public game_object<item>
         }
         inline void set_owner( const faction_id &new_owner ) {
             owner = new_owner;
+            notify_location();
         }
         void set_owner( const Character &c );
         inline void remove_owner() const {
@@ -0,0 +1,58 @@
+#include "item_summary.h"
+
+#include "item.h"
+#include "visitable.h"
+
+static void count_item( item_summary &summary, const item &top, const int sign )
+{
+    summary.owned += top.get_owner().is_null() ? 0 : sign;
+    summary.liquids += top.made_of( LIQUID ) ? sign : 0;
+    top.visit_items( [&summary, sign]( const item * e ) {
+        const std::map<quality_id, int> &item_qualities = e->get_qualities();
+        if( !item_qualities.empty() && e->count_by_charges() ) {
+            summary.counted_by_charges += sign;
+        }
+        for( const std::pair<const quality_id, int> &quality : item_qualities ) {
+            std::map<int, int> &levels = summary.qualities[quality.first];
+            const int total = levels[quality.second] += sign * e->count();
+            // Keep the layout of a fresh summary, which has no empty entries
+            if( total == 0 ) {
+                levels.erase( quality.second );
+                if( levels.empty() ) {
+                    summary.qualities.erase( quality.first );
+                }
+            }
+        }
+        return VisitResponse::NEXT;
+    } );
+}
+
+void item_summary::add( const item &top )
+{
+    count_item( *this, top, 1 );
+}
+
+void item_summary::remove( const item &top )
+{
+    count_item( *this, top, -1 );
+}
+
+item_summary item_summary::summarize( const std::vector<item *> &items )
+{
+    item_summary ret;
+    for( const item *top : items ) {
+        ret.add( *top );
+    }
+    return ret;
+}
+
+void add_quality_counts( std::map<quality_id, std::map<int, int>> &to,
+                         const std::map<quality_id, std::map<int, int>> &from )
+{
+    for( const auto &quality : from ) {
+        std::map<int, int> &levels = to[quality.first];
+        for( const std::pair<const int, int> &level : quality.second ) {
+            levels[level.first] += level.second;
+        }
+    }
+}
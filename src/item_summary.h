@@ -0,0 +1,46 @@
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include "type_id.h"
+
+class item;
+
+/**
+ * What a pile of items adds to the quality cache of an inventory, see
+ * @ref inventory::update_quality_cache.
+ *
+ * Piles that crafting looks through often (map spots and vehicle cargo) keep their
+ * summary in their @ref item_pile_location. Items added to or removed from the pile
+ * are counted in or out of it, an item changing inside the pile drops it. The counts
+ * of items with owners, liquids and charges mark piles whose items may not all end up
+ * in an inventory, or whose totals can change unnoticed.
+ */
+struct item_summary {
+    /** Same layout as @ref inventory::get_quality_cache. */
+    std::map<quality_id, std::map<int, int>> qualities;
+    /** Top level items with an owner, they may be filtered out per character. */
+    int owned = 0;
+    /** Top level liquids, they are skipped on spots that can't hold liquids. */
+    int liquids = 0;
+    /** Items with qualities counted by charges, which are changed in place. */
+    int counted_by_charges = 0;
+
+    /** Whether an inventory may take @ref qualities instead of visiting the items. */
+    bool usable( bool filter_owned, bool allow_liquids ) const {
+        return counted_by_charges == 0 && !( filter_owned && owned > 0 ) &&
+               ( allow_liquids || liquids == 0 );
+    }
+
+    /** Counts @p top and its contents in. */
+    void add( const item &top );
+    /** Counts @p top and its contents out, it must have been counted in unchanged. */
+    void remove( const item &top );
+
+    static item_summary summarize( const std::vector<item *> &items );
+};
+
+/** Adds the quality counts of @p from to @p to. */
+void add_quality_counts( std::map<quality_id, std::map<int, int>> &to,
+                         const std::map<quality_id, std::map<int, int>> &from );
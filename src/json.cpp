@@ -1,6 +1,7 @@
 #include "json.h"
 
 #include <algorithm>
+#include <bit>
 #include <bitset>
 #include <cmath> // pow
 #include <cstdint>
@@ -20,6 +21,7 @@
 #include "cached_options.h"
 #include "cata_utility.h"
 #include "debug.h"
+#include "memory_stream.h"
 #include "string_formatter.h"
 #include "string_utils.h"
 
@@ -32,6 +34,93 @@ static bool is_whitespace( char ch )
     return ( ch == ' ' || ch == '\n' || ch == '\t' || ch == '\r' );
 }
 
+// Scanning of in-memory data for JsonIn, eight bytes at a time where the
+// byte order allows it. Each byte of a word maps to the high bit of that byte
+// in the masks.
+namespace
+{
+
+constexpr uint64_t low_bits = 0x0101010101010101ULL;
+constexpr uint64_t high_bits = 0x8080808080808080ULL;
+constexpr bool scan_words = std::endian::native == std::endian::little;
+
+uint64_t load_word( const char *p )
+{
+    uint64_t w;
+    std::memcpy( &w, p, sizeof( w ) );
+    return w;
+}
+
+// Bytes that are not zero. Exact, unlike the usual has-zero-byte trick.
+constexpr uint64_t nonzero_bytes( uint64_t w )
+{
+    return ( ( ( w & ~high_bits ) + ~high_bits ) | w ) & high_bits;
+}
+
+constexpr uint64_t bytes_other_than( uint64_t w, unsigned char c )
+{
+    return nonzero_bytes( w ^ ( low_bits * c ) );
+}
+
+const char *first_flagged( const char *p, uint64_t mask )
+{
+    return p + std::countr_zero( mask ) / 8;
+}
+
+/** First byte at or after @p p that is not whitespace, or @p end. */
+const char *skip_whitespace( const char *p, const char *end )
+{
+    if constexpr( scan_words ) {
+        for( ; end - p >= 8; p += 8 ) {
+            const uint64_t w = load_word( p );
+            const uint64_t other = bytes_other_than( w, ' ' ) & bytes_other_than( w, '\n' ) &
+                                   bytes_other_than( w, '\t' ) & bytes_other_than( w, '\r' );
+            if( other ) {
+                return first_flagged( p, other );
+            }
+        }
+    }
+    while( p < end && is_whitespace( *p ) ) {
+        p++;
+    }
+    return p;
+}
+
+/**
+ * First byte at or after @p p that a string can't just copy: a quote, a backslash,
+ * a control character or part of a multibyte character. Or @p end.
+ */
+const char *skip_plain_string( const char *p, const char *end )
+{
+    if constexpr( scan_words ) {
+        constexpr uint64_t above_control = low_bits * 0xE0;
+        for( ; end - p >= 8; p += 8 ) {
+            const uint64_t w = load_word( p );
+            const uint64_t plain = bytes_other_than( w, '"' ) & bytes_other_than( w, '\\' ) &
+                                   nonzero_bytes( w & above_control );
+            const uint64_t special = ( ~plain | w ) & high_bits;
+            if( special ) {
+                return first_flagged( p, special );
+            }
+        }
+    }
+    for( ; p < end; p++ ) {
+        const unsigned char ch = static_cast<unsigned char>( *p );
+        if( ch == '"' || ch == '\\' || ch < 0x20 || ch >= 0x80 ) {
+            break;
+        }
+    }
+    return p;
+}
+
+bool is_number_char( char ch )
+{
+    return ch == '+' || ch == '-' || ( ch >= '0' && ch <= '9' ) || ch == 'e' || ch == 'E' ||
+           ch == '.';
+}
+
+} // namespace
+
 // for parsing \uxxxx escapes
 static std::string utf16_to_utf8( uint32_t ch )
 {
@@ -809,12 +898,29 @@ void add_array_to_set( std::set<std::string> &s, const JsonObject &json, const s
     }
 }
 
+memory_streambuf *JsonIn::buffer_of( std::istream &s )
+{
+    return dynamic_cast<memory_streambuf *>( s.rdbuf() );
+}
+
+bool JsonIn::can_scan() const
+{
+    // Reading past the end or failing sets the stream state, leave that to the stream.
+    return buffer && stream->good();
+}
+
 int JsonIn::tell()
 {
+    if( can_scan() ) {
+        return buffer->cursor() - buffer->begin();
+    }
     return stream->tellg();
 }
 char JsonIn::peek()
 {
+    if( can_scan() && buffer->cursor() != buffer->end() ) {
+        return *buffer->cursor();
+    }
     return static_cast<char>( stream->peek() );
 }
 bool JsonIn::good()
@@ -831,6 +937,9 @@ void JsonIn::seek( int pos )
 
 void JsonIn::eat_whitespace()
 {
+    if( can_scan() ) {
+        buffer->set_cursor( skip_whitespace( buffer->cursor(), buffer->end() ) );
+    }
     while( is_whitespace( peek() ) ) {
         stream->get();
     }
@@ -918,6 +1027,9 @@ void JsonIn::skip_string()
         error( err.str(), -1 );
     }
     while( stream->good() ) {
+        if( buffer ) {
+            buffer->set_cursor( skip_plain_string( buffer->cursor(), buffer->end() ) );
+        }
         stream->get( ch );
         if( ch == '\\' ) {
             stream->get( ch );
@@ -1025,10 +1137,16 @@ void JsonIn::skip_number()
     char ch;
     eat_whitespace();
     // skip all of (+-0123456789.eE)
+    if( can_scan() ) {
+        const char *p = std::find_if_not( buffer->cursor(), buffer->end(), is_number_char );
+        // Hitting the end changes the stream state, the loop below takes care of that.
+        if( p != buffer->end() ) {
+            buffer->set_cursor( p );
+        }
+    }
     while( stream->good() ) {
         stream->get( ch );
-        if( ch != '+' && ch != '-' && ( ch < '0' || ch > '9' ) &&
-            ch != 'e' && ch != 'E' && ch != '.' ) {
+        if( !is_number_char( ch ) ) {
             stream->unget();
             break;
         }
@@ -1197,6 +1315,12 @@ std::string JsonIn::get_string()
         }
         // add chars to the string, one at a time
         do {
+            if( can_scan() ) {
+                const char *plain = buffer->cursor();
+                const char *special = skip_plain_string( plain, buffer->end() );
+                s.append( plain, special );
+                buffer->set_cursor( special );
+            }
             ch = stream->peek();
             if( !stream->good() ) {
                 err = "read operation failed";
@@ -2,20 +2,25 @@
 #include "shadowcasting.h" // IWYU pragma: associated
 
 #include <algorithm>
+#include <bitset>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <utility>
 #include <vector>
 
 #include "avatar.h"
+#include "cached_options.h"
 #include "calendar.h"
 #include "cata_unreachable.h"
 #include "cata_utility.h"
 #include "character.h"
+#include "coordinate_conversions.h"
 #include "cuboid_rectangle.h"
+#include "debug.h"
 #include "field.h"
 #include "fragment_cloud.h" // IWYU pragma: keep
 #include "game.h"
@@ -30,6 +35,7 @@
 #include "monster.h"
 #include "mtype.h"
 #include "npc.h"
+#include "options.h"
 #include "player.h"
 #include "point.h"
 #include "profile.h"
@@ -434,9 +440,114 @@ void map::build_sunlight_cache( int pzlev )
     }
 }
 
+light_source_cache::light_source_cache()
+{
+    constexpr four_quadrants four_zeros( 0.0f );
+    std::fill_n( &scratch[0][0], MAPSIZE_X * MAPSIZE_Y, four_zeros );
+    std::fill_n( &transparency[0][0], MAPSIZE_X * MAPSIZE_Y, 0.0f );
+    diagonal_blocks fill = {false, false};
+    std::fill_n( &blocked[0][0], MAPSIZE_X * MAPSIZE_Y, fill );
+}
+
+// Lightmap builds a light source may go unused before its contribution is dropped.
+// A bit more than a couple of turns, so lights blinking on odd or even turns are kept.
+static constexpr int MAX_IDLE_LIGHT_BUILDS = 8;
+
+light_source_cache &map::prepare_light_source_cache( const int zlev )
+{
+    std::unique_ptr<light_source_cache> &sources = light_source_caches[zlev + OVERMAP_DEPTH];
+    if( !sources ) {
+        sources = std::make_unique<light_source_cache>();
+    }
+    const level_cache &map_cache = get_cache_ref( zlev );
+    sources->generation++;
+
+    // Contributions are in local coordinates and the rest changes rarely, so drop everything
+    // when any of it changed. Otherwise only drop sources that could see a changed submap.
+    // The transparency is compared rather than relying on transparency_cache_dirty alone,
+    // because vehicles write their opaque tiles after the dirty flags have been cleared.
+    // Vehicle blocks are compared the same way, a moving vehicle only drops the light around it.
+    if( sources->abs_sub != abs_sub || sources->trigdist != trigdist ||
+        sources->weather_transparency != weather_transparency_lookup.transparency ) {
+        sources->contributions.clear();
+    } else {
+        std::bitset<MAPSIZE *MAPSIZE> changed;
+        for( int smx = 0; smx < MAPSIZE; smx++ ) {
+            for( int smy = 0; smy < MAPSIZE; smy++ ) {
+                for( int sx = 0; sx < SEEX; sx++ ) {
+                    const int x = smx * SEEX + sx;
+                    const int y = smy * SEEY;
+                    if( std::memcmp( &sources->transparency[x][y], &map_cache.transparency_cache[x][y],
+                                     SEEY * sizeof( float ) ) != 0 ||
+                        std::memcmp( &sources->blocked[x][y], &map_cache.vehicle_obscured_cache[x][y],
+                                     SEEY * sizeof( diagonal_blocks ) ) != 0 ) {
+                        changed.set( smx * MAPSIZE + smy );
+                        break;
+                    }
+                }
+            }
+        }
+        if( changed.any() ) {
+            for( auto iter = sources->contributions.begin(); iter != sources->contributions.end(); ) {
+                if( ( iter->second.reach & changed ).any() ) {
+                    iter = sources->contributions.erase( iter );
+                } else {
+                    ++iter;
+                }
+            }
+        }
+    }
+    std::memcpy( sources->transparency, map_cache.transparency_cache, sizeof( sources->transparency ) );
+    std::memcpy( sources->blocked, map_cache.vehicle_obscured_cache, sizeof( sources->blocked ) );
+    sources->weather_transparency = weather_transparency_lookup.transparency;
+    sources->abs_sub = abs_sub;
+    sources->trigdist = trigdist;
+    sources->cast_count = 0;
+    sources->reused_count = 0;
+    return *sources;
+}
+
 void map::generate_lightmap( const int zlev )
 {
     ZoneScoped;
+    if( !get_option<bool>( "INCREMENTAL_LIGHTMAP" ) ) {
+        build_lightmap( zlev );
+        return;
+    }
+
+    light_source_cache &sources = prepare_light_source_cache( zlev );
+    active_light_sources = &sources;
+    active_light_sources_z = zlev;
+    build_lightmap( zlev );
+    active_light_sources = nullptr;
+
+    for( auto iter = sources.contributions.begin(); iter != sources.contributions.end(); ) {
+        if( sources.generation - iter->second.last_used > MAX_IDLE_LIGHT_BUILDS ) {
+            iter = sources.contributions.erase( iter );
+        } else {
+            ++iter;
+        }
+    }
+
+    if( get_option<bool>( "LIGHTMAP_CROSS_CHECK" ) ) {
+        const level_cache &map_cache = get_cache_ref( zlev );
+        const size_t tiles = MAPSIZE_X * MAPSIZE_Y;
+        const std::vector<four_quadrants> reused_lm( &map_cache.lm[0][0], &map_cache.lm[0][0] + tiles );
+        const std::vector<float> reused_sm( &map_cache.sm[0][0], &map_cache.sm[0][0] + tiles );
+        build_lightmap( zlev );
+        const bool same_lm = std::equal( reused_lm.begin(), reused_lm.end(), &map_cache.lm[0][0],
+        []( const four_quadrants & l, const four_quadrants & r ) {
+            return l.values == r.values;
+        } );
+        const bool same_sm = std::equal( reused_sm.begin(), reused_sm.end(), &map_cache.sm[0][0] );
+        if( !same_lm || !same_sm ) {
+            debugmsg( "Incremental lightmap of z-level %d differs from a full rebuild.", zlev );
+        }
+    }
+}
+
+void map::build_lightmap( const int zlev )
+{
     auto &map_cache = get_cache( zlev );
     auto &lm = map_cache.lm;
     auto &sm = map_cache.sm;
@@ -1749,185 +1860,114 @@ static float light_from_lookup( const float &numerator, const float &transparenc
     return numerator *  transparency  / distance ;
 }
 
-void map::apply_light_source( const tripoint &p, float luminance )
-{
-    auto &cache = get_cache( p.z );
-    four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = cache.lm;
-    float ( &sm )[MAPSIZE_X][MAPSIZE_Y] = cache.sm;
-    float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.transparency_cache;
-    float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y] = cache.light_source_buffer;
-    diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.vehicle_obscured_cache;
-
-    const point p2( p.xy() );
+// Scratch lightmap of the cast in progress and the tiles it wrote to, see map::apply_light_contribution.
+static four_quadrants *tracked_light_base = nullptr;
+static std::vector<int> *tracked_light_tiles = nullptr;
 
-    if( inbounds( p ) ) {
-        const float min_light = std::max( static_cast<float>( lit_level::LOW ), luminance );
-        lm[p2.x][p2.y] = elementwise_max( lm[p2.x][p2.y], min_light );
-        sm[p2.x][p2.y] = std::max( sm[p2.x][p2.y], luminance );
-    }
-    if( luminance <= lit_level::LOW ) {
-        return;
-    } else if( luminance <= lit_level::BRIGHT_ONLY ) {
-        luminance = 1.49f;
+static void update_light_quadrants_tracked( four_quadrants &update, const float &new_value,
+        quadrant q )
+{
+    if( new_value > 0.0f && update.max() == 0.0f ) {
+        tracked_light_tiles->push_back( static_cast<int>( &update - tracked_light_base ) );
     }
+    update_light_quadrants( update, new_value, q );
+}
 
-    /* If we're a 5 luminance fire , we skip casting rays into ey && sx if we have
-         neighboring fires to the north and west that were applied via light_source_buffer
-       If there's a 1 luminance candle east in buffer, we still cast rays into ex since it's smaller
-       If there's a 100 luminance magnesium flare south added via apply_light_source instead od
-         add_light_source, it's unbuffered so we'll still cast rays into sy.
+using light_update_fn = void( * )( four_quadrants &, const float &, quadrant );
 
-          ey
-        nnnNnnn
-        w     e
-        w  5 +e
-     sx W 5*1+E ex
-        w ++++e
-        w+++++e
-        sssSsss
-           sy
-    */
-    const int peer_inbounds = LIGHTMAP_CACHE_X - 1;
-    bool north = ( p2.y != 0 && light_source_buffer[p2.x][p2.y - 1] < luminance );
-    bool south = ( p2.y != peer_inbounds && light_source_buffer[p2.x][p2.y + 1] < luminance );
-    bool east = ( p2.x != peer_inbounds && light_source_buffer[p2.x + 1][p2.y] < luminance );
-    bool west = ( p2.x != 0 && light_source_buffer[p2.x - 1][p2.y] < luminance );
+// Bits of the directions a point light source is cast into.
+static constexpr int light_north = 1;
+static constexpr int light_east = 2;
+static constexpr int light_south = 4;
+static constexpr int light_west = 8;
+
+template<light_update_fn update>
+static void cast_light_source( four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y],
+                               const level_cache &cache, point p2, float luminance, int directions )
+{
+    const auto &transparency_cache = cache.transparency_cache;
+    const auto &blocked_cache = cache.vehicle_obscured_cache;
 
-    if( north ) {
+    if( directions & light_north ) {
         castLightWithLookup < 1, 0, 0, -1, float, four_quadrants, light_calc, light_check,
-                            update_light_quadrants, accumulate_transparency, light_from_lookup > (
+                            update, accumulate_transparency, light_from_lookup > (
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
         castLightWithLookup < -1, 0, 0, -1, float, four_quadrants, light_calc, light_check,
-                            update_light_quadrants, accumulate_transparency, light_from_lookup > (
+                            update, accumulate_transparency, light_from_lookup > (
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
     }
 
-    if( east ) {
+    if( directions & light_east ) {
         castLightWithLookup < 0, -1, 1, 0, float, four_quadrants, light_calc, light_check,
-                            update_light_quadrants, accumulate_transparency, light_from_lookup > (
+                            update, accumulate_transparency, light_from_lookup > (
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
         castLightWithLookup < 0, -1, -1, 0, float, four_quadrants, light_calc, light_check,
-                            update_light_quadrants, accumulate_transparency, light_from_lookup > (
+                            update, accumulate_transparency, light_from_lookup > (
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
     }
 
-    if( south ) {
+    if( directions & light_south ) {
         castLightWithLookup<1, 0, 0, 1, float, four_quadrants, light_calc, light_check,
-                            update_light_quadrants, accumulate_transparency, light_from_lookup>(
+                            update, accumulate_transparency, light_from_lookup>(
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
         castLightWithLookup < -1, 0, 0, 1, float, four_quadrants, light_calc, light_check,
-                            update_light_quadrants, accumulate_transparency, light_from_lookup > (
+                            update, accumulate_transparency, light_from_lookup > (
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
     }
 
-    if( west ) {
+    if( directions & light_west ) {
         castLightWithLookup<0, 1, 1, 0, float, four_quadrants, light_calc, light_check,
-                            update_light_quadrants, accumulate_transparency, light_from_lookup>(
+                            update, accumulate_transparency, light_from_lookup>(
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
         castLightWithLookup < 0, 1, -1, 0, float, four_quadrants, light_calc, light_check,
-                            update_light_quadrants, accumulate_transparency, light_from_lookup > (
+                            update, accumulate_transparency, light_from_lookup > (
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
     }
 }
 
-void map::apply_directional_light( const tripoint &p, int direction, float luminance )
+template<light_update_fn update>
+static void cast_directional_light( four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y],
+                                    const level_cache &cache, point p2, int direction, float luminance )
 {
-    const point p2( p.xy() );
-
-    auto &cache = get_cache( p.z );
-    four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = cache.lm;
-    float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.transparency_cache;
-    diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.vehicle_obscured_cache;
+    const auto &transparency_cache = cache.transparency_cache;
+    const auto &blocked_cache = cache.vehicle_obscured_cache;
 
     if( direction == 90 ) {
         castLightWithLookup < 1, 0, 0, -1, float, four_quadrants, light_calc, light_check,
-                            update_light_quadrants, accumulate_transparency, light_from_lookup > (
+                            update, accumulate_transparency, light_from_lookup > (
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
         castLightWithLookup < -1, 0, 0, -1, float, four_quadrants, light_calc, light_check,
-                            update_light_quadrants, accumulate_transparency, light_from_lookup > (
+                            update, accumulate_transparency, light_from_lookup > (
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
     } else if( direction == 0 ) {
         castLightWithLookup < 0, -1, 1, 0, float, four_quadrants, light_calc, light_check,
-                            update_light_quadrants, accumulate_transparency, light_from_lookup > (
+                            update, accumulate_transparency, light_from_lookup > (
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
         castLightWithLookup < 0, -1, -1, 0, float, four_quadrants, light_calc, light_check,
-                            update_light_quadrants, accumulate_transparency, light_from_lookup > (
+                            update, accumulate_transparency, light_from_lookup > (
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
     } else if( direction == 270 ) {
         castLightWithLookup<1, 0, 0, 1, float, four_quadrants, light_calc, light_check,
-                            update_light_quadrants, accumulate_transparency, light_from_lookup>(
+                            update, accumulate_transparency, light_from_lookup>(
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
         castLightWithLookup < -1, 0, 0, 1, float, four_quadrants, light_calc, light_check,
-                            update_light_quadrants, accumulate_transparency, light_from_lookup > (
+                            update, accumulate_transparency, light_from_lookup > (
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
     } else if( direction == 180 ) {
         castLightWithLookup<0, 1, 1, 0, float, four_quadrants, light_calc, light_check,
-                            update_light_quadrants, accumulate_transparency, light_from_lookup>(
+                            update, accumulate_transparency, light_from_lookup>(
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
         castLightWithLookup < 0, 1, -1, 0, float, four_quadrants, light_calc, light_check,
-                            update_light_quadrants, accumulate_transparency, light_from_lookup > (
+                            update, accumulate_transparency, light_from_lookup > (
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
     }
 }
 
-void map::apply_light_arc( const tripoint &p, units::angle angle, float luminance,
-                           units::angle wideangle )
-{
-    if( luminance <= LIGHT_SOURCE_LOCAL ) {
-        return;
-    }
-
-    bool lit[LIGHTMAP_CACHE_X][LIGHTMAP_CACHE_Y] {};
-
-    apply_light_source( p, LIGHT_SOURCE_LOCAL );
-
-    // Normalize (should work with negative values too)
-    const units::angle wangle = wideangle / 2.0;
-
-    units::angle nangle = fmod( angle, 360_degrees );
-
-    tripoint end;
-    int range = LIGHT_RANGE( luminance );
-    calc_ray_end( nangle, range, p, end );
-    apply_light_ray( lit, p, end, luminance );
-
-    tripoint test;
-    calc_ray_end( wangle + nangle, range, p, test );
-
-    const float wdist = hypot( end.x - test.x, end.y - test.y );
-    if( wdist <= 0.5 ) {
-        return;
-    }
-
-    // attempt to determine beam intensity required to cover all squares
-    const units::angle wstep = ( wangle / ( wdist * M_SQRT2 ) );
-
-    // NOLINTNEXTLINE(clang-analyzer-security.FloatLoopCounter)
-    for( units::angle ao = wstep; ao <= wangle; ao += wstep ) {
-        if( trigdist ) {
-            double fdist = ( ao * M_PI_2 ) / wangle;
-            end.x = static_cast<int>(
-                        p.x + ( static_cast<double>( range ) - fdist * 2.0 ) * cos( nangle + ao ) );
-            end.y = static_cast<int>(
-                        p.y + ( static_cast<double>( range ) - fdist * 2.0 ) * sin( nangle + ao ) );
-            apply_light_ray( lit, p, end, luminance );
-
-            end.x = static_cast<int>(
-                        p.x + ( static_cast<double>( range ) - fdist * 2.0 ) * cos( nangle - ao ) );
-            end.y = static_cast<int>(
-                        p.y + ( static_cast<double>( range ) - fdist * 2.0 ) * sin( nangle - ao ) );
-            apply_light_ray( lit, p, end, luminance );
-        } else {
-            calc_ray_end( nangle + ao, range, p, end );
-            apply_light_ray( lit, p, end, luminance );
-            calc_ray_end( nangle - ao, range, p, end );
-            apply_light_ray( lit, p, end, luminance );
-        }
-    }
-}
-
-void map::apply_light_ray( bool lit[LIGHTMAP_CACHE_X][LIGHTMAP_CACHE_Y],
-                           const tripoint &s, const tripoint &e, float luminance )
+template<light_update_fn update>
+static void cast_light_ray( four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y],
+                            const float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y],
+                            bool lit[LIGHTMAP_CACHE_X][LIGHTMAP_CACHE_Y],
+                            const tripoint &s, const tripoint &e, float luminance )
 {
     point a( std::abs( e.x - s.x ) * 2, std::abs( e.y - s.y ) * 2 );
     point d( ( s.x < e.x ) ? 1 : -1, ( s.y < e.y ) ? 1 : -1 );
@@ -1940,9 +1980,6 @@ void map::apply_light_ray( bool lit[LIGHTMAP_CACHE_X][LIGHTMAP_CACHE_Y],
         return;
     }
 
-    auto &lm = get_cache( s.z ).lm;
-    auto &transparency_cache = get_cache( s.z ).transparency_cache;
-
     float distance = 1.0;
     float transparency = LIGHT_TRANSPARENCY_OPEN_AIR;
     const float scaling_factor = static_cast<float>( rl_dist( s, e ) ) /
@@ -1968,7 +2005,7 @@ void map::apply_light_ray( bool lit[LIGHTMAP_CACHE_X][LIGHTMAP_CACHE_Y],
                     lit[p.x][p.y] = true;
                     float lm_val = luminance / ( fastexp( transparency * distance ) * distance );
                     quadrant q = is_opaque ? quad : quadrant::default_;
-                    lm[p.x][p.y][q] = std::max( lm[p.x][p.y][q], lm_val );
+                    update( lm[p.x][p.y], lm_val, q );
                 }
                 if( is_opaque ) {
                     break;
@@ -2000,7 +2037,7 @@ void map::apply_light_ray( bool lit[LIGHTMAP_CACHE_X][LIGHTMAP_CACHE_Y],
                     lit[p.x][p.y] = true;
                     float lm_val = luminance / ( fastexp( transparency * distance ) * distance );
                     quadrant q = is_opaque ? quad : quadrant::default_;
-                    lm[p.x][p.y][q] = std::max( lm[p.x][p.y][q], lm_val );
+                    update( lm[p.x][p.y], lm_val, q );
                 }
                 if( is_opaque ) {
                     break;
@@ -2015,3 +2052,217 @@ void map::apply_light_ray( bool lit[LIGHTMAP_CACHE_X][LIGHTMAP_CACHE_Y],
         } while( !( p.x == e.x && p.y == e.y ) );
     }
 }
+
+template<light_update_fn update>
+static void cast_light_arc( four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y],
+                            const level_cache &cache, const tripoint &p, units::angle angle,
+                            float luminance, units::angle wideangle )
+{
+    const auto &transparency_cache = cache.transparency_cache;
+    bool lit[LIGHTMAP_CACHE_X][LIGHTMAP_CACHE_Y] {};
+
+    // Normalize (should work with negative values too)
+    const units::angle wangle = wideangle / 2.0;
+
+    units::angle nangle = fmod( angle, 360_degrees );
+
+    tripoint end;
+    int range = LIGHT_RANGE( luminance );
+    calc_ray_end( nangle, range, p, end );
+    cast_light_ray<update>( lm, transparency_cache, lit, p, end, luminance );
+
+    tripoint test;
+    calc_ray_end( wangle + nangle, range, p, test );
+
+    const float wdist = hypot( end.x - test.x, end.y - test.y );
+    if( wdist <= 0.5 ) {
+        return;
+    }
+
+    // attempt to determine beam intensity required to cover all squares
+    const units::angle wstep = ( wangle / ( wdist * M_SQRT2 ) );
+
+    // NOLINTNEXTLINE(clang-analyzer-security.FloatLoopCounter)
+    for( units::angle ao = wstep; ao <= wangle; ao += wstep ) {
+        if( trigdist ) {
+            double fdist = ( ao * M_PI_2 ) / wangle;
+            end.x = static_cast<int>(
+                        p.x + ( static_cast<double>( range ) - fdist * 2.0 ) * cos( nangle + ao ) );
+            end.y = static_cast<int>(
+                        p.y + ( static_cast<double>( range ) - fdist * 2.0 ) * sin( nangle + ao ) );
+            cast_light_ray<update>( lm, transparency_cache, lit, p, end, luminance );
+
+            end.x = static_cast<int>(
+                        p.x + ( static_cast<double>( range ) - fdist * 2.0 ) * cos( nangle - ao ) );
+            end.y = static_cast<int>(
+                        p.y + ( static_cast<double>( range ) - fdist * 2.0 ) * sin( nangle - ao ) );
+            cast_light_ray<update>( lm, transparency_cache, lit, p, end, luminance );
+        } else {
+            calc_ray_end( nangle + ao, range, p, end );
+            cast_light_ray<update>( lm, transparency_cache, lit, p, end, luminance );
+            calc_ray_end( nangle - ao, range, p, end );
+            cast_light_ray<update>( lm, transparency_cache, lit, p, end, luminance );
+        }
+    }
+}
+
+void map::apply_light_contribution( const int zlev, const light_source_key &key,
+                                    const std::function<void( four_quadrants( & )[MAPSIZE_X][MAPSIZE_Y], bool )> &cast )
+{
+    level_cache &map_cache = get_cache( zlev );
+    if( active_light_sources == nullptr || active_light_sources_z != zlev ) {
+        cast( map_cache.lm, false );
+        return;
+    }
+    light_source_cache &sources = *active_light_sources;
+
+    auto iter = sources.contributions.find( key );
+    if( iter == sources.contributions.end() ) {
+        // Cast into the empty scratch map, so exactly the tiles this source lit are written.
+        sources.touched.clear();
+        tracked_light_base = &sources.scratch[0][0];
+        tracked_light_tiles = &sources.touched;
+        cast( sources.scratch, true );
+        tracked_light_base = nullptr;
+        tracked_light_tiles = nullptr;
+
+        light_contribution contribution;
+        contribution.tiles.reserve( sources.touched.size() );
+        int radius = 0;
+        constexpr four_quadrants four_zeros( 0.0f );
+        for( const int index : sources.touched ) {
+            const point t( index / MAPSIZE_Y, index % MAPSIZE_Y );
+            four_quadrants &lit = sources.scratch[t.x][t.y];
+            contribution.tiles.emplace_back( t, lit );
+            lit = four_zeros;
+            radius = std::max( radius, square_dist( t, key.pos ) );
+        }
+        // Casts only read the transparency of tiles they lit and of the first row around the
+        // source, whatever they hit, so that is all a contribution depends on.
+        radius++;
+        const point sm_min = ms_to_sm_copy( point( std::max( key.pos.x - radius, 0 ),
+                                            std::max( key.pos.y - radius, 0 ) ) );
+        const point sm_max = ms_to_sm_copy( point( std::min( key.pos.x + radius, MAPSIZE_X - 1 ),
+                                            std::min( key.pos.y + radius, MAPSIZE_Y - 1 ) ) );
+        for( int smx = sm_min.x; smx <= sm_max.x; smx++ ) {
+            for( int smy = sm_min.y; smy <= sm_max.y; smy++ ) {
+                contribution.reach.set( smx * MAPSIZE + smy );
+            }
+        }
+        iter = sources.contributions.emplace( key, std::move( contribution ) ).first;
+        sources.cast_count++;
+    } else {
+        sources.reused_count++;
+    }
+
+    light_contribution &contribution = iter->second;
+    contribution.last_used = sources.generation;
+    auto &lm = map_cache.lm;
+    for( const std::pair<point, four_quadrants> &elem : contribution.tiles ) {
+        four_quadrants &lit = lm[elem.first.x][elem.first.y];
+        lit = elementwise_max( lit, elem.second );
+    }
+}
+
+void map::apply_light_source( const tripoint &p, float luminance )
+{
+    auto &cache = get_cache( p.z );
+    four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = cache.lm;
+    float ( &sm )[MAPSIZE_X][MAPSIZE_Y] = cache.sm;
+    float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y] = cache.light_source_buffer;
+
+    const point p2( p.xy() );
+
+    if( inbounds( p ) ) {
+        const float min_light = std::max( static_cast<float>( lit_level::LOW ), luminance );
+        lm[p2.x][p2.y] = elementwise_max( lm[p2.x][p2.y], min_light );
+        sm[p2.x][p2.y] = std::max( sm[p2.x][p2.y], luminance );
+    }
+    if( luminance <= lit_level::LOW ) {
+        return;
+    } else if( luminance <= lit_level::BRIGHT_ONLY ) {
+        luminance = 1.49f;
+    }
+
+    /* If we're a 5 luminance fire , we skip casting rays into ey && sx if we have
+         neighboring fires to the north and west that were applied via light_source_buffer
+       If there's a 1 luminance candle east in buffer, we still cast rays into ex since it's smaller
+       If there's a 100 luminance magnesium flare south added via apply_light_source instead od
+         add_light_source, it's unbuffered so we'll still cast rays into sy.
+
+          ey
+        nnnNnnn
+        w     e
+        w  5 +e
+     sx W 5*1+E ex
+        w ++++e
+        w+++++e
+        sssSsss
+           sy
+    */
+    const int peer_inbounds = LIGHTMAP_CACHE_X - 1;
+    int directions = 0;
+    if( p2.y != 0 && light_source_buffer[p2.x][p2.y - 1] < luminance ) {
+        directions |= light_north;
+    }
+    if( p2.y != peer_inbounds && light_source_buffer[p2.x][p2.y + 1] < luminance ) {
+        directions |= light_south;
+    }
+    if( p2.x != peer_inbounds && light_source_buffer[p2.x + 1][p2.y] < luminance ) {
+        directions |= light_east;
+    }
+    if( p2.x != 0 && light_source_buffer[p2.x - 1][p2.y] < luminance ) {
+        directions |= light_west;
+    }
+    if( directions == 0 ) {
+        return;
+    }
+
+    const light_source_key key{ light_cast::point, p2, luminance, 0.0, 0.0, directions };
+    apply_light_contribution( p.z, key, [&]( four_quadrants( &out )[MAPSIZE_X][MAPSIZE_Y],
+    bool tracked ) {
+        if( tracked ) {
+            cast_light_source<update_light_quadrants_tracked>( out, cache, p2, luminance, directions );
+        } else {
+            cast_light_source<update_light_quadrants>( out, cache, p2, luminance, directions );
+        }
+    } );
+}
+
+void map::apply_directional_light( const tripoint &p, int direction, float luminance )
+{
+    const point p2( p.xy() );
+    const level_cache &cache = get_cache_ref( p.z );
+
+    const light_source_key key{ light_cast::directional, p2, luminance, 0.0, 0.0, direction };
+    apply_light_contribution( p.z, key, [&]( four_quadrants( &out )[MAPSIZE_X][MAPSIZE_Y],
+    bool tracked ) {
+        if( tracked ) {
+            cast_directional_light<update_light_quadrants_tracked>( out, cache, p2, direction, luminance );
+        } else {
+            cast_directional_light<update_light_quadrants>( out, cache, p2, direction, luminance );
+        }
+    } );
+}
+
+void map::apply_light_arc( const tripoint &p, units::angle angle, float luminance,
+                           units::angle wideangle )
+{
+    if( luminance <= LIGHT_SOURCE_LOCAL ) {
+        return;
+    }
+
+    apply_light_source( p, LIGHT_SOURCE_LOCAL );
+
+    const level_cache &cache = get_cache_ref( p.z );
+    const light_source_key key{ light_cast::arc, p.xy(), luminance, units::to_radians( angle ),
+                                units::to_radians( wideangle ), 0 };
+    apply_light_contribution( p.z, key, [&]( four_quadrants( &out )[MAPSIZE_X][MAPSIZE_Y],
+    bool tracked ) {
+        if( tracked ) {
+            cast_light_arc<update_light_quadrants_tracked>( out, cache, p, angle, luminance, wideangle );
+        } else {
+            cast_light_arc<update_light_quadrants>( out, cache, p, angle, luminance, wideangle );
+        }
+    } );
+}
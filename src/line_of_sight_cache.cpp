@@ -0,0 +1,84 @@
+#include "line_of_sight_cache.h"
+
+#include <algorithm>
+
+namespace
+{
+
+bool in_bubble( const tripoint &p )
+{
+    return p.x >= 0 && p.x < MAPSIZE_X && p.y >= 0 && p.y < MAPSIZE_Y &&
+           p.z >= -OVERMAP_DEPTH && p.z <= OVERMAP_HEIGHT;
+}
+
+struct cache_slot {
+    uint32_t bitmap_key;
+    size_t bit;
+};
+
+// Where the result for a pair is kept, if it can be cached at all.
+std::optional<cache_slot> slot_of( const tripoint &a, const tripoint &b )
+{
+    if( !in_bubble( a ) || !in_bubble( b ) ) {
+        return std::nullopt;
+    }
+    const tripoint &origin = a < b ? a : b;
+    const tripoint &target = a < b ? b : a;
+    const uint32_t origin_index = ( origin.x * MAPSIZE_Y + origin.y ) * OVERMAP_LAYERS +
+                                  origin.z + OVERMAP_DEPTH;
+    return cache_slot{
+        origin_index * OVERMAP_LAYERS + target.z + OVERMAP_DEPTH,
+        static_cast<size_t>( target.x * MAPSIZE_Y + target.y ) * 2
+    };
+}
+
+} // namespace
+
+std::optional<bool> line_of_sight_cache::get( const tripoint &a, const tripoint &b ) const
+{
+    const std::optional<cache_slot> slot = slot_of( a, b );
+    if( !slot ) {
+        return std::nullopt;
+    }
+    const auto iter = bitmap_of.find( slot->bitmap_key );
+    if( iter == bitmap_of.end() ) {
+        return std::nullopt;
+    }
+    const uint64_t word = words[iter->second * words_per_bitmap + slot->bit / 64];
+    const uint64_t bits = word >> ( slot->bit % 64 );
+    if( !( bits & 1 ) ) {
+        return std::nullopt;
+    }
+    return ( bits & 2 ) != 0;
+}
+
+void line_of_sight_cache::set( const tripoint &a, const tripoint &b, const bool visible )
+{
+    const std::optional<cache_slot> slot = slot_of( a, b );
+    if( !slot ) {
+        return;
+    }
+    auto iter = bitmap_of.find( slot->bitmap_key );
+    if( iter == bitmap_of.end() ) {
+        if( used_bitmaps == max_bitmaps ) {
+            clear();
+        }
+        const size_t first_word = used_bitmaps * words_per_bitmap;
+        if( words.size() < first_word + words_per_bitmap ) {
+            words.resize( first_word + words_per_bitmap );
+        } else {
+            std::fill_n( words.begin() + first_word, words_per_bitmap, 0 );
+        }
+        iter = bitmap_of.emplace( slot->bitmap_key, static_cast<uint32_t>( used_bitmaps++ ) ).first;
+    }
+    uint64_t &word = words[iter->second * words_per_bitmap + slot->bit / 64];
+    const int shift = slot->bit % 64;
+    word &= ~( uint64_t( 3 ) << shift );
+    word |= uint64_t( visible ? 3 : 1 ) << shift;
+}
+
+void line_of_sight_cache::clear()
+{
+    bitmap_of.clear();
+    used_bitmaps = 0;
+}
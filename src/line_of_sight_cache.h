@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "game_constants.h"
+#include "point.h"
+
+/**
+ * Results of line of sight checks between points of the reality bubble.
+ *
+ * Lines of sight are symmetric, so a pair is stored once, under the lesser of its points.
+ * Each such origin gets a flat bitmap of the map for every z-level it looked at, holding
+ * two bits (checked, visible) per target, so a lookup is a single hash lookup and bit test.
+ * Pairs with a point outside the reality bubble aren't cached.
+ */
+class line_of_sight_cache
+{
+    public:
+        /** Returns the stored result for the pair, or nothing if it hasn't been stored. */
+        std::optional<bool> get( const tripoint &a, const tripoint &b ) const;
+        void set( const tripoint &a, const tripoint &b, bool visible );
+        void clear();
+
+    private:
+        static constexpr size_t words_per_bitmap = ( MAPSIZE_X * MAPSIZE_Y * 2 + 63 ) / 64;
+        /** Everything is dropped once this many bitmaps (about 4 KiB each) are in use. */
+        static constexpr size_t max_bitmaps = 1024;
+
+        /** Bitmap index by origin and target z-level. */
+        std::unordered_map<uint32_t, uint32_t> bitmap_of;
+        /** All bitmaps, @ref words_per_bitmap words each. Kept allocated across @ref clear. */
+        std::vector<uint64_t> words;
+        size_t used_bitmaps = 0;
+};
@@ -29,6 +29,7 @@ noexcept
     }
 
     contents = std::move( source.contents );
+    loc->on_items_changed();
     return *this;
 };
 
@@ -161,7 +162,8 @@ void location_vector<T>::push_back( detached_ptr<T> &&obj )
     T *raw = obj.release();
 
     //Skip adding it if it's already here
-    if( &*loc != raw->saved_loc ) {
+    const bool is_added = &*loc != raw->saved_loc;
+    if( is_added ) {
         raw->resolve_saved_loc();
         contents.push_back( raw );
         if( destroyed ) {
@@ -171,6 +173,11 @@ void location_vector<T>::push_back( detached_ptr<T> &&obj )
         raw->saved_loc = nullptr;
     }
     raw->set_location( &*loc );
+    if( is_added && !destroyed ) {
+        loc->on_item_added( *raw );
+    } else {
+        loc->on_items_changed();
+    }
 }
 
 template<typename T>
@@ -232,6 +239,7 @@ typename location_vector<T>::iterator location_vector<T>::erase( typename
     T *subject = *it;
     typename std::vector<T *>::iterator ret = contents.erase( it.it );
     subject->remove_location();
+    loc->on_item_removed( *subject );
 
     detached_ptr<T> local;
     detached_ptr<T> *used = out ? out : &local;
@@ -255,6 +263,9 @@ typename location_vector<T>::iterator location_vector<T>::insert( typename
         raw->set_location( &*loc );
         if( destroyed ) {
             raw->destroy_in_place();
+            loc->on_items_changed();
+        } else {
+            loc->on_item_added( *raw );
         }
         return location_vector<T>::iterator( contents.insert( it.it, raw ), *this );
     } else {
@@ -288,6 +299,7 @@ typename location_vector<T>::iterator location_vector<T>::insert( typename
             raw->set_location( &*loc );
         }
     }
+    loc->on_items_changed();
     return it;
 }
 
@@ -398,6 +410,7 @@ typename std::vector<detached_ptr<T>> location_vector<T>::clear()
         ret.push_back( detached_ptr( i ) );
     }
     contents.clear();
+    loc->on_items_changed();
     return ret;
 }
 
@@ -438,6 +451,7 @@ void location_vector<T>::remove_with( std::function < detached_ptr<T>( detached_
             }
         }
     }
+    loc->on_items_changed();
 }
 
 template<typename T>
@@ -486,6 +500,8 @@ noexcept
         it->set_location( &*lhs.loc );
     }
     std::swap( lhs.contents, rhs.contents );
+    lhs.loc->on_items_changed();
+    rhs.loc->on_items_changed();
 }
 
 template
@@ -4,10 +4,12 @@
 #include "coordinates.h"
 #include "detached_ptr.h"
 #include "item.h"
+#include "item_summary.h"
 #include "itype.h"
 #include "iuse_actor.h"
 #include "location_ptr.h"
 #include "map.h"
+#include "mapbuffer.h"
 #include "monster.h"
 #include "npc.h"
 #include "player.h"
@@ -33,6 +35,39 @@ const item *cost_split_helper( const item *it, int qty )
 
 } // namespace
 
+item_pile_location::item_pile_location() = default;
+
+item_pile_location::~item_pile_location() = default;
+
+void item_pile_location::on_items_changed()
+{
+    summary.reset();
+    on_pile_changed();
+}
+
+void item_pile_location::on_item_added( const item &it )
+{
+    if( summary ) {
+        summary->add( it );
+    }
+    on_pile_changed();
+}
+
+void item_pile_location::on_item_removed( const item &it )
+{
+    if( summary ) {
+        summary->remove( it );
+    }
+    on_pile_changed();
+}
+
+const item_summary &item_pile_location::get_summary( const std::vector<item *> &items ) const
+{
+    if( !summary ) {
+        summary = std::make_unique<item_summary>( item_summary::summarize( items ) );
+    }
+    return *summary;
+}
 
 detached_ptr<item> fake_item_location::detach( item * )
 {
@@ -292,6 +327,15 @@ std::string tile_item_location::describe( const Character *ch, const item * ) co
     return res;
 }
 
+void tile_item_location::on_pile_changed()
+{
+    const tripoint sm_pos = ms_to_sm_copy( pos );
+    // Only already buffered submaps; this must never load one from disk
+    if( MAPBUFFER.is_submap_loaded( sm_pos ) ) {
+        MAPBUFFER.lookup_submap( sm_pos )->mark_modified();
+    }
+}
+
 void tile_item_location::move_by( tripoint offset )
 {
     pos += offset;
@@ -494,6 +538,11 @@ bool contents_item_location::is_loaded( const item * ) const
     return container->is_loaded();
 }
 
+void contents_item_location::on_items_changed()
+{
+    container->notify_location();
+}
+
 void contents_item_location::on_changed( const item * ) const
 {
     return container->on_contents_changed();
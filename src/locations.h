@@ -1,5 +1,8 @@
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "point.h"
 #include "type_id.h"
 
@@ -10,6 +13,7 @@ class Creature;
 class submap;
 class vehicle;
 class monster;
+struct item_summary;
 class npc;
 struct tripoint;
 template<typename T>
@@ -24,6 +28,16 @@ class location
         virtual bool is_loaded( const T *obj ) const = 0;
         virtual tripoint position( const T *obj ) const = 0;
         virtual std::string describe( const Character *ch, const T *obj ) const = 0;
+        /** Called after objects were added here or removed, or changed while here. */
+        virtual void on_items_changed() {}
+        /** Called after @p obj alone was added here, instead of @ref on_items_changed. */
+        virtual void on_item_added( const T & ) {
+            on_items_changed();
+        }
+        /** Called after @p obj alone was removed from here, instead of @ref on_items_changed. */
+        virtual void on_item_removed( const T & ) {
+            on_items_changed();
+        }
         virtual ~location() = default;
 };
 
@@ -34,6 +48,27 @@ class item_location : public location<item>
         virtual int obtain_cost( const Character &ch, int qty, const item *it ) const = 0;
 };
 
+/**
+ * A pile of items that crafting looks through often, keeps an @ref item_summary of
+ * itself until the pile changes.
+ */
+class item_pile_location : public item_location
+{
+    private:
+        mutable std::unique_ptr<item_summary> summary;
+    public:
+        item_pile_location();
+        ~item_pile_location() override;
+        void on_items_changed() override;
+        void on_item_added( const item &it ) override;
+        void on_item_removed( const item &it ) override;
+        /** Summary of @p items, which must be the items held here. */
+        const item_summary &get_summary( const std::vector<item *> &items ) const;
+    protected:
+        /** Called after any change to the pile, once the summary is up to date. */
+        virtual void on_pile_changed() {}
+};
+
 class character_item_location : public item_location
 {
     protected:
@@ -83,7 +118,7 @@ class worn_item_location :  public character_item_location
         std::string describe( const Character *ch, const item *it ) const override;
 };
 
-class tile_item_location : public item_location
+class tile_item_location : public item_pile_location
 {
     protected:
         tripoint pos;//abs coords
@@ -97,6 +132,9 @@ class tile_item_location : public item_location
         int obtain_cost( const Character &ch, int qty, const item *it ) const override;
         std::string describe( const Character *ch, const item *it ) const override;
         void move_by( tripoint offset );
+    protected:
+        /** Marks the owning submap as needing a save. */
+        void on_pile_changed() override;
 };
 
 class partial_con_item_location : public tile_item_location
@@ -167,7 +205,7 @@ class monster_battery_item_location :  public monster_item_location
         void attach( detached_ptr<item> &&obj ) override;
 };
 
-class vehicle_item_location : public item_location
+class vehicle_item_location : public item_pile_location
 {
     protected:
         vehicle *veh;
@@ -206,6 +244,7 @@ class contents_item_location :  public item_location
         item_location_type where() const override;
         int obtain_cost( const Character &ch, int qty, const item *it ) const override;
         std::string describe( const Character *ch, const item *it ) const override;
+        void on_items_changed() override;
         void on_changed( const item *it ) const;
 
         item *parent() const;
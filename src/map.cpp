@@ -53,6 +53,7 @@
 #include "item_contents.h"
 #include "item_factory.h"
 #include "item_group.h"
+#include "item_summary.h"
 #include "itype.h"
 #include "iuse.h"
 #include "iuse_actor.h"
@@ -75,6 +76,8 @@
 #include "output.h"
 #include "overmapbuffer.h"
 #include "legacy_pathfinding.h"
+#include "pathfinding.h"
+#include "perf_telemetry.h"
 #include "player.h"
 #include "point_float.h"
 #include "projectile.h"
@@ -355,6 +358,7 @@ void map::add_vehicle_to_cache( vehicle *veh )
         if( inbounds( p ) ) {
             ch.veh_exists_at[p.x][p.y] = true;
         }
+        set_pathfinding_cache_dirty( p );
     }
 
     last_full_vehicle_list_dirty = true;
@@ -375,7 +379,7 @@ void map::clear_vehicle_point_from_cache( vehicle *veh, const tripoint &pt )
     if( it != ch.veh_cached_parts.end() && it->second.first == veh ) {
         ch.veh_cached_parts.erase( it );
     }
-
+    set_pathfinding_cache_dirty( pt );
 }
 
 void map::clear_vehicle_cache( )
@@ -451,6 +455,7 @@ std::unique_ptr<vehicle> map::detach_vehicle( vehicle *veh )
             reset_vehicle_cache( );
             std::unique_ptr<vehicle> result = std::move( current_submap->vehicles[i] );
             current_submap->vehicles.erase( current_submap->vehicles.begin() + i );
+            current_submap->mark_modified();
             if( veh->tracking_on ) {
                 overmap_buffer.remove_vehicle( veh );
             }
@@ -484,6 +489,7 @@ void map::on_vehicle_moved( const int smz )
 void map::vehmove()
 {
     ZoneScoped;
+    telemetry::scoped_timer timer( telemetry::phase::vehmove );
 
     // give vehicles movement points
     VehicleList vehicle_list;
@@ -1335,7 +1341,9 @@ bool map::displace_vehicle( vehicle &veh, const tripoint &dp )
         auto src_submap_veh_it = src_submap->vehicles.begin() + our_i;
         dst_submap->vehicles.push_back( std::move( *src_submap_veh_it ) );
         src_submap->vehicles.erase( src_submap_veh_it );
+        src_submap->mark_modified();
         dst_submap->is_uniform = false;
+        dst_submap->mark_modified();
         invalidate_max_populated_zlev( dst.z );
     }
     if( need_update ) {
@@ -1476,6 +1484,11 @@ void map::furn_set( const tripoint &p, const furn_id &new_furniture,
         return;
     }
 
+    if( old_id->has_flag( TFLAG_FRIDGE ) != new_furniture->has_flag( TFLAG_FRIDGE ) ||
+        old_id->has_flag( TFLAG_FREEZER ) != new_furniture->has_flag( TFLAG_FREEZER ) ) {
+        // Perishables asleep here rotted at the old temperature until now
+        wake_items( p );
+    }
     current_submap->set_furn( l, new_furniture );
 
     // Set the dirty flags
@@ -1504,6 +1517,10 @@ void map::furn_set( const tripoint &p, const furn_id &new_furniture,
 
     if( old_t.has_flag( TFLAG_INDOORS ) != new_t.has_flag( TFLAG_INDOORS ) ) {
         set_outside_cache_dirty( p.z );
+        // Doors that only open from inside check `is_outside`, which spills one tile around
+        for( const tripoint &near : points_in_radius( p, 1 ) ) {
+            set_pathfinding_cache_dirty( near );
+        }
     }
 
     if( old_t.has_flag( TFLAG_NO_FLOOR ) != new_t.has_flag( TFLAG_NO_FLOOR ) ) {
@@ -1520,7 +1537,7 @@ void map::furn_set( const tripoint &p, const furn_id &new_furniture,
     set_memory_seen_cache_dirty( p );
 
     // TODO: Limit to changes that affect move cost, traps and stairs
-    set_pathfinding_cache_dirty( p.z );
+    set_pathfinding_cache_dirty( p );
 
     // Make sure the furniture falls if it needs to
     support_dirty( p );
@@ -1622,7 +1639,7 @@ uint8_t map::get_known_connections( const tripoint &p, int connect_group,
     if( use_tiles ) {
         is_memorized =
         [&]( const tripoint & q ) {
-            return !g->u.get_memorized_tile( getabs( q ) ).tile.empty();
+            return !g->u.get_memorized_tile( getabs( q ) ).tile().empty();
         };
     } else {
 #endif
@@ -1674,7 +1691,7 @@ uint8_t map::get_known_connections_f( const tripoint &p, int connect_group,
 #ifdef TILES
     if( use_tiles ) {
         is_memorized = [&]( const tripoint & q ) {
-            return !player_character.get_memorized_tile( getabs( q ) ).tile.empty();
+            return !player_character.get_memorized_tile( getabs( q ) ).tile().empty();
         };
     } else {
 #endif
@@ -1809,6 +1826,10 @@ bool map::ter_set( const tripoint &p, const ter_id &new_terrain )
         return false;
     }
 
+    if( ( old_id == t_rootcellar ) != ( new_terrain == t_rootcellar ) ) {
+        // Perishables asleep here rotted at the old temperature until now
+        wake_items( p );
+    }
     current_submap->set_ter( l, new_terrain );
 
     // Set the dirty flags
@@ -1834,6 +1855,10 @@ bool map::ter_set( const tripoint &p, const ter_id &new_terrain )
 
     if( old_t.has_flag( TFLAG_INDOORS ) != new_t.has_flag( TFLAG_INDOORS ) ) {
         set_outside_cache_dirty( p.z );
+        // Doors that only open from inside check `is_outside`, which spills one tile around
+        for( const tripoint &near : points_in_radius( p, 1 ) ) {
+            set_pathfinding_cache_dirty( near );
+        }
     }
 
     if( new_t.has_flag( TFLAG_NO_FLOOR ) != old_t.has_flag( TFLAG_NO_FLOOR ) ) {
@@ -1855,7 +1880,7 @@ bool map::ter_set( const tripoint &p, const ter_id &new_terrain )
     set_memory_seen_cache_dirty( p );
 
     // TODO: Limit to changes that affect move cost, traps and stairs
-    set_pathfinding_cache_dirty( p.z );
+    set_pathfinding_cache_dirty( p );
 
     tripoint above( p.xy(), p.z + 1 );
     // Make sure that if we supported something and no longer do so, it falls down
@@ -4348,16 +4373,32 @@ map_stack map::i_at( const tripoint &p )
 
     point l;
     submap *const current_submap = get_submap_at( p, l );
-
+    // Changes to the stack mark the submap through its `tile_item_location`
     return map_stack{ &current_submap->get_items( l ), p, this };
 }
 
+const item_summary &map::items_summary( const tripoint &p ) const
+{
+    static const item_summary nothing;
+    if( !inbounds( p ) ) {
+        return nothing;
+    }
+
+    point l;
+    submap *const current_submap = get_submap_at( p, l );
+    const location_vector<item> &items = current_submap->get_items( l );
+    return static_cast<const item_pile_location *>( items.get_location() )->get_summary(
+               items.as_vector() );
+}
+
 map_stack::iterator map::i_rem( const tripoint &p, map_stack::const_iterator it,
                                 detached_ptr<item>  *out )
 {
     point l;
     submap *const current_submap = get_submap_at( p, l );
+    current_submap->mark_modified();
 
+    wake_item( **it, p );
     // remove from the active items cache (if it isn't there does nothing)
     current_submap->active_items.remove( *it );
     if( current_submap->active_items.empty() ) {
@@ -4371,6 +4412,7 @@ map_stack::iterator map::i_rem( const tripoint &p, map_stack::const_iterator it,
 
 detached_ptr<item> map::i_rem( const tripoint &p, item *it )
 {
+    wake_item( *it, p );
     map_stack map_items = i_at( p );
     detached_ptr<item> res;
     map_items.remove_top_items_with( [&res, it]( detached_ptr<item> &&e ) {
@@ -4387,8 +4429,10 @@ std::vector<detached_ptr<item>> map::i_clear( const tripoint &p )
 {
     point l;
     submap *const current_submap = get_submap_at( p, l );
+    current_submap->mark_modified();
 
     for( item * const &it : current_submap->get_items( l ) ) {
+        wake_item( *it, p );
         // remove from the active items cache (if it isn't there does nothing)
         current_submap->active_items.remove( it );
     }
@@ -4640,6 +4684,7 @@ void map::add_item( const tripoint &p, detached_ptr<item> &&new_item )
     }
 
     current_submap->is_uniform = false;
+    current_submap->mark_modified();
     invalidate_max_populated_zlev( p.z );
 
     current_submap->update_lum_add( l, *new_item );
@@ -4711,6 +4756,7 @@ void map::make_inactive( item &loc )
     point l;
     submap *const current_submap = get_submap_at( loc.position(), l );
 
+    current_submap->mark_modified();
     // remove from the active items cache (if it isn't there does nothing)
     current_submap->active_items.remove( &loc );
     if( current_submap->active_items.empty() ) {
@@ -4837,6 +4883,8 @@ std::vector<tripoint> map::check_submap_active_item_consistency()
 
 void map::process_items()
 {
+    ZoneScoped;
+    telemetry::scoped_timer timer( telemetry::phase::process_items );
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
     for( int gz = minz; gz <= maxz; ++gz ) {
@@ -4878,6 +4926,31 @@ static temperature_flag temperature_flag_at_point( const map &m, const tripoint
     return temperature_flag::TEMP_NORMAL;
 }
 
+/** Temperature of the cargo of @p pt, for perishables in it. */
+static temperature_flag cargo_temperature_flag( const vehicle_part &pt,
+        const bool engine_heater_is_on )
+{
+    const vpart_info &pti = pt.info();
+    if( pt.enabled && pti.has_flag( VPFLAG_FRIDGE ) ) {
+        return temperature_flag::TEMP_FRIDGE;
+    } else if( pt.enabled && pti.has_flag( VPFLAG_FREEZER ) ) {
+        return temperature_flag::TEMP_FREEZER;
+    }
+    return engine_heater_is_on ? temperature_flag::TEMP_HEATER : temperature_flag::TEMP_NORMAL;
+}
+
+// Nothing will change until the next rot state, the rot is caught up on when woken.
+static void sleep_if_only_rotting( active_item_cache &cache, item &it )
+{
+    if( !it.is_loaded() || !it.only_rots() ) {
+        return;
+    }
+    const time_duration asleep = it.time_until_rot_state_change() - 10_minutes;
+    if( asleep > 10_minutes ) {
+        cache.sleep( it, calendar::turn + asleep );
+    }
+}
+
 void map::process_items_in_submap( submap &current_submap, const tripoint &gridp )
 {
     // Get a COPY of the active item list for this submap.
@@ -4893,7 +4966,28 @@ void map::process_items_in_submap( submap &current_submap, const tripoint &gridp
 
         const tripoint map_location = active_item_ref->position();
         temperature_flag flag = temperature_flag_at_point( *this, map_location );
-        process_map_items( active_item_ref, map_location, flag );
+        if( !process_map_items( active_item_ref, map_location, flag ) ) {
+            sleep_if_only_rotting( current_submap.active_items, *active_item_ref );
+        }
+    }
+}
+
+void map::wake_item( item &it, const tripoint &p )
+{
+    if( !it.is_food() ) {
+        return;
+    }
+    point l;
+    submap *const current_submap = get_submap_at( p, l );
+    if( current_submap->active_items.wake( it ) ) {
+        it.accumulate_rot( p, temperature_flag_at_point( *this, p ), get_weather(), false );
+    }
+}
+
+void map::wake_items( const tripoint &p )
+{
+    for( item *it : i_at( p ) ) {
+        wake_item( *it, p );
     }
 }
 
@@ -4929,6 +5023,13 @@ void map::process_items_in_vehicle( vehicle &cur_veh, submap &current_submap )
     auto cargo_parts = cur_veh.get_parts_including_carried( VPFLAG_CARGO );
     for( const vpart_reference &vp : cargo_parts ) {
         process_vehicle_items( cur_veh, vp.part_index() );
+        vehicle_part &pt = vp.part();
+        const temperature_flag cargo_flag = cargo_temperature_flag( pt, engine_heater_is_on );
+        if( cargo_flag != pt.cargo_temperature ) {
+            // Switched on or off, or out of power: what slept until now rotted at the old temperature.
+            cur_veh.wake_items( static_cast<int>( vp.part_index() ) );
+            pt.cargo_temperature = cargo_flag;
+        }
     }
 
     for( item *active_item_ref : cur_veh.active_items.get_for_processing() ) {
@@ -4950,20 +5051,12 @@ void map::process_items_in_vehicle( vehicle &cur_veh, submap &current_submap )
         auto items = cur_veh.get_items( static_cast<int>( it->part_index() ) );
         temperature_flag flag = temperature_flag::TEMP_NORMAL;
         if( target.is_food() || target.is_food_container() || target.is_corpse() ) {
-            const vpart_info &pti = pt.info();
-            if( engine_heater_is_on ) {
-                flag = temperature_flag::TEMP_HEATER;
-            }
-
-            if( pt.enabled && pti.has_flag( VPFLAG_FRIDGE ) ) {
-                flag = temperature_flag::TEMP_FRIDGE;
-            } else if( pt.enabled && pti.has_flag( VPFLAG_FREEZER ) ) {
-                flag = temperature_flag::TEMP_FREEZER;
-            }
+            flag = cargo_temperature_flag( pt, engine_heater_is_on );
         }
         if( !process_map_items( active_item_ref, item_loc, flag ) ) {
             // If the item was NOT destroyed, we can skip the remainder,
             // which handles fallout from the vehicle being damaged.
+            sleep_if_only_rotting( cur_veh.active_items, *active_item_ref );
             continue;
         }
 
@@ -5460,6 +5553,7 @@ void map::partial_con_remove( const tripoint &p )
     point l;
     submap *const current_submap = get_submap_at( p, l );
     current_submap->partial_constructions.erase( tripoint( l, p.z ) );
+    current_submap->mark_modified();
 }
 
 void map::partial_con_set( const tripoint &p, std::unique_ptr<partial_con> con )
@@ -5499,6 +5593,7 @@ void map::trap_set( const tripoint &p, const trap_id &type )
     if( type != tr_null ) {
         traplocs[type.to_i()].push_back( p );
     }
+    set_pathfinding_cache_dirty( p );
 }
 
 void map::disarm_trap( const tripoint &p )
@@ -5580,6 +5675,7 @@ void map::remove_trap( const tripoint &p )
         if( iter != traps.end() ) {
             traps.erase( iter );
         }
+        set_pathfinding_cache_dirty( p );
     }
 }
 /*
@@ -5722,6 +5818,7 @@ bool map::add_field( const tripoint &p, const field_type_id &type_id, int intens
     point l;
     submap *const current_submap = get_submap_at( p, l );
     current_submap->is_uniform = false;
+    current_submap->mark_modified();
     invalidate_max_populated_zlev( p.z );
 
     if( current_submap->get_field( l ).add_field( type_id, intensity, age ) ) {
@@ -5747,7 +5844,7 @@ bool map::add_field( const tripoint &p, const field_type_id &type_id, int intens
     }
 
     if( fd_type.is_dangerous() ) {
-        set_pathfinding_cache_dirty( p.z );
+        set_pathfinding_cache_dirty( p );
     }
 
     // Ensure blood type fields don't hang in the air
@@ -5768,6 +5865,7 @@ void map::remove_field( const tripoint &p, const field_type_id &field_to_remove
     submap *const current_submap = get_submap_at( p, l );
 
     if( current_submap->get_field( l ).remove_field( field_to_remove ) ) {
+        current_submap->mark_modified();
         // Only adjust the count if the field actually existed.
         if( !--current_submap->field_count ) {
             get_cache( p.z ).field_cache.set( static_cast<size_t>( p.x / SEEX + ( (
@@ -5779,7 +5877,7 @@ void map::remove_field( const tripoint &p, const field_type_id &field_to_remove
             set_seen_cache_dirty( p );
         }
         if( fdata.is_dangerous() ) {
-            set_pathfinding_cache_dirty( p.z );
+            set_pathfinding_cache_dirty( p );
         }
     }
 }
@@ -6407,9 +6505,6 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range ) const
     return sees( F, T, range, dummy );
 }
 
-/**
- * This one is internal-only, we don't want to expose the slope tweaking ickiness outside the map class.
- **/
 bool map::sees( const tripoint &F, const tripoint &T, const int range,
                 int &bresenham_slope ) const
 {
@@ -6418,19 +6513,36 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
         bresenham_slope = 0;
         return false; // Out of range!
     }
-    // Cannonicalize the order of the tripoints so the cache is reflexive.
-    const tripoint &min = F < T ? F : T;
-    const tripoint &max = !( F < T ) ? F : T;
-    // A little gross, just pack the values into a point.
-    const point key(
-        min.x << 16 | min.y << 8 | ( min.z + OVERMAP_DEPTH ),
-        max.x << 16 | max.y << 8 | ( max.z + OVERMAP_DEPTH )
-    );
-    char cached = skew_vision_cache.get( key, -1 );
-    if( cached >= 0 ) {
-        return cached > 0;
+    if( const std::optional<bool> cached = sight_cache.get( F, T ) ) {
+        return *cached;
     }
 
+    const bool visible = sees_uncached( F, T, bresenham_slope );
+    sight_cache.set( F, T, visible );
+    return visible;
+}
+
+bool map::sees_uncached( const tripoint &F, const tripoint &T ) const
+{
+    if( !inbounds( T ) ) {
+        return false;
+    }
+    int dummy = 0;
+    return sees_uncached( F, T, dummy );
+}
+
+bool map::has_cached_sees( const tripoint &F, const tripoint &T ) const
+{
+    return sight_cache.get( F, T ).has_value();
+}
+
+void map::cache_sees( const tripoint &F, const tripoint &T, const bool visible ) const
+{
+    sight_cache.set( F, T, visible );
+}
+
+bool map::sees_uncached( const tripoint &F, const tripoint &T, int &bresenham_slope ) const
+{
     bool visible = true;
 
     // Ugly `if` for now
@@ -6451,7 +6563,6 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
             last_point = new_point;
             return true;
         } );
-        skew_vision_cache.insert( 100000, key, visible ? 1 : 0 );
         return visible;
     }
 
@@ -6484,7 +6595,6 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
         last_point = new_point;
         return true;
     } );
-    skew_vision_cache.insert( 100000, key, visible ? 1 : 0 );
     return visible;
 }
 
@@ -6807,7 +6917,7 @@ bool map::obscured_by_vehicle_rotation( const tripoint &from, const tripoint &to
 
     point delta = to.xy() - from.xy();
 
-    auto cache = get_cache( from.z ).vehicle_obscured_cache;
+    const auto &cache = get_cache( from.z ).vehicle_obscured_cache;
 
     if( delta == point_north_west ) {
         return cache[from.x][from.y].nw;
@@ -7022,7 +7132,9 @@ void map::shift_vehicle_z( vehicle &veh, int z_shift )
     auto src_submap_veh_it = src_submap->vehicles.begin() + our_i;
     dst_submap->vehicles.push_back( std::move( *src_submap_veh_it ) );
     src_submap->vehicles.erase( src_submap_veh_it );
+    src_submap->mark_modified();
     dst_submap->is_uniform = false;
+    dst_submap->mark_modified();
     invalidate_max_populated_zlev( dst.z );
 
     update_vehicle_list( dst_submap, dst.z );
@@ -7264,12 +7376,30 @@ static void generate_uniform( const tripoint &p, const ter_id &terrain_type )
     }
 }
 
-void map::loadn( const tripoint &grid, const bool update_vehicles )
+void map::generate_omt( const tripoint_abs_omt &omt )
 {
     // Cache empty overmap types
     static const oter_id rock( "empty_rock" );
     static const oter_id air( "open_air" );
 
+    // TODO: fix point types
+    const tripoint abs_sub_rounded = omt_to_sm_copy( omt.raw() );
+    const oter_id terrain_type = overmap_buffer.ter( omt );
+
+    // Short-circuit if the map tile is uniform
+    // TODO: Replace with json mapgen functions.
+    if( terrain_type == air ) {
+        generate_uniform( abs_sub_rounded, t_open_air );
+    } else if( terrain_type == rock ) {
+        generate_uniform( abs_sub_rounded, t_rock );
+    } else {
+        tinymap tmp_map;
+        tmp_map.generate( abs_sub_rounded, calendar::turn );
+    }
+}
+
+void map::loadn( const tripoint &grid, const bool update_vehicles )
+{
     const tripoint grid_abs_sub = abs_sub.xy() + grid;
     const size_t gridn = get_nonant( grid );
 
@@ -7281,24 +7411,10 @@ void map::loadn( const tripoint &grid, const bool update_vehicles )
         // It doesn't exist; we must generate it!
         dbg( DL::Info ) << "map::loadn: Missing mapbuffer data.  Regenerating.";
 
-        // Each overmap square is two nonants; to prevent overlap, generate only at
-        //  squares divisible by 2.
+        // Each overmap square is two nonants; to prevent overlap, generate the whole
+        //  overmap square at once.
         // TODO: fix point types
-        const tripoint_abs_omt grid_abs_omt( sm_to_omt_copy( grid_abs_sub ) );
-        const tripoint grid_abs_sub_rounded = omt_to_sm_copy( grid_abs_omt.raw() );
-
-        const oter_id terrain_type = overmap_buffer.ter( grid_abs_omt );
-
-        // Short-circuit if the map tile is uniform
-        // TODO: Replace with json mapgen functions.
-        if( terrain_type == air ) {
-            generate_uniform( grid_abs_sub_rounded, t_open_air );
-        } else if( terrain_type == rock ) {
-            generate_uniform( grid_abs_sub_rounded, t_rock );
-        } else {
-            tinymap tmp_map;
-            tmp_map.generate( grid_abs_sub_rounded, calendar::turn );
-        }
+        generate_omt( tripoint_abs_omt( sm_to_omt_copy( grid_abs_sub ) ) );
 
         // This is the same call to MAPBUFFER as above!
         tmpsub = MAPBUFFER.lookup_submap( grid_abs_sub );
@@ -7775,6 +7891,10 @@ void map::actualize( const tripoint &grid )
 
     const time_duration time_since_last_actualize = calendar::turn - tmpsub->last_touched;
     const bool do_funnels = ( grid.z >= 0 );
+    if( tmpsub->field_count > 0 ) {
+        // decay_cosmetic_fields modifies the fields in place
+        tmpsub->mark_modified();
+    }
 
     // check spoiled stuff, and fill up funnels while we're at it
     for( int x = 0; x < SEEX; x++ ) {
@@ -7786,7 +7906,9 @@ void map::actualize( const tripoint &grid )
                 field_furn_locs.push_back( pnt );
             }
             // plants contain a seed item which must not be removed under any circumstances
-            if( !furn.has_flag( "DONT_REMOVE_ROTTEN" ) ) {
+            if( !furn.has_flag( "DONT_REMOVE_ROTTEN" ) && !tmpsub->get_items( p ).empty() ) {
+                // Rot is applied to the items in place
+                tmpsub->mark_modified();
                 temperature_flag temperature = temperature_flag_at_point( *this, pnt );
                 remove_rotten_items( tmpsub->get_items( { x, y } ), pnt, temperature );
             }
@@ -8065,7 +8187,10 @@ void map::spawn_monsters_submap( const tripoint &gp, bool ignore_sight )
             }
         }
     }
-    current_submap->spawns.clear();
+    if( !current_submap->spawns.empty() ) {
+        current_submap->spawns.clear();
+        current_submap->mark_modified();
+    }
 }
 
 void map::spawn_monsters( bool ignore_sight )
@@ -8088,7 +8213,10 @@ void map::spawn_monsters( bool ignore_sight )
 void map::clear_spawns()
 {
     for( auto &smap : grid ) {
-        smap->spawns.clear();
+        if( !smap->spawns.empty() ) {
+            smap->spawns.clear();
+            smap->mark_modified();
+        }
     }
 }
 
@@ -8588,6 +8716,7 @@ void map::do_vehicle_caching( int z )
 void map::build_map_cache( const int zlev, bool skip_lightmap )
 {
     ZoneScoped;
+    telemetry::scoped_timer timer( telemetry::phase::build_map_cache );
     const int minz = zlevels ? -OVERMAP_DEPTH : zlev;
     const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
     bool seen_cache_dirty = false;
@@ -8614,7 +8743,7 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
     seen_cache_dirty |= build_vision_transparency_cache( get_player_character() );
 
     if( seen_cache_dirty ) {
-        skew_vision_cache.clear();
+        sight_cache.clear();
     }
     // Initial value is illegal player position.
     const tripoint &p = g->u.pos();
@@ -9192,6 +9321,19 @@ void map::set_pathfinding_cache_dirty( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
         get_pathfinding_cache( zlev ).dirty = true;
+        if( g != nullptr && this == &get_map() ) {
+            Pathfinding::invalidate_level( zlev );
+        }
+    }
+}
+
+void map::set_pathfinding_cache_dirty( const tripoint &p )
+{
+    if( inbounds( p ) ) {
+        get_pathfinding_cache( p.z ).dirty = true;
+        if( g != nullptr && this == &get_map() ) {
+            Pathfinding::invalidate_tile( p );
+        }
     }
 }
 
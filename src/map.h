@@ -26,7 +26,7 @@
 #include "item_stack.h"
 #include "lightmap.h"
 #include "line.h"
-#include "lru_cache.h"
+#include "line_of_sight_cache.h"
 #include "mapdata.h"
 #include "memory_fast.h"
 #include "point.h"
@@ -59,6 +59,7 @@ template<typename Tripoint>
 class tripoint_range;
 class vehicle;
 class zone_data;
+struct item_summary;
 struct maptile;
 struct partial_con;
 struct trap;
@@ -355,6 +356,68 @@ struct level_cache {
 
 };
 
+/** How the light of a @ref light_source_key is cast, see map::generate_lightmap. */
+enum class light_cast : int {
+    point,
+    arc,
+    directional
+};
+
+/**
+ * Everything the light cast from one source depends on, apart from the transparency
+ * around it. Equal keys cast over equal transparency light exactly the same tiles.
+ */
+struct light_source_key {
+    light_cast kind;
+    point pos;
+    float luminance;
+    // Direction and width of arcs, in radians
+    double angle;
+    double width;
+    // Cast directions of point sources, direction of directional light
+    int variant;
+
+    bool operator<( const light_source_key &rhs ) const {
+        return std::tie( kind, pos, luminance, angle, width, variant ) <
+               std::tie( rhs.kind, rhs.pos, rhs.luminance, rhs.angle, rhs.width, rhs.variant );
+    }
+};
+
+/** The light one source added to the lightmap when it was last cast. */
+struct light_contribution {
+    // Only the tiles the source lit, with the light it gave them
+    std::vector<std::pair<point, four_quadrants>> tiles;
+    // Submaps whose transparency the cast depended on
+    std::bitset<MAPSIZE *MAPSIZE> reach;
+    int last_used = 0;
+};
+
+/**
+ * Light source contributions kept between lightmap builds of one z-level.
+ * A source is only cast again when its key changed or the transparency or vehicle blocks within
+ * its reach did.
+ */
+struct light_source_cache {
+    light_source_cache();
+
+    std::map<light_source_key, light_contribution> contributions;
+    // Transparency and vehicle blocks the contributions were cast over
+    float transparency[MAPSIZE_X][MAPSIZE_Y];
+    diagonal_blocks blocked[MAPSIZE_X][MAPSIZE_Y];
+    float weather_transparency = 0.0f;
+    bool trigdist = false;
+    tripoint abs_sub = tripoint_min;
+    // Counts lightmap builds, for dropping sources that are gone
+    int generation = 0;
+    // New sources are cast into this first, it is all zero in between
+    four_quadrants scratch[MAPSIZE_X][MAPSIZE_Y];
+    // Tiles of scratch written to by the cast in progress, as x * MAPSIZE_Y + y
+    std::vector<int> touched;
+    // Sources cast again and sources reused by the latest build
+    int cast_count = 0;
+    int reused_count = 0;
+};
+
 /**
  * Manage and cache data about a part of the map.
  *
@@ -420,6 +483,8 @@ class map
         void set_suspension_cache_dirty( const int zlev );
 
         void set_pathfinding_cache_dirty( int zlev );
+        /** Like above, but lets reusable pathfinding maps be repaired locally around @p p. */
+        void set_pathfinding_cache_dirty( const tripoint &p );
         /*@}*/
 
         void set_memory_seen_cache_dirty( const tripoint &p );
@@ -614,7 +679,17 @@ class map
         * Returns whether `F` sees `T` with a view range of `range`.
         */
         bool sees( const tripoint &F, const tripoint &T, int range ) const;
+        /**
+         * Line of sight between `F` and `T` regardless of range, bypassing the sight cache.
+         * Only reads the map caches, so several threads may call it while the map isn't being changed.
+         */
+        bool sees_uncached( const tripoint &F, const tripoint &T ) const;
+        /** Whether the sight cache already holds the line of sight between `F` and `T`. */
+        bool has_cached_sees( const tripoint &F, const tripoint &T ) const;
+        /** Stores a @ref sees_uncached result so later @ref sees calls don't recompute it. */
+        void cache_sees( const tripoint &F, const tripoint &T, bool visible ) const;
     private:
+        bool sees_uncached( const tripoint &F, const tripoint &T, int &bresenham_slope ) const;
         /**
          * Don't expose the slope adjust outside map functions.
          *
@@ -1193,6 +1268,8 @@ class map
         map_stack i_at( point p ) {
             return i_at( tripoint( p, abs_sub.z ) );
         }
+        /** Summary of the items at @p p, kept until they change. */
+        const item_summary &items_summary( const tripoint &p ) const;
         detached_ptr<item> water_from( const tripoint &p );
         std::vector<detached_ptr<item>> i_clear( const tripoint &p );
         std::vector<detached_ptr<item>> i_clear( point p ) {
@@ -1283,6 +1360,14 @@ class map
          */
         void make_active( item &loc );
 
+        /**
+         * Catches up on the rot of a perishable item at @p p that processing put to sleep,
+         * for when it is about to leave the map or be used.
+         */
+        void wake_item( item &it, const tripoint &p );
+        /** Wakes all the items at @p p, e.g. before the temperature there changes. */
+        void wake_items( const tripoint &p );
+
         /**
          * Update luminosity before and after item's transformation
          */
@@ -1556,6 +1641,15 @@ class map
 
         // mapgen.cpp functions
         void generate( const tripoint &p, const time_point &when );
+        /**
+         * Generates the submaps of the overmap terrain at @p omt and stores them in
+         * @ref MAPBUFFER. They must be neither loaded nor saved yet.
+         *
+         * Mapgen draws from the global RNG, may create overmaps and NPCs through the
+         * overmap buffer, runs Lua hooks and spawns items and monsters, none of which
+         * is safe off the main thread, so neither is this.
+         */
+        static void generate_omt( const tripoint_abs_omt &omt );
         void place_spawns( const mongroup_id &group, int chance,
                            point p1, point p2, float density,
                            bool individual = false, bool friendly = false, const std::string &name = "NONE",
@@ -1802,7 +1896,13 @@ class map
         // Checks all suspended tiles on a z level and adds those that are invalid to the support_dirty_cache */
         void update_suspension_cache( const int &z );
     protected:
+        /**
+         * Rebuilds the lightmap of the z-level. With the INCREMENTAL_LIGHTMAP option, the light of
+         * sources that didn't change is reused from the previous build, see @ref light_source_cache.
+         */
         void generate_lightmap( int zlev );
+        void build_lightmap( int zlev );
+        light_source_cache &prepare_light_source_cache( int zlev );
         void build_seen_cache( const tripoint &origin, int target_z );
         void apply_character_light( Character &p );
 
@@ -1917,8 +2017,10 @@ class map
         void apply_directional_light( const tripoint &p, int direction, float luminance );
         void apply_light_arc( const tripoint &p, units::angle, float luminance,
                               units::angle wideangle = 30_degrees );
-        void apply_light_ray( bool lit[MAPSIZE_X][MAPSIZE_Y],
-                              const tripoint &s, const tripoint &e, float luminance );
+        // Casts @p key into the lightmap, or reuses its cast from a previous lightmap build.
+        // The callback casts into the given array, telling whether writes to it must be tracked.
+        void apply_light_contribution( int zlev, const light_source_key &key,
+                                       const std::function<void( four_quadrants( & )[MAPSIZE_X][MAPSIZE_Y], bool )> &cast );
         void add_light_from_items( const tripoint &p, const item_stack::iterator &begin,
                                    const item_stack::iterator &end );
         std::unique_ptr<vehicle> add_vehicle_to_map( std::unique_ptr<vehicle> veh, bool merge_wrecks );
@@ -1990,15 +2092,19 @@ class map
         std::array< std::unique_ptr<level_cache>, OVERMAP_LAYERS > caches;
 
         mutable std::array< std::unique_ptr<pathfinding_cache>, OVERMAP_LAYERS > pathfinding_caches;
+        std::array< std::unique_ptr<light_source_cache>, OVERMAP_LAYERS > light_source_caches;
+        // Only set while generate_lightmap reuses light from previous builds
+        light_source_cache *active_light_sources = nullptr;
+        int active_light_sources_z = 0;
         /**
          * Set of submaps that contain active items in absolute coordinates.
          */
         std::set<tripoint> submaps_with_active_items;
 
         /**
-         * Cache of coordinate pairs recently checked for visibility.
+         * Cache of coordinate pairs checked for visibility, cleared when the seen cache is dirty.
          */
-        mutable lru_cache<point, char> skew_vision_cache;
+        mutable line_of_sight_cache sight_cache;
 
         /**
          * Vehicle list doesn't change often, but is pretty expensive.
@@ -2023,6 +2129,10 @@ class map
         const level_cache &get_cache_ref( int zlev ) const {
             return *caches[zlev + OVERMAP_DEPTH];
         }
+        /** Light kept by the latest incremental lightmap build of the z-level, if any. */
+        const light_source_cache *get_light_source_cache( int zlev ) const {
+            return light_source_caches[zlev + OVERMAP_DEPTH].get();
+        }
 
         const pathfinding_cache &get_pathfinding_cache_ref( int zlev ) const;
 
@@ -45,6 +45,7 @@
 #include "mtype.h"
 #include "npc.h"
 #include "overmapbuffer.h"
+#include "perf_telemetry.h"
 #include "player.h"
 #include "pldata.h"
 #include "point.h"
@@ -143,6 +144,7 @@ int map::burn_body_part( player &u, field_entry &cur, body_part bp_token, const
 void map::process_fields()
 {
     ZoneScoped;
+    telemetry::scoped_timer timer( telemetry::phase::process_fields );
 
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
@@ -401,6 +403,8 @@ void map::process_fields_in_submap( submap *const current_submap,
                                     const tripoint &submap )
 {
     scent_block sblk( submap, g->scent );
+    // Fields age and die below without going through map::remove_field
+    current_submap->mark_modified();
 
     // Holds m.field_at(x,y).find_field(fd_some_field) type returns.
     // Just to avoid typing that long string for a temp value.
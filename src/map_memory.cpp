@@ -1,5 +1,7 @@
 #include "map_memory.h"
 
+#include <deque>
+
 #include "coordinate_conversions.h"
 #include "cuboid_rectangle.h"
 #include "debug.h"
@@ -9,8 +11,9 @@
 #include "line.h"
 #include "translations.h"
 #include "map.h"
+#include "string_formatter.h"
 #include "world.h"
-const memorized_terrain_tile mm_submap::default_tile { "", 0, 0 };
+const memorized_terrain_tile mm_submap::default_tile {};
 const int mm_submap::default_symbol = 0;
 
 #define MM_SIZE (MAPSIZE * 2)
@@ -30,8 +33,78 @@ struct reg_coord_pair {
     }
 };
 
+namespace
+{
+
+struct tile_dictionary {
+    // deque keeps references to the names valid as it grows
+    std::deque<std::string> names{ std::string() };
+    std::unordered_map<std::string, uint32_t> handles{ { std::string(), 0 } };
+};
+
+tile_dictionary &get_tile_dictionary()
+{
+    static tile_dictionary dictionary;
+    return dictionary;
+}
+
+} // namespace
+
+memorized_terrain_tile::memorized_terrain_tile( const std::string &tile, int subtile,
+        int rotation ) : subtile( subtile ), rotation( rotation ), handle( intern( tile ) )
+{
+}
+
+memorized_terrain_tile memorized_terrain_tile::from_handle( uint32_t handle, int subtile,
+        int rotation )
+{
+    memorized_terrain_tile ret;
+    ret.handle = handle;
+    ret.subtile = subtile;
+    ret.rotation = rotation;
+    return ret;
+}
+
+const std::string &memorized_terrain_tile::tile() const
+{
+    return get_tile_dictionary().names[handle];
+}
+
+uint32_t memorized_terrain_tile::intern( const std::string &tile )
+{
+    tile_dictionary &dictionary = get_tile_dictionary();
+    const auto iter = dictionary.handles.find( tile );
+    if( iter != dictionary.handles.end() ) {
+        return iter->second;
+    }
+    const uint32_t handle = dictionary.names.size();
+    dictionary.names.push_back( tile );
+    dictionary.handles.emplace( tile, handle );
+    return handle;
+}
+
+size_t memorized_terrain_tile::interned_count()
+{
+    return get_tile_dictionary().names.size();
+}
+
+uint32_t mm_tile_dictionary::index( const uint32_t handle )
+{
+    const auto iter = index_of.emplace( handle, handles.size() );
+    if( iter.second ) {
+        handles.push_back( handle );
+    }
+    return iter.first->second;
+}
+
 mm_submap::mm_submap() = default;
 
+size_t mm_submap::memory_usage() const
+{
+    return sizeof( mm_submap ) + tiles.capacity() * sizeof( memorized_terrain_tile ) +
+           symbols.capacity() * sizeof( int );
+}
+
 mm_region::mm_region() : submaps {{ nullptr }} {}
 
 bool mm_region::is_empty() const
@@ -86,6 +159,29 @@ void map_memory::memorize_tile( const tripoint &pos, const std::string &ter,
     sm.set_tile( p.loc, memorized_terrain_tile{ ter, subtile, rotation } );
 }
 
+size_t map_memory::memory_usage() const
+{
+    size_t ret = 0;
+    for( const auto &it : submaps ) {
+        // Tree node and control block of the shared pointer, roughly
+        ret += sizeof( it ) + 4 * sizeof( void * ) + it.second->memory_usage();
+    }
+    return ret;
+}
+
+std::string map_memory::memory_report() const
+{
+    size_t with_tiles = 0;
+    size_t with_symbols = 0;
+    for( const auto &it : submaps ) {
+        with_tiles += !it.second->tiles.empty();
+        with_symbols += !it.second->symbols.empty();
+    }
+    return string_format( "%d submaps (%d with tiles, %d with symbols), %d KiB, %d interned tile ids",
+                          submaps.size(), with_tiles, with_symbols, memory_usage() / 1024,
+                          memorized_terrain_tile::interned_count() );
+}
+
 int map_memory::get_symbol( const tripoint &pos )
 {
     coord_pair p( pos );
@@ -203,11 +299,12 @@ static void temp_remove_open_air( const shared_ptr_fast<mm_submap> &sm )
     if( sm->is_empty() ) {
         return;
     }
+    static const uint32_t open_air = memorized_terrain_tile::intern( "t_open_air" );
     for( int x = 0; x < SEEX; x++ ) {
         for( int y = 0; y < SEEY; y++ ) {
             const memorized_terrain_tile &t = sm->tile( {x, y} );
 
-            if( !t.tile.empty() && t.tile == "t_open_air" ) {
+            if( t.tile_handle() == open_air ) {
                 sm->set_tile( {x, y}, mm_submap::default_tile );
             }
         }
@@ -298,7 +395,7 @@ bool map_memory::save( const tripoint &pos )
 
     clear_cache();
 
-    dbg( DL::Info ) << "N submaps before save: " << submaps.size();
+    dbg( DL::Info ) << "Before save: " << memory_report();
 
     // Since mm_submaps are always allocated in regions,
     // we are certain that each region will be filled.
@@ -352,7 +449,7 @@ bool map_memory::save( const tripoint &pos )
     }
 
     dbg( DL::Info ) << "[SAVE] Done.";
-    dbg( DL::Info ) << "N submaps after save: " << submaps.size();
+    dbg( DL::Info ) << "After save: " << memory_report();
 
     return result;
 }
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "game_constants.h"
 #include "memory_fast.h"
@@ -10,18 +14,55 @@
 class JsonOut;
 class JsonIn;
 
+/**
+ * A memorized tileset tile.
+ * Tileset ids are interned in a dictionary shared by the whole game, which never forgets them,
+ * so each memorized tile only holds a handle instead of its own copy of the string.
+ */
 struct memorized_terrain_tile {
-    std::string tile;
-    int subtile;
-    int rotation;
+    public:
+        memorized_terrain_tile() = default;
+        memorized_terrain_tile( const std::string &tile, int subtile, int rotation );
+
+        /** Tileset id of the tile, empty if none was memorized. */
+        const std::string &tile() const;
+        uint32_t tile_handle() const {
+            return handle;
+        }
+
+        int16_t subtile = 0;
+        /** In degrees for vehicle parts, so it doesn't fit into fewer bits. */
+        int16_t rotation = 0;
+
+        bool operator==( const memorized_terrain_tile &rhs ) const {
+            return ( rotation == rhs.rotation ) && ( subtile == rhs.subtile ) && ( handle == rhs.handle );
+        }
+
+        bool operator!=( const memorized_terrain_tile &rhs ) const {
+            return !( *this == rhs );
+        }
 
-    bool operator==( const memorized_terrain_tile &rhs ) const {
-        return ( rotation == rhs.rotation ) && ( subtile == rhs.subtile ) && ( tile == rhs.tile );
-    }
+        /** Returns the handle of given tileset id, adding it to the dictionary if needed. */
+        static uint32_t intern( const std::string &tile );
+        static memorized_terrain_tile from_handle( uint32_t handle, int subtile, int rotation );
+        /** Number of distinct tileset ids interned so far. */
+        static size_t interned_count();
 
-    bool operator!=( const memorized_terrain_tile &rhs ) const {
-        return !( *this == rhs );
-    }
+    private:
+        /** 0 is the empty id. */
+        uint32_t handle = 0;
+};
+
+/**
+ * Tileset ids used by one saved mm_region, in the order they first appear.
+ * Submaps of the region refer to the ids by their index in it.
+ */
+struct mm_tile_dictionary {
+    std::vector<uint32_t> handles;
+    std::unordered_map<uint32_t, uint32_t> index_of;
+
+    /** Index of given interned id, added to the dictionary if needed. */
+    uint32_t index( uint32_t handle );
 };
 
 /** Represent a submap-sized chunk of tile memory. */
@@ -72,8 +113,16 @@ struct mm_submap {
             symbols[p.y * SEEX + p.x] = value;
         }
 
-        void serialize( JsonOut &jsout ) const;
-        void deserialize( JsonIn &jsin );
+        /** Bytes held by this submap, including its own size. */
+        size_t memory_usage() const;
+
+        /** Writes the submap, with tile ids as indices into given dictionary. */
+        void serialize( JsonOut &jsout, mm_tile_dictionary &dictionary ) const;
+        /**
+         * Reads the submap. @p handles maps dictionary indices to interned ids,
+         * if it's null the tile ids are read as strings, like in saves made before dictionaries.
+         */
+        void deserialize( JsonIn &jsin, const std::vector<uint32_t> *handles );
 
     private:
         std::vector<memorized_terrain_tile> tiles; // holds either 0 or SEEX*SEEY elements
@@ -84,7 +133,7 @@ struct mm_submap {
 /**
  * Represents a square of mm_submaps.
  * For faster save/load, submaps are collected into regions
- * and each region is saved in its own file.
+ * and each region is saved in its own file, along with the tileset ids its submaps use.
  */
 struct mm_region {
     shared_ptr_fast<mm_submap> submaps[MM_REG_SIZE][MM_REG_SIZE];
@@ -176,6 +225,11 @@ class map_memory
          */
         void clear_memorized_tile( const tripoint &pos );
 
+        /** Bytes held by the loaded submaps. */
+        size_t memory_usage() const;
+        /** Human-readable summary of @ref memory_usage, for the debug log. */
+        std::string memory_report() const;
+
     private:
         std::map<tripoint, shared_ptr_fast<mm_submap>> submaps;
 
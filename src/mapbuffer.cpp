@@ -18,10 +18,13 @@
 #include "game_constants.h"
 #include "json.h"
 #include "map.h"
+#include "options.h"
 #include "output.h"
+#include "point_float.h"
 #include "popup.h"
 #include "string_formatter.h"
 #include "submap.h"
+#include "submap_binary.h"
 #include "translations.h"
 #include "ui_manager.h"
 #include "world.h"
@@ -88,6 +91,7 @@ void mapbuffer::save( bool delete_after_save )
 {
     int num_saved_submaps = 0;
     int num_total_submaps = submaps.size();
+    num_quads_written = 0;
 
     map &here = get_map();
     const tripoint map_origin = sm_to_omt_copy( here.get_abs_sub() );
@@ -141,6 +145,9 @@ void mapbuffer::save( bool delete_after_save )
     }
 
     get_distribution_grid_tracker().on_saved();
+
+    DebugLog( DL::Info, DC::Map ) << "mapbuffer: wrote " << num_quads_written << " of "
+                                  << saved_submaps.size() << " quads";
 }
 
 void mapbuffer::save_quad( const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
@@ -154,6 +161,7 @@ void mapbuffer::save_quad( const tripoint &om_addr, std::list<tripoint> &submaps
     offsets.push_back( point_south_east );
 
     bool all_uniform = true;
+    bool any_changed = false;
     for( auto &offsets_offset : offsets ) {
         tripoint submap_addr = omt_to_sm_copy( om_addr );
         submap_addr.x += offsets_offset.x;
@@ -163,10 +171,14 @@ void mapbuffer::save_quad( const tripoint &om_addr, std::list<tripoint> &submaps
         if( sm != nullptr && !sm->is_uniform ) {
             all_uniform = false;
         }
+        if( sm != nullptr && sm->needs_save() ) {
+            any_changed = true;
+        }
     }
 
-    if( all_uniform ) {
-        // Nothing to save - this quad will be regenerated faster than it would be re-read
+    if( all_uniform || !any_changed ) {
+        // Nothing to save - this quad will be regenerated faster than it would be re-read,
+        // or it's identical to what was last written
         if( delete_after_save ) {
             for( auto &submap_addr : submap_addrs ) {
                 if( submaps.contains( submap_addr ) && submaps[submap_addr] != nullptr ) {
@@ -182,20 +194,38 @@ void mapbuffer::save_quad( const tripoint &om_addr, std::list<tripoint> &submaps
         return;
     }
 
-    g->get_active_world()->write_map_quad( om_addr, [&]( std::ostream & fout ) {
-        JsonOut jsout( fout );
-        jsout.start_array();
-        for( auto &submap_addr : submap_addrs ) {
-            if( !submaps.contains( submap_addr ) ) {
-                continue;
-            }
+    num_quads_written++;
 
-            submap *sm = submaps[submap_addr].get();
+    std::vector<std::pair<tripoint, const submap *>> written;
+    std::vector<std::pair<tripoint, submap::save_point>> save_points;
+    for( auto &submap_addr : submap_addrs ) {
+        if( !submaps.contains( submap_addr ) ) {
+            continue;
+        }
 
-            if( sm == nullptr ) {
-                continue;
-            }
+        submap *sm = submaps[submap_addr].get();
 
+        if( sm == nullptr ) {
+            continue;
+        }
+
+        written.emplace_back( submap_addr, sm );
+        save_points.emplace_back( submap_addr, sm->get_save_point() );
+
+        if( delete_after_save ) {
+            submaps_to_delete.push_back( submap_addr );
+        }
+    }
+
+    const bool binary = get_option<bool>( "BINARY_MAP_SAVES" );
+    g->get_active_world()->write_map_quad( om_addr, [&]( std::ostream & fout ) {
+        if( binary ) {
+            submap_binary::write_quad( fout, written );
+            return;
+        }
+        JsonOut jsout( fout );
+        jsout.start_array();
+        for( const auto &[submap_addr, sm] : written ) {
             jsout.start_object();
 
             jsout.member( "version", savegame_version );
@@ -210,16 +240,65 @@ void mapbuffer::save_quad( const tripoint &om_addr, std::list<tripoint> &submaps
             sm->store( jsout );
 
             jsout.end_object();
-
-            if( delete_after_save ) {
-                submaps_to_delete.push_back( submap_addr );
-            }
         }
 
         jsout.end_array();
+    }, [this, save_points]() {
+        // Submaps deleted after saving don't need marking, they'll be read back as saved.
+        for( const auto &[submap_addr, saved] : save_points ) {
+            const auto iter = submaps.find( submap_addr );
+            if( iter != submaps.end() ) {
+                iter->second->mark_saved( saved );
+            }
+        }
     } );
 }
 
+std::vector<tripoint> mapbuffer::prefetch_ahead( const tripoint &abs_sub,
+        const rl_vec2d &heading, float tiles_per_turn, bool all_levels )
+{
+    // Cover the next few turns of travel, but always at least the next row of submaps.
+    static constexpr int lookahead_turns = 8;
+    static constexpr int max_lookahead = 4;
+    const int lookahead = clamp( static_cast<int>( tiles_per_turn * lookahead_turns / SEEX ) + 1,
+                                 1, max_lookahead );
+
+    // The current level goes first, a map shift loads it before the others
+    std::vector<int> levels{ abs_sub.z };
+    if( all_levels ) {
+        for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+            if( z != abs_sub.z ) {
+                levels.push_back( z );
+            }
+        }
+    }
+
+    // Closest predictions first, so the quads needed soonest are read first.
+    std::vector<tripoint> quads;
+    std::set<tripoint> seen;
+    for( const int z : levels ) {
+        for( int distance = 1; distance <= lookahead; distance++ ) {
+            const tripoint corner( abs_sub.xy() + ( heading * distance ).as_point(), z );
+            for( int y = 0; y < MAPSIZE; y++ ) {
+                for( int x = 0; x < MAPSIZE; x++ ) {
+                    const tripoint sm_pos = corner + point( x, y );
+                    if( is_submap_loaded( sm_pos ) ) {
+                        continue;
+                    }
+                    const tripoint om_addr = sm_to_omt_copy( sm_pos );
+                    if( seen.insert( om_addr ).second ) {
+                        quads.push_back( om_addr );
+                    }
+                }
+            }
+        }
+    }
+    if( !quads.empty() ) {
+        g->get_active_world()->prefetch_map_quads( quads );
+    }
+    return quads;
+}
+
 // We're reading in way too many entities here to mess around with creating sub-objects and
 // seeking around in them, so we're using the json streaming API.
 submap *mapbuffer::unserialize_submaps( const tripoint &p )
@@ -227,9 +306,18 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
     // Map the tripoint to the submap quad that stores it.
     const tripoint om_addr = sm_to_omt_copy( p );
 
-    using namespace std::placeholders;
-    if( !g->get_active_world()->read_map_quad( om_addr, std::bind( &mapbuffer::deserialize,
-            this, _1 ) ) ) {
+    const auto reader = [&]( std::istream & fin, const std::string & quad_path ) {
+        // Quads may be in either format, depending on the option at the time they were saved.
+        if( submap_binary::is_binary_quad( fin ) ) {
+            submap_binary::read_quad( fin, [&]( const tripoint & pos, std::unique_ptr<submap> sm ) {
+                add_loaded_submap( pos, sm );
+            } );
+        } else {
+            JsonIn jsin( fin, quad_path );
+            deserialize( jsin );
+        }
+    };
+    if( !g->get_active_world()->read_map_quad( om_addr, reader ) ) {
         // If it doesn't exist, trigger generating it.
         return nullptr;
     }
@@ -270,9 +358,17 @@ void mapbuffer::deserialize( JsonIn &jsin )
             }
         }
 
-        if( !add_submap( submap_coordinates, sm ) ) {
-            debugmsg( "submap %d,%d,%d was already loaded", submap_coordinates.x, submap_coordinates.y,
-                      submap_coordinates.z );
-        }
+        add_loaded_submap( submap_coordinates, sm );
+    }
+}
+
+void mapbuffer::add_loaded_submap( const tripoint &p, std::unique_ptr<submap> &sm )
+{
+    if( sm ) {
+        // Freshly loaded contents match the saved copy
+        sm->mark_saved();
+    }
+    if( !add_submap( p, sm ) ) {
+        debugmsg( "submap %d,%d,%d was already loaded", p.x, p.y, p.z );
     }
 }
@@ -10,6 +10,7 @@
 
 class submap;
 class JsonIn;
+struct rl_vec2d;
 
 /**
  * Store, buffer, save and load the entire world map.
@@ -71,15 +72,34 @@ class mapbuffer
             return submaps.contains( p );
         }
 
+        /**
+         * Ask the world to read ahead the saved quads that would enter the reality
+         * bubble if the map kept moving along @p heading.
+         * @param abs_sub Absolute submap position of the map's corner, see @ref map::get_abs_sub.
+         * @param heading Normalized direction of travel.
+         * @param tiles_per_turn Current speed, determines how far ahead to look.
+         * @param all_levels Also the other z-levels, after the one of @p abs_sub.
+         * @return The quads (in overmap terrain coordinates) that were asked for, closest first.
+         */
+        std::vector<tripoint> prefetch_ahead( const tripoint &abs_sub, const rl_vec2d &heading,
+                                              float tiles_per_turn, bool all_levels );
+
+        /** Number of quads actually written by the last @ref save. Unchanged quads are skipped. */
+        int get_num_quads_written() const {
+            return num_quads_written;
+        }
+
     private:
         // There's a very good reason this is private,
         // if not handled carefully, this can erase in-use submaps and crash the game.
         void remove_submap( tripoint addr );
         submap *unserialize_submaps( const tripoint &p );
         void deserialize( JsonIn &jsin );
+        void add_loaded_submap( const tripoint &p, std::unique_ptr<submap> &sm );
         void save_quad( const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
                         bool delete_after_save );
         submap_map_t submaps;
+        int num_quads_written = 0;
 };
 
 extern mapbuffer MAPBUFFER;
@@ -1304,6 +1304,16 @@ class mapgen_value
         Id get( const mapgendata &dat ) const {
             return source_->get( dat );
         }
+        /** The value, if it doesn't depend on parameters or chance. */
+        std::optional<Id> get_constant() const {
+            if( const id_source *constant = dynamic_cast<const id_source *>( source_.get() ) ) {
+                return constant->id;
+            }
+            if( dynamic_cast<const null_source *>( source_.get() ) ) {
+                return make_null_helper<Id> {}();
+            }
+            return std::nullopt;
+        }
         std::vector<StringId> all_possible_results( const mapgen_parameters &params ) const {
             return source_->all_possible_results( params );
         }
@@ -3652,6 +3662,56 @@ void jmapgen_objects::finalize()
     []( const jmapgen_obj & l, const jmapgen_obj & r ) {
         return l.second->phase() < r.second->phase();
     } );
+    compile();
+}
+
+void jmapgen_objects::compile()
+{
+    program.clear();
+    terrain_cells.clear();
+    furniture_cells.clear();
+    const auto emit = [this]( instruction::kind op, size_t index ) {
+        if( op != instruction::kind::object && !program.empty() && program.back().op == op ) {
+            program.back().count++;
+        } else {
+            program.push_back( { op, index, 1 } );
+        }
+    };
+    const auto is_fixed = []( const jmapgen_int & v ) {
+        return v.val == v.valmax;
+    };
+
+    for( size_t i = 0; i < objects.size(); i++ ) {
+        const jmapgen_place &where = objects[i].first;
+        const jmapgen_piece &what = *objects[i].second;
+        // Placing the same terrain or furniture on the same spot again changes nothing,
+        // so only whether it's placed at all matters.
+        if( is_fixed( where.x ) && is_fixed( where.y ) && is_fixed( where.repeat ) &&
+            is_fixed( what.repeat ) ) {
+            const point p( where.x.val, where.y.val );
+            const bool placed = std::max( where.repeat.val, what.repeat.val ) > 0;
+            if( const auto *ter = dynamic_cast<const jmapgen_terrain *>( &what ) ) {
+                if( const std::optional<ter_id> id = ter->id.get_constant() ) {
+                    if( placed && !id->id().is_null() ) {
+                        const ter_t &t = id->obj();
+                        emit( instruction::kind::terrain, terrain_cells.size() );
+                        terrain_cells.push_back( { p, *id, t.has_flag( "WALL" ), t.has_flag( "PLACE_ITEM" ) } );
+                    }
+                    continue;
+                }
+            }
+            if( const auto *furn = dynamic_cast<const jmapgen_furniture *>( &what ) ) {
+                if( const std::optional<furn_id> id = furn->id.get_constant() ) {
+                    if( placed && !id->id().is_null() ) {
+                        emit( instruction::kind::furniture, furniture_cells.size() );
+                        furniture_cells.push_back( { p, *id } );
+                    }
+                    continue;
+                }
+            }
+        }
+        emit( instruction::kind::object, i );
+    }
 }
 
 void jmapgen_objects::check( const std::string &oter_name,
@@ -3912,36 +3972,50 @@ void mapgen_function_json_nested::nest( const mapgendata &md, const point &offse
  */
 void jmapgen_objects::apply( const mapgendata &dat ) const
 {
-    for( auto &obj : objects ) {
-        const auto &where = obj.first;
-        const auto &what = *obj.second;
-        // The user will only specify repeat once in JSON, but it may get loaded both
-        // into the what and where in some cases--we just need the greater value of the two.
-        const int repeat = std::max( where.repeat.get(), what.repeat.get() );
-        for( int i = 0; i < repeat; i++ ) {
-            what.apply( dat, where.x, where.y );
-        }
-    }
+    apply( dat, point_zero );
 }
 
 void jmapgen_objects::apply( const mapgendata &dat, const point &offset ) const
 {
-    if( offset == point_zero ) {
-        // It's a bit faster
-        apply( dat );
-        return;
-    }
-
-    for( auto &obj : objects ) {
-        auto where = obj.first;
-        where.offset( -offset );
-
-        const auto &what = *obj.second;
-        // The user will only specify repeat once in JSON, but it may get loaded both
-        // into the what and where in some cases--we just need the greater value of the two.
-        const int repeat = std::max( where.repeat.get(), what.repeat.get() );
-        for( int i = 0; i < repeat; i++ ) {
-            what.apply( dat, where.x, where.y );
+    const int z = dat.m.get_abs_sub().z;
+    for( const instruction &ins : program ) {
+        switch( ins.op ) {
+            case instruction::kind::terrain:
+                for( size_t i = ins.first; i < ins.first + ins.count; i++ ) {
+                    const terrain_cell &cell = terrain_cells[i];
+                    const tripoint p( cell.p + offset, z );
+                    if( !dat.m.inbounds( p ) ) {
+                        continue;
+                    }
+                    dat.m.ter_set( p, cell.id );
+                    // Delete furniture if a wall was just placed over it.
+                    if( cell.wall ) {
+                        dat.m.furn_set( p, f_null );
+                        // and items, unless the wall has PLACE_ITEM flag indicating it stores things.
+                        if( !cell.keep_items ) {
+                            dat.m.i_clear( p );
+                        }
+                    }
+                }
+                break;
+            case instruction::kind::furniture:
+                for( size_t i = ins.first; i < ins.first + ins.count; i++ ) {
+                    const furniture_cell &cell = furniture_cells[i];
+                    dat.m.furn_set( cell.p + offset, cell.id );
+                }
+                break;
+            case instruction::kind::object: {
+                jmapgen_place where = objects[ins.first].first;
+                where.offset( -offset );
+                const jmapgen_piece &what = *objects[ins.first].second;
+                // The user will only specify repeat once in JSON, but it may get loaded both
+                // into the what and where in some cases--we just need the greater value of the two.
+                const int repeat = std::max( where.repeat.get(), what.repeat.get() );
+                for( int i = 0; i < repeat; i++ ) {
+                    what.apply( dat, where.x, where.y );
+                }
+                break;
+            }
         }
     }
 }
@@ -6325,6 +6399,7 @@ void map::add_spawn( const mtype_id &type, int count, const tripoint &p,
     }
     spawn_point tmp( type, count, offset, faction_id, mission_id, disposition, name );
     place_on_submap->spawns.push_back( tmp );
+    place_on_submap->mark_modified();
 }
 
 vehicle *map::add_vehicle( const vgroup_id &type, const tripoint &p, const units::angle dir,
@@ -6376,6 +6451,7 @@ vehicle *map::add_vehicle( const vproto_id &type, const tripoint &p, const units
         submap *place_on_submap = get_submap_at_grid( placed_vehicle->sm_pos );
         place_on_submap->vehicles.push_back( std::move( placed_vehicle_up ) );
         place_on_submap->is_uniform = false;
+        place_on_submap->mark_modified();
         invalidate_max_populated_zlev( p.z );
 
         auto &ch = get_cache( placed_vehicle->sm_pos.z );
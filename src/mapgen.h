@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -384,6 +385,39 @@ struct jmapgen_objects {
          */
         using jmapgen_obj = std::pair<jmapgen_place, shared_ptr_fast<const jmapgen_piece> >;
         std::vector<jmapgen_obj> objects;
+
+        /**
+         * @ref objects compiled by @ref finalize into what @ref apply runs.
+         * Terrain and furniture with a fixed id at a fixed position are lowered to plain
+         * cells, everything else is run through its jmapgen_piece.
+         */
+        struct instruction {
+            enum class kind : uint8_t {
+                terrain,
+                furniture,
+                object,
+            };
+            kind op;
+            /** Index of the first cell, or of the object. */
+            size_t first;
+            size_t count;
+        };
+        struct terrain_cell {
+            point p;
+            ter_id id;
+            /** Flags of @ref id that decide whether furniture and items under it are removed. */
+            bool wall;
+            bool keep_items;
+        };
+        struct furniture_cell {
+            point p;
+            furn_id id;
+        };
+        std::vector<instruction> program;
+        std::vector<terrain_cell> terrain_cells;
+        std::vector<furniture_cell> furniture_cells;
+        void compile();
+
         point m_offset;
         point mapgensize;
         point total_size;
@@ -0,0 +1,33 @@
+#include "memory_stream.h"
+
+memory_streambuf::memory_streambuf( std::string_view data )
+{
+    char *first = const_cast<char *>( data.data() );
+    setg( first, first, first + data.size() );
+}
+
+memory_streambuf::pos_type memory_streambuf::seekoff( off_type off, std::ios_base::seekdir dir,
+        std::ios_base::openmode which )
+{
+    if( !( which & std::ios_base::in ) ) {
+        return pos_type( off_type( -1 ) );
+    }
+    const char *base = dir == std::ios_base::beg ? eback() :
+                       dir == std::ios_base::end ? egptr() : gptr();
+    const off_type target = base - eback() + off;
+    if( target < 0 || target > egptr() - eback() ) {
+        return pos_type( off_type( -1 ) );
+    }
+    set_cursor( eback() + target );
+    return pos_type( target );
+}
+
+memory_streambuf::pos_type memory_streambuf::seekpos( pos_type pos, std::ios_base::openmode which )
+{
+    return seekoff( off_type( pos ), std::ios_base::beg, which );
+}
+
+memory_istream::memory_istream( std::string_view data ) : std::istream( nullptr ), buf( data )
+{
+    rdbuf( &buf );
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <istream>
+#include <streambuf>
+#include <string_view>
+
+/**
+ * Read-only stream buffer over memory owned by someone else, so data that is already
+ * in memory (a whole file, a decompressed blob) doesn't have to be copied into a
+ * std::istringstream first.
+ *
+ * @ref JsonIn recognizes it and reads the memory directly where it can, instead of
+ * going through the stream one character at a time.
+ */
+class memory_streambuf : public std::streambuf
+{
+    public:
+        explicit memory_streambuf( std::string_view data );
+
+        const char *begin() const {
+            return eback();
+        }
+        const char *cursor() const {
+            return gptr();
+        }
+        const char *end() const {
+            return egptr();
+        }
+        /** Moves the read position to @p p, which must be within the buffer. */
+        void set_cursor( const char *p ) {
+            setg( eback(), const_cast<char *>( p ), egptr() );
+        }
+
+    protected:
+        pos_type seekoff( off_type off, std::ios_base::seekdir dir,
+                          std::ios_base::openmode which ) override;
+        pos_type seekpos( pos_type pos, std::ios_base::openmode which ) override;
+};
+
+/** Input stream over a @ref memory_streambuf. The data must outlive the stream. */
+class memory_istream : public std::istream
+{
+    public:
+        explicit memory_istream( std::string_view data );
+
+    private:
+        memory_streambuf buf;
+};
@@ -15,6 +15,7 @@
 #include "avatar.h"
 #include "behavior.h"
 #include "bionics.h"
+#include "cached_options.h"
 #include "cata_utility.h"
 #include "creature_tracker.h"
 #include "debug.h"
@@ -333,11 +334,100 @@ float monster::rate_target( Creature &c, float best, bool smart ) const
     return FLT_MAX;
 }
 
-void monster::plan()
+template<typename OnHostile, typename OnNpc, typename OnEnemy>
+void monster::visit_plan_targets( OnHostile &&on_hostile, OnNpc &&on_npc,
+                                  OnEnemy &&on_enemy ) const
 {
-    ZoneScoped;
+    const bool docile = friendly != 0 && has_effect( effect_docile );
+    if( friendly != 0 && !docile ) {
+        const auto visit_hostile = [&]( monster & tmp ) {
+            if( tmp.friendly == 0 ) {
+                on_hostile( tmp );
+            }
+        };
+        if( has_flag( MF_PRIORITIZE_TARGETS ) ) {
+            for( monster &tmp : g->all_monsters() ) {
+                visit_hostile( tmp );
+            }
+        } else {
+            // `rate_target` rejects anything at or beyond the sight range without looking
+            for( const shared_ptr_fast<monster> &tmp : g->critter_tracker->find_in_radius( pos(),
+                    std::max( type->vision_day, type->vision_night ) ) ) {
+                visit_hostile( *tmp );
+            }
+        }
+    }
+
+    for( npc &who : g->all_npcs() ) {
+        const mf_attitude faction_att = faction.obj().attitude( who.get_monster_faction() );
+        if( faction_att != MFA_NEUTRAL && faction_att != MFA_FRIENDLY ) {
+            on_npc( who, faction_att );
+        }
+    }
 
+    if( friendly == 0 ) {
+        for( const auto &fac : g->critter_tracker->factions() ) {
+            const mf_attitude faction_att = faction.obj().attitude( fac.first );
+            if( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY ) {
+                continue;
+            }
+            for( const weak_ptr_fast<monster> &weak : fac.second ) {
+                if( const shared_ptr_fast<monster> shared = weak.lock() ) {
+                    on_enemy( *shared );
+                }
+            }
+        }
+    }
+}
+
+template<typename OnAlly>
+bool monster::visit_plan_allies( OnAlly &&on_ally ) const
+{
     const auto &factions = g->critter_tracker->factions();
+    const auto myfaction_iter = factions.find( friendly == 0 ? faction : mfaction_str_id( "player" ) );
+    if( myfaction_iter == factions.end() ) {
+        return false;
+    }
+    for( const weak_ptr_fast<monster> &weak : myfaction_iter->second ) {
+        if( const shared_ptr_fast<monster> shared = weak.lock() ) {
+            on_ally( *shared );
+        }
+    }
+    return true;
+}
+
+void monster::get_sight_targets( std::vector<const Creature *> &targets ) const
+{
+    if( has_effect( effect_ai_waiting ) ) {
+        return;
+    }
+
+    // Anything further is rejected by `rate_target` before looking, unless we rate targets by power
+    const int max_range = has_flag( MF_PRIORITIZE_TARGETS ) ? MAX_VIEW_DISTANCE :
+                          std::max( type->vision_day, type->vision_night );
+    // Sight to the player comes from the player's own vision, and `map::sees` is only needed between other creatures
+    const auto add_target = [&]( const Creature & c ) {
+        if( &c == this || c.is_hallucination() || ( !fov_3d && c.posz() != posz() ) ) {
+            return;
+        }
+        if( rl_dist( pos(), c.pos() ) <= max_range ) {
+            targets.push_back( &c );
+        }
+    };
+
+    visit_plan_targets( add_target, [&]( const npc & who, mf_attitude ) {
+        add_target( who );
+    }, add_target );
+
+    const bool group_morale = has_flag( MF_GROUP_MORALE ) && morale < type->morale;
+    if( group_morale || has_flag( MF_SWARMS ) ) {
+        visit_plan_allies( add_target );
+    }
+}
+
+void monster::plan()
+{
+    ZoneScoped;
 
     // Bots are more intelligent than most living stuff
     bool smart_planning = has_flag( MF_PRIORITIZE_TARGETS );
@@ -359,8 +449,13 @@ void monster::plan()
     bool swarms = has_flag( MF_SWARMS );
     auto mood = attitude();
 
+    if( waiting ) {
+        set_dest( pos() );
+        return;
+    }
+
     // If we can see the player, move toward them or flee, simpleminded animals are too dumb to follow the player.
-    if( friendly == 0 && sees( g->u ) && !waiting ) {
+    if( friendly == 0 && sees( g->u ) ) {
         dist = rate_target( g->u, dist, smart_planning );
         fleeing = fleeing || is_fleeing( g->u );
         target = &g->u;
@@ -402,30 +497,18 @@ void monster::plan()
                 }
             }
         }
-    } else if( friendly != 0 && !docile && !waiting ) {
-        for( monster &tmp : g->all_monsters() ) {
-            if( tmp.friendly == 0 ) {
-                float rating = rate_target( tmp, dist, smart_planning );
-                if( rating < dist ) {
-                    target = &tmp;
-                    dist = rating;
-                }
-            }
-        }
-    }
-
-    if( waiting ) {
-        set_dest( pos() );
-        return;
     }
 
     int valid_targets = ( target == nullptr ) ? 1 : 0;
-    for( npc &who : g->all_npcs() ) {
-        auto faction_att = faction.obj().attitude( who.get_monster_faction() );
-        if( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY ) {
-            continue;
+    const auto consider_hostile = [&]( monster & tmp ) {
+        float rating = rate_target( tmp, dist, smart_planning );
+        if( rating < dist ) {
+            target = &tmp;
+            dist = rating;
+            valid_targets = 0;
         }
-
+    };
+    const auto consider_npc = [&]( npc & who, const mf_attitude faction_att ) {
         float rating = rate_target( who, dist, smart_planning );
         bool fleeing_from = is_fleeing( who );
         if( rating == dist && ( fleeing || attitude( &who ) == MATT_ATTACK ) ) {
@@ -465,79 +548,57 @@ void monster::plan()
                 }
             }
         }
-    }
-
-    fleeing = fleeing || ( mood == MATT_FLEE );
-    if( friendly == 0 ) {
-        for( const auto &fac : factions ) {
-            auto faction_att = faction.obj().attitude( fac.first );
-            if( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY ) {
-                continue;
-            }
-
-            for( const weak_ptr_fast<monster> &weak : fac.second ) {
-                const shared_ptr_fast<monster> shared = weak.lock();
-                if( !shared ) {
-                    continue;
-                }
-                monster &mon = *shared;
-                float rating = rate_target( mon, dist, smart_planning );
-                if( rating == dist ) {
-                    ++valid_targets;
-                    if( one_in( valid_targets ) ) {
-                        target = &mon;
-                    }
-                }
-                if( rating < dist ) {
-                    target = &mon;
-                    dist = rating;
-                    valid_targets = 1;
-                }
-                if( rating <= 5 ) {
-                    anger += angers_hostile_near;
-                    morale -= fears_hostile_near;
-                }
+    };
+    const auto consider_enemy = [&]( monster & mon ) {
+        float rating = rate_target( mon, dist, smart_planning );
+        if( rating == dist ) {
+            ++valid_targets;
+            if( one_in( valid_targets ) ) {
+                target = &mon;
             }
         }
-    }
+        if( rating < dist ) {
+            target = &mon;
+            dist = rating;
+            valid_targets = 1;
+        }
+        if( rating <= 5 ) {
+            anger += angers_hostile_near;
+            morale -= fears_hostile_near;
+        }
+    };
+    visit_plan_targets( consider_hostile, consider_npc, consider_enemy );
+    fleeing = fleeing || ( mood == MATT_FLEE );
 
     // Friendly monsters here
     // Avoid for hordes of same-faction stuff or it could get expensive
-    const auto actual_faction = friendly == 0 ? faction : mfaction_str_id( "player" );
-    const auto &myfaction_iter = factions.find( actual_faction );
-    if( myfaction_iter == factions.end() ) {
+    swarms = swarms && target == nullptr; // Only swarm if we have no target
+    const auto consider_ally = [&]( monster & mon ) {
+        float rating = rate_target( mon, dist, smart_planning );
+        if( group_morale && rating <= 10 ) {
+            morale += 10 - rating;
+        }
+        if( swarms ) {
+            if( rating < 5 ) { // Too crowded here
+                wander_pos.x = posx() * rng( 1, 3 ) - mon.posx();
+                wander_pos.y = posy() * rng( 1, 3 ) - mon.posy();
+                wandf = 2;
+                target = nullptr;
+                // Swarm to the furthest ally you can see
+            } else if( rating < FLT_MAX && rating > dist && wandf <= 0 ) {
+                target = &mon;
+                dist = rating;
+            }
+        }
+    };
+    if( ( group_morale || swarms ) && !visit_plan_allies( consider_ally ) ) {
+        const auto actual_faction = friendly == 0 ? faction : mfaction_str_id( "player" );
         DebugLog( DL::Error, DC::Game ) << disp_name() << " tried to find faction "
                                         << actual_faction.id().str()
                                         << " which wasn't loaded in game::monmove";
         swarms = false;
         group_morale = false;
     }
-    swarms = swarms && target == nullptr; // Only swarm if we have no target
-    if( group_morale || swarms ) {
-        for( const weak_ptr_fast<monster> &weak : myfaction_iter->second ) {
-            const shared_ptr_fast<monster> shared = weak.lock();
-            if( !shared ) {
-                continue;
-            }
-            monster &mon = *shared;
-            float rating = rate_target( mon, dist, smart_planning );
-            if( group_morale && rating <= 10 ) {
-                morale += 10 - rating;
-            }
-            if( swarms ) {
-                if( rating < 5 ) { // Too crowded here
-                    wander_pos.x = posx() * rng( 1, 3 ) - mon.posx();
-                    wander_pos.y = posy() * rng( 1, 3 ) - mon.posy();
-                    wandf = 2;
-                    target = nullptr;
-                    // Swarm to the furthest ally you can see
-                } else if( rating < FLT_MAX && rating > dist && wandf <= 0 ) {
-                    target = &mon;
-                    dist = rating;
-                }
-            }
-        }
-    }
 
     // Docile monsters should ignore targets, so place it after all possible ways target could be selected
     if( docile ) {
@@ -2768,14 +2768,16 @@ void monster::die( Creature *nkiller )
 
     if( anger_adjust != 0 || morale_adjust != 0 ) {
         int light = g->light_level( posz() );
-        for( monster &critter : g->all_monsters() ) {
-            if( !critter.type->same_species( *type ) ) {
+        // `map::sees` rejects anything further away than the light level anyway
+        for( const shared_ptr_fast<monster> &critter : g->critter_tracker->find_in_radius( pos(),
+                light ) ) {
+            if( !critter->type->same_species( *type ) ) {
                 continue;
             }
 
-            if( g->m.sees( critter.pos(), pos(), light ) ) {
-                critter.morale += morale_adjust;
-                critter.anger += anger_adjust;
+            if( g->m.sees( critter->pos(), pos(), light ) ) {
+                critter->morale += morale_adjust;
+                critter->anger += anger_adjust;
             }
         }
     }
@@ -3263,14 +3265,16 @@ void monster::on_hit( Creature *source, bodypart_id, dealt_projectile_attack con
 
     if( anger_adjust != 0 || morale_adjust != 0 ) {
         int light = g->light_level( posz() );
-        for( monster &critter : g->all_monsters() ) {
-            if( !critter.type->same_species( *type ) ) {
+        // `map::sees` rejects anything further away than the light level anyway
+        for( const shared_ptr_fast<monster> &critter : g->critter_tracker->find_in_radius( pos(),
+                light ) ) {
+            if( !critter->type->same_species( *type ) ) {
                 continue;
             }
 
-            if( g->m.sees( critter.pos(), pos(), light ) ) {
-                critter.morale += morale_adjust;
-                critter.anger += anger_adjust;
+            if( g->m.sees( critter->pos(), pos(), light ) ) {
+                critter->morale += morale_adjust;
+                critter->anger += anger_adjust;
             }
         }
     }
@@ -230,6 +230,8 @@ class monster : public Creature, public location_visitable<monster>
 
         // How good of a target is given creature (checks for visibility)
         float rate_target( Creature &c, float best, bool smart = false ) const;
+        // Creatures @ref plan may check the line of sight to, so it can be worked out ahead of time
+        void get_sight_targets( std::vector<const Creature *> &targets ) const;
         void plan();
         void move(); // Actual movement
         void footsteps( const tripoint &p ); // noise made by movement
@@ -604,6 +606,22 @@ class monster : public Creature, public location_visitable<monster>
         std::vector<detached_ptr<item>> remove_corpse_components();
 
     private:
+        /**
+         * Calls the visitors with the creatures @ref plan rates as targets, in the order it rates
+         * them: hostile monsters if we're friendly, then NPCs, then monsters of other factions.
+         * NPCs and faction monsters only count if their faction isn't neutral or friendly to ours.
+         * @ref get_sight_targets goes through the same creatures, so the lines of sight worked
+         * out ahead of planning are the ones planning checks.
+         */
+        template<typename OnHostile, typename OnNpc, typename OnEnemy>
+        void visit_plan_targets( OnHostile &&on_hostile, OnNpc &&on_npc, OnEnemy &&on_enemy ) const;
+        /**
+         * Calls the visitor with the monsters whose morale and swarming we share.
+         * Returns false if their faction isn't loaded.
+         */
+        template<typename OnAlly>
+        bool visit_plan_allies( OnAlly &&on_ally ) const;
+
         void process_trigger( mon_trigger trig, int amount );
         void process_trigger( mon_trigger trig, const std::function<int()> &amount_func );
 
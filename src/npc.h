@@ -1393,6 +1393,41 @@ double melee_value( const Character &who, const item &weap );
 /** Evaluate unarmed melee value */
 double unarmed_value( const Character &who );
 
+/**
+ * What the AI of every NPC looks at regardless of who is looking, gathered once per turn
+ * by game::monmove instead of once per NPC or once per item considered.
+ * Creatures are kept alive by the snapshot but may die during the turn, so check that.
+ */
+struct world_snapshot {
+    struct monster_threat {
+        shared_ptr_fast<monster> critter;
+        /** Same as npc::evaluate_enemy for the monster. */
+        float threat;
+    };
+    /** Followers of the player that are loaded. */
+    std::vector<shared_ptr_fast<npc>> followers;
+    /** Monsters that were alive when the snapshot was taken. */
+    std::vector<monster_threat> monsters;
+
+    static shared_ptr_fast<const world_snapshot> take();
+};
+
+/** Makes @ref snapshot return the given one while this exists. */
+class world_snapshot_scope
+{
+    public:
+        explicit world_snapshot_scope( shared_ptr_fast<const world_snapshot> snapshot );
+        ~world_snapshot_scope();
+        world_snapshot_scope( const world_snapshot_scope & ) = delete;
+        world_snapshot_scope &operator=( const world_snapshot_scope & ) = delete;
+
+    private:
+        shared_ptr_fast<const world_snapshot> previous;
+};
+
+/** The snapshot of the current turn, or a freshly taken one outside of game::monmove. */
+shared_ptr_fast<const world_snapshot> snapshot();
+
 } // namespace npc_ai
 
 // disable toggled weapon cbms
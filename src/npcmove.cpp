@@ -22,6 +22,7 @@
 #include "character_id.h"
 #include "clzones.h"
 #include "coordinate_conversions.h"
+#include "creature_tracker.h"
 #include "damage.h"
 #include "debug.h"
 #include "dispersion.h"
@@ -335,12 +336,16 @@ std::vector<sphere> npc::find_dangerous_explosives() const
     return result;
 }
 
+static float evaluate_monster( const monster &mon )
+{
+    float diff = static_cast<float>( mon.type->difficulty );
+    return std::min( diff, NPC_DANGER_MAX );
+}
+
 float npc::evaluate_enemy( const Creature &target ) const
 {
     if( target.is_monster() ) {
-        const monster &mon = dynamic_cast<const monster &>( target );
-        float diff = static_cast<float>( mon.type->difficulty );
-        return std::min( diff, NPC_DANGER_MAX );
+        return evaluate_monster( dynamic_cast<const monster &>( target ) );
     } else if( target.is_npc() || target.is_player() ) {
         return std::min( character_danger( dynamic_cast<const player &>( target ) ),
                          NPC_DANGER_MAX );
@@ -349,6 +354,43 @@ float npc::evaluate_enemy( const Creature &target ) const
     }
 }
 
+static shared_ptr_fast<const npc_ai::world_snapshot> current_snapshot;
+
+shared_ptr_fast<const npc_ai::world_snapshot> npc_ai::world_snapshot::take()
+{
+    shared_ptr_fast<world_snapshot> ret = make_shared_fast<world_snapshot>();
+    for( const character_id &id : g->get_follower_list() ) {
+        if( shared_ptr_fast<npc> guy = overmap_buffer.find_npc( id ) ) {
+            ret->followers.push_back( std::move( guy ) );
+        }
+    }
+    const std::vector<shared_ptr_fast<monster>> &monsters =
+        g->critter_tracker->get_monsters_list();
+    ret->monsters.reserve( monsters.size() );
+    for( const shared_ptr_fast<monster> &critter : monsters ) {
+        if( !critter->is_dead() ) {
+            ret->monsters.push_back( { critter, evaluate_monster( *critter ) } );
+        }
+    }
+    return ret;
+}
+
+npc_ai::world_snapshot_scope::world_snapshot_scope(
+    shared_ptr_fast<const world_snapshot> snapshot ) : previous( std::move( current_snapshot ) )
+{
+    current_snapshot = std::move( snapshot );
+}
+
+npc_ai::world_snapshot_scope::~world_snapshot_scope()
+{
+    current_snapshot = std::move( previous );
+}
+
+shared_ptr_fast<const npc_ai::world_snapshot> npc_ai::snapshot()
+{
+    return current_snapshot ? current_snapshot : world_snapshot::take();
+}
+
 static bool too_close( const tripoint &critter_pos, const tripoint &ally_pos, const int def_radius )
 {
     return rl_dist( critter_pos, ally_pos ) <= def_radius;
@@ -458,7 +500,12 @@ void npc::assess_danger()
         }
     }
 
-    for( const monster &critter : g->all_monsters() ) {
+    const shared_ptr_fast<const npc_ai::world_snapshot> world_state = npc_ai::snapshot();
+    for( const npc_ai::world_snapshot::monster_threat &entry : world_state->monsters ) {
+        const monster &critter = *entry.critter;
+        if( critter.is_dead() ) {
+            continue;
+        }
         auto att = critter.attitude_to( *this );
         if( att == Attitude::A_FRIENDLY ) {
             ai_cache.friends.emplace_back( g->shared_from( critter ) );
@@ -470,7 +517,7 @@ void npc::assess_danger()
         if( !sees( critter ) ) {
             continue;
         }
-        float critter_threat = evaluate_enemy( critter );
+        float critter_threat = entry.threat;
         // warn and consider the odds for distant enemies
         int dist = rl_dist( pos(), critter.pos() );
         if( ( is_enemy() || !critter.friendly ) ) {
@@ -2780,24 +2827,17 @@ void npc::find_item()
         return;
     }
 
+    const shared_ptr_fast<const npc_ai::world_snapshot> world_state = npc_ai::snapshot();
+    const std::vector<shared_ptr_fast<npc>> &followers = world_state->followers;
     const auto consider_item =
-        [&wanted, &best_value, whitelisting, volume_allowed, weight_allowed, this]
+        [&wanted, &best_value, &followers, whitelisting, volume_allowed, weight_allowed, this]
     ( const item & it, const tripoint & p ) {
         if( it.made_of( LIQUID ) ) {
             // Don't even consider liquids.
             return;
         }
-        std::vector<npc *> followers;
-        for( auto &elem : g->get_follower_list() ) {
-            shared_ptr_fast<npc> npc_to_get = overmap_buffer.find_npc( elem );
-            if( !npc_to_get ) {
-                continue;
-            }
-            npc *npc_to_add = npc_to_get.get();
-            followers.push_back( npc_to_add );
-        }
         Character &player_character = get_player_character();
-        for( auto &elem : followers ) {
+        for( const shared_ptr_fast<npc> &elem : followers ) {
             if( !it.is_owned_by( *this, true ) && ( player_character.sees( this->pos() ) ||
                                                     player_character.sees( wanted_item_pos ) ||
                                                     elem->sees( this->pos() ) || elem->sees( wanted_item_pos ) ) ) {
@@ -1423,6 +1423,21 @@ void options_manager::add_options_general()
 
     get_option( "AUTOSAVE_MINUTES" ).setPrerequisite( "AUTOSAVE" );
 
+    add( "ASYNC_SAVE", general, translate_marker( "Background map saving" ),
+         translate_marker( "If true, compression and database writes of map data are done on a background thread while saving, shortening the pause.  Only affects worlds using the compressed save format." ),
+         true
+       );
+
+    add( "BINARY_MAP_SAVES", general, translate_marker( "Binary map format" ),
+         translate_marker( "If true, map data is saved in a compact binary format that loads faster.  If false, it is saved as JSON, which is easier to inspect.  Both formats can always be loaded." ),
+         true
+       );
+
+    add( "PREFETCH_MAPS", general, translate_marker( "Map prefetching" ),
+         translate_marker( "If true, saved map data ahead of the player's direction of travel is read on a background thread, and areas never visited before are generated a little at a time, reducing stutter when moving fast." ),
+         true
+       );
+
     add_empty_line();
 
     add( "AUTO_NOTES", general, translate_marker( "Auto notes" ),
@@ -2013,6 +2028,11 @@ void options_manager::add_options_graphics()
          true, COPT_CURSES_HIDE
        );
 
+    add( "DIRTY_REGION_RENDERING", graphics, translate_marker( "Redraw only changed tiles" ),
+         translate_marker( "If true, the map is kept in a separate buffer and only tiles that look different from the previous frame are drawn again.  Reduces CPU and GPU use while little is happening, but uses more video memory.  Has no effect on isometric tilesets." ),
+         false, COPT_CURSES_HIDE
+       );
+
     add_empty_line();
 
     add( "PIXEL_MINIMAP", graphics, translate_marker( "Pixel minimap" ),
@@ -2320,6 +2340,30 @@ void options_manager::add_options_debug()
          translate_marker( "Use legacy pathfinding" ),
          translate_marker( "If true, opt out of new pathfinding in favor of legacy one. This makes pathfinding mods not work." ),
          false );
+
+    add( "HIERARCHICAL_PATHFINDING", debug,
+         translate_marker( "Hierarchical pathfinding" ),
+         translate_marker( "If true, long routes are first planned between submaps and only then resolved tile by tile.  Much faster for far or unreachable destinations, but routes may be slightly longer than optimal." ),
+         true );
+
+    get_option( "HIERARCHICAL_PATHFINDING" ).setPrerequisite( "USE_LEGACY_PATHFINDING", "false" );
+
+    add( "INCREMENTAL_LIGHTMAP", debug,
+         translate_marker( "Incremental lightmap" ),
+         translate_marker( "If true, light cast by sources that didn't move or change is reused between turns instead of being cast again.  Much faster with many fires or lamps around." ),
+         true );
+
+    add( "LIGHTMAP_CROSS_CHECK", debug,
+         translate_marker( "Cross-check incremental lightmap" ),
+         translate_marker( "If true, every incremental lightmap is compared against a full rebuild and differences are reported.  Very slow, only for finding lighting bugs." ),
+         false );
+
+    get_option( "LIGHTMAP_CROSS_CHECK" ).setPrerequisite( "INCREMENTAL_LIGHTMAP" );
+
+    add( "PARALLEL_MONSTER_PLANNING", debug,
+         translate_marker( "Parallel monster sight checks" ),
+         translate_marker( "If true, lines of sight monsters need for planning are worked out on all cores before monsters move.  Results don't depend on the number of cores, so games stay reproducible." ),
+         true );
 }
 
 void options_manager::add_options_world_default()
@@ -42,6 +42,7 @@
 #include "string_formatter.h"
 #include "string_id.h"
 #include "string_utils.h"
+#include "thread_pool.h"
 #include "translations.h"
 #include "vehicle.h"
 #include "vehicle_part.h"
@@ -134,7 +135,7 @@ void overmapbuffer::generate( const std::vector<point_abs_om> &locs )
             fix_npcs( *map );
             return std::make_pair( loc, std::move( map ) );
         };
-        async_data.push_back( std::async( std::launch::async, gen_func ) );
+        async_data.push_back( cata::get_thread_pool().submit( gen_func ) );
     }
 
     auto popup = make_shared_fast<throbber_popup>( _( "Please wait..." ) );
@@ -1225,12 +1226,20 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all_async( const tripoint_abs_
     std::deque<std::future<std::vector<tripoint_abs_omt>>> tasks;
 
     std::vector<tripoint_abs_omt> find_result;
-    int free_tasks = std::max( 1u, std::thread::hardware_concurrency() - 1 );
+    // Keep the number of searched overmaps in flight small, so we can stop early
+    // once enough results came in.
+    int free_tasks = cata::get_thread_pool().num_threads();
+    cata::cancellation_token cancel_remaining;
     auto try_finish_task = []( std::future<std::vector<tripoint_abs_omt>> &task,
     std::vector<tripoint_abs_omt> &dst, omt_find_params params ) -> bool {
         if( task.wait_for( std::chrono::milliseconds( 0 ) ) == std::future_status::ready )
         {
-            auto task_result = task.get();
+            std::vector<tripoint_abs_omt> task_result;
+            try {
+                task_result = task.get();
+            } catch( const cata::task_cancelled & ) {
+                // Enough results were found before this one started.
+            }
 
             if( !params.max_results.has_value() ||
                 dst.size() < static_cast<size_t>( params.max_results.value() ) ) {
@@ -1258,6 +1267,7 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all_async( const tripoint_abs_
             }
             if( params.max_results.has_value() &&
                 find_result.size() >= static_cast<uint64_t>( params.max_results.value() ) ) {
+                cancel_remaining.cancel();
                 break;
             }
         }
@@ -1305,7 +1315,10 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all_async( const tripoint_abs_
             return result;
         };
 
-        auto task = std::async( std::launch::async, task_func, task_om, std::move( task_omts ) );
+        auto task = cata::get_thread_pool().submit( [task_func, task_om,
+                    task_omts = std::move( task_omts )]() mutable {
+            return task_func( task_om, std::move( task_omts ) );
+        }, cata::task_priority::high, cancel_remaining );
 
         tasks.push_back( std::move( task ) );
 
@@ -45,6 +45,7 @@
 #include "overmapbuffer.h"
 #include "path_info.h"
 #include "panels_utility.h"
+#include "perf_telemetry.h"
 #include "player.h"
 #include "pldata.h"
 #include "point.h"
@@ -1967,6 +1968,29 @@ static void draw_ai_goal( const avatar &u, const catacurses::window &w )
     wnoutrefresh( w );
 }
 
+static void draw_turn_timings( const avatar &, const catacurses::window &w )
+{
+    werase( w );
+    const std::vector<telemetry::turn_record> records = telemetry::history();
+    // NOLINTNEXTLINE(cata-use-named-point-constants)
+    mvwprintz( w, point( 1, 0 ), c_light_gray, "%-15s %7s %7s", "ms", "last", "avg" );
+    for( size_t i = 0; i < telemetry::num_phases; i++ ) {
+        double last = 0.0;
+        double avg = 0.0;
+        if( !records.empty() ) {
+            last = records.back().micros[i] / 1000.0;
+            for( const telemetry::turn_record &rec : records ) {
+                avg += rec.micros[i];
+            }
+            avg /= records.size() * 1000.0;
+        }
+        const nc_color col = last > 2 * avg + 1.0 ? c_yellow : c_white;
+        mvwprintz( w, point( 1, i + 1 ), col, "%-15s %7.2f %7.2f",
+                   telemetry::phase_name( static_cast<telemetry::phase>( i ) ), last, avg );
+    }
+    wnoutrefresh( w );
+}
+
 static void draw_location_classic( const avatar &u, const catacurses::window &w )
 {
     werase( w );
@@ -2191,6 +2215,7 @@ static std::vector<window_panel> initialize_default_classic_panels()
                       default_render, true );
 #endif // TILES
     ret.emplace_back( draw_ai_goal, "AI Needs", 1, 44, false );
+    ret.emplace_back( draw_turn_timings, "Turn Timings", telemetry::num_phases + 1, 44, false );
     return ret;
 }
 
@@ -2220,6 +2245,7 @@ static std::vector<window_panel> initialize_default_compact_panels()
                       default_render, true );
 #endif // TILES
     ret.emplace_back( draw_ai_goal, "AI Needs", 1, 32, false );
+    ret.emplace_back( draw_turn_timings, "Turn Timings", telemetry::num_phases + 1, 32, false );
 
     return ret;
 }
@@ -2256,6 +2282,7 @@ static std::vector<window_panel> initialize_default_label_narrow_panels()
                       default_render, true );
 #endif // TILES
     ret.emplace_back( draw_ai_goal, "AI Needs", 1, 32, false );
+    ret.emplace_back( draw_turn_timings, "Turn Timings", telemetry::num_phases + 1, 32, false );
 
     return ret;
 }
@@ -2293,6 +2320,7 @@ static std::vector<window_panel> initialize_default_label_panels()
                       default_render, true );
 #endif // TILES
     ret.emplace_back( draw_ai_goal, "AI Needs", 1, 44, false );
+    ret.emplace_back( draw_turn_timings, "Turn Timings", telemetry::num_phases + 1, 44, false );
 
     return ret;
 }
@@ -233,6 +233,10 @@ std::string PATH_INFO::safemode()
 {
     return config_dir_value + "safemode.json";
 }
+std::string PATH_INFO::data_check_stamps()
+{
+    return config_dir_value + "data_check_stamps.txt";
+}
 std::string PATH_INFO::distraction()
 {
     return config_dir_value + "distraction.json";
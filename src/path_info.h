@@ -37,6 +37,7 @@ std::string moddir();
 std::string options();
 std::string panel_options();
 std::string safemode();
+std::string data_check_stamps();
 std::string distraction();
 std::string savedir();
 std::string sokoban();
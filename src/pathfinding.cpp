@@ -9,6 +9,7 @@
 #include "game.h"
 #include "map.h"
 #include "map_iterator.h"
+#include "options.h"
 #include "point.h"
 #include "submap.h"
 #include "trap.h"
@@ -30,6 +31,24 @@ static constexpr std::array<point, 8> DIRS_2D = {
 
 decltype( Pathfinding::d_maps_store ) Pathfinding::d_maps_store = {};
 decltype( Pathfinding::d_maps ) Pathfinding::d_maps = {};
+decltype( Pathfinding::dirty_tiles ) Pathfinding::dirty_tiles = {};
+decltype( Pathfinding::dirty_levels ) Pathfinding::dirty_levels = {};
+decltype( Pathfinding::d_maps_abs_sub ) Pathfinding::d_maps_abs_sub = {};
+decltype( Pathfinding::turn_counter ) Pathfinding::turn_counter = 0;
+decltype( Pathfinding::cluster_graphs ) Pathfinding::cluster_graphs = {};
+decltype( Pathfinding::cluster_versions ) Pathfinding::cluster_versions = {};
+decltype( Pathfinding::level_versions ) Pathfinding::level_versions = {};
+decltype( Pathfinding::cluster_graphs_abs_sub ) Pathfinding::cluster_graphs_abs_sub = {};
+decltype( Pathfinding::cluster_graph_uses ) Pathfinding::cluster_graph_uses = 0;
+
+// Maps not routed on for this many turns are dropped
+static constexpr int MAX_IDLE_TURNS = 10;
+// At most this many maps are kept between turns, least recently used ones are dropped first
+static constexpr size_t MAX_KEPT_D_MAPS = 32;
+// At most this many portal graphs are kept, least recently used ones are dropped first
+static constexpr size_t MAX_CLUSTER_GRAPHS = 16;
+// Routes at least this far apart [chebyshev] are searched on the portal graph first
+static constexpr int HIERARCHICAL_MIN_DIST = 2 * SEEX;
 decltype( Pathfinding::z_area ) Pathfinding::z_area = {};
 decltype( Pathfinding::z_caches ) Pathfinding::z_caches = {};
 decltype( Pathfinding::z_caches_open_air ) Pathfinding::z_caches_open_air = {};
@@ -47,6 +66,246 @@ static constexpr bool is_inf( float x )
     return x == INFINITY;
 }
 
+// Vehicle walls can forbid stepping from `cur` into `next` even if both tiles are passable
+static bool is_step_allowed( const tripoint &cur, const vehicle *cur_vehicle,
+                             const tripoint &next, const vehicle *next_vehicle )
+{
+    const bool is_valid_to_step_into_veh =
+        cur_vehicle == nullptr ?
+        true :
+        cur_vehicle->allowed_move( cur_vehicle->tripoint_to_mount( cur ),
+                                   cur_vehicle->tripoint_to_mount( next ) );
+
+    const bool is_valid_to_step_out_of_veh =
+        next_vehicle == nullptr ?
+        true :
+        next_vehicle->allowed_move( next_vehicle->tripoint_to_mount( cur ),
+                                    next_vehicle->tripoint_to_mount( next ) );
+
+    return is_valid_to_step_into_veh && is_valid_to_step_out_of_veh;
+}
+
+// g-cost of tile `cur` when stepping from it in direction `dir`, INFINITY if it can't be gone through
+static float step_g_cost( const map &here, const PathfindingSettings &settings,
+                          const tripoint &cur, const vehicle *cur_vehicle, const int cur_vehicle_part,
+                          const vehicle *next_vehicle, const point &dir, const bool care_about_mobs )
+{
+    const bool can_open_doors = !is_inf( settings.door_open_cost );
+    const bool can_bash = settings.bash_strength_val > 0;
+    const bool can_climb = !is_inf( settings.climb_cost );
+    const bool care_about_traps = settings.trap_cost > 0;
+
+    const maptile &new_tile = here.maptile_at_internal( cur );
+    const auto &terrain = new_tile.get_ter_t();
+    const auto &furniture = new_tile.get_furn_t();
+    const int move_cost = here.move_cost_internal( furniture, terrain, cur_vehicle, cur_vehicle_part );
+
+    float cur_g = 0.0;
+    bool is_diag = dir.x != 0 && dir.y != 0;
+    cur_g += is_diag ? 0.75 * move_cost : 0.5 * move_cost;
+    cur_g *= settings.move_cost_coeff;
+
+    // First, check for trivial cost modifiers
+    const bool is_rough = move_cost > 2;
+    const bool is_sharp = terrain.has_flag( TFLAG_SHARP );
+
+    cur_g += is_rough ? settings.rough_terrain_cost : 0.0;
+    cur_g += is_sharp ? settings.sharp_terrain_cost : 0.0;
+
+    if( care_about_mobs && !std::isinf( cur_g ) ) {
+        cur_g += g->critter_at( cur, true ) != nullptr ?
+                 settings.mob_presence_penalty :
+                 0.0;
+    }
+
+    if( care_about_traps && !std::isinf( cur_g ) ) {
+        const trap &maybe_ter_trap = terrain.trap.obj();
+        const trap &maybe_trap = maybe_ter_trap.is_benign() ? new_tile.get_trap_t() : maybe_ter_trap;
+        const bool is_trap = !maybe_trap.is_benign();
+
+        cur_g += is_trap ? settings.trap_cost : 0.0;
+    }
+
+    const bool is_ledge = here.has_zlevels() && terrain.has_flag( TFLAG_NO_FLOOR );
+    if( is_ledge && !settings.can_fly ) {
+        // Close ledges outright for non-fliers
+        cur_g += INFINITY;
+    }
+
+    // And finally, add a potential field extra
+    if( !std::isinf( cur_g ) && settings.extra_g_costs.contains( cur.xy() ) ) {
+        cur_g += settings.extra_g_costs.at( cur.xy() );
+    }
+
+    const bool is_passable = move_cost != 0;
+    float obstacle_g = 0;
+    // Calculate the cost for if the tile is impassable
+    while( !std::isinf( cur_g ) && !is_passable ) {
+        const bool is_climbable = terrain.has_flag( TFLAG_CLIMBABLE );
+        const bool is_door = !!terrain.open || !!furniture.open;
+
+        if( cur_vehicle != nullptr ) {
+            // Do processing for possible vehicle first
+            const auto vpobst = vpart_position( const_cast<vehicle &>( *cur_vehicle ),
+                                                cur_vehicle_part ).obstacle_at_part();
+            const int obstacle_part = vpobst ? vpobst->part_index() : -1;
+
+            if( obstacle_part >= 0 ) {
+                int _;
+                const bool part_is_door = cur_vehicle->part_flag( obstacle_part, VPFLAG_OPENABLE );
+                const bool part_opens_from_inside = cur_vehicle->part_flag( obstacle_part, "OPENCLOSE_INSIDE" );
+                const bool is_cur_point_inside = here.veh_at_internal( cur, _ ) == next_vehicle;
+                const bool valid_to_open = part_is_door && ( part_opens_from_inside ? is_cur_point_inside : true );
+
+                if( can_open_doors && valid_to_open ) {
+                    obstacle_g = settings.door_open_cost;
+                } else if( can_bash ) {
+                    const int htd = cur_vehicle->hits_to_destroy( obstacle_part,
+                                    settings.bash_strength_val * settings.bash_strength_quanta,
+                                    DT_BASH );
+                    if( htd == 0 ) {
+                        // We cannot bash down this part
+                        obstacle_g = INFINITY;
+                        break;
+                    } else {
+                        obstacle_g = settings.bash_cost * htd;
+                        break;
+                    }
+                } else {
+                    // Nothing can be done here. Don't bother with other checks since vehicles take priority.
+                    obstacle_g = INFINITY;
+                    break;
+                }
+            }
+        }
+
+        if( is_climbable && can_climb ) {
+            obstacle_g = settings.climb_cost;
+            break;
+        }
+        if( is_door && can_open_doors ) {
+            // Doors that can only be open from the inside
+            const bool door_opens_from_inside = terrain.has_flag( "OPENCLOSE_INSIDE" ) ||
+                                                furniture.has_flag( "OPENCLOSE_INSIDE" );
+            const bool is_cur_point_inside = !here.is_outside( cur );
+            const bool valid_to_open = door_opens_from_inside ? is_cur_point_inside : true;
+            if( valid_to_open ) {
+                obstacle_g = settings.door_open_cost;
+                break;
+            }
+        }
+        if( can_bash ) {
+            // Time to consider bashing the obstacle
+            const int rating = here.bash_rating_internal(
+                                   settings.bash_strength_val * settings.bash_strength_quanta,
+                                   furniture, terrain, false, cur_vehicle, cur_vehicle_part );
+            if( rating > 1 ) {
+                obstacle_g = ( 10. / rating ) * settings.bash_cost;
+                break;
+            } else if( rating == 1 ) {
+                // Rating == 1 implies it will take at least 10 turns to take this down
+                //   which is a very unattractive target
+                //   so we'll penalize this target a lot
+                obstacle_g = 30.0 * settings.bash_cost * settings.bash_cost * settings.bash_cost;
+                break;
+            }
+
+        }
+        // We can do nothing anymore, close the tile
+        obstacle_g = INFINITY;
+        break;
+    }
+
+    cur_g += obstacle_g;
+
+    return cur_g;
+}
+
+using ClusterCosts = std::array<float, SEEX * SEEY>;
+using ClusterParents = std::array<int, SEEX * SEEY>;
+
+static point cluster_of( const point &p )
+{
+    return point( p.x / SEEX, p.y / SEEY );
+}
+static point cluster_origin( const point &cluster )
+{
+    return point( cluster.x * SEEX, cluster.y * SEEY );
+}
+static bool is_in_cluster( const point &origin, const point &p )
+{
+    return origin.x <= p.x && p.x < origin.x + SEEX && origin.y <= p.y && p.y < origin.y + SEEY;
+}
+static int cluster_index( const point &origin, const point &p )
+{
+    return ( p.x - origin.x ) + ( p.y - origin.y ) * SEEX;
+}
+static point cluster_point( const point &origin, const int index )
+{
+    return origin + point( index % SEEX, index / SEEX );
+}
+
+// Cost of going from `cur` to adjacent `next`, INFINITY if we can't
+static float step_cost( const map &here, const PathfindingSettings &settings,
+                        const tripoint &cur, const tripoint &next, const bool include_critters )
+{
+    int cur_vehicle_part;
+    const vehicle *cur_vehicle = here.veh_at_internal( cur, cur_vehicle_part );
+    int _;
+    const vehicle *next_vehicle = here.veh_at_internal( next, _ );
+    if( !is_step_allowed( cur, cur_vehicle, next, next_vehicle ) ) {
+        return INFINITY;
+    }
+    const bool care_about_mobs = include_critters && settings.mob_presence_penalty > 0;
+    return step_g_cost( here, settings, cur, cur_vehicle, cur_vehicle_part, next_vehicle,
+                        cur.xy() - next.xy(), care_about_mobs );
+}
+
+// Dijkstra confined to the cluster at `origin`.
+// Forward it finds the cost from `source` to every tile, `reverse` the cost from every tile to `source`.
+// Stops once `stop_at` is settled, if given.
+static void cluster_dijkstra( const map &here, const PathfindingSettings &settings, const int z,
+                              const point &origin, const point &source, const bool reverse,
+                              const bool include_critters, ClusterCosts &costs, ClusterParents &parents,
+                              const std::optional<point> &stop_at = std::nullopt )
+{
+    using Frontier = std::priority_queue<std::pair<float, point>, std::vector<std::pair<float, point>>, pair_greater_cmp_first>;
+
+    costs.fill( INFINITY );
+    parents.fill( -1 );
+    costs[cluster_index( origin, source )] = 0.0;
+
+    Frontier frontier;
+    frontier.emplace( 0.0, source );
+    while( !frontier.empty() ) {
+        const auto [cost, p] = frontier.top();
+        frontier.pop();
+        const int p_index = cluster_index( origin, p );
+        if( cost > costs[p_index] ) {
+            continue;
+        }
+        if( stop_at && *stop_at == p ) {
+            return;
+        }
+        for( const point &dir : DIRS_2D ) {
+            const point next = p + dir;
+            if( !is_in_cluster( origin, next ) ) {
+                continue;
+            }
+            const float edge = reverse ?
+                               step_cost( here, settings, tripoint( next, z ), tripoint( p, z ), include_critters ) :
+                               step_cost( here, settings, tripoint( p, z ), tripoint( next, z ), include_critters );
+            const float next_cost = cost + edge;
+            const int next_index = cluster_index( origin, next );
+            if( next_cost < costs[next_index] ) {
+                costs[next_index] = next_cost;
+                parents[next_index] = p_index;
+                frontier.emplace( next_cost, next );
+            }
+        }
+    }
+}
+
 // PathfindingSettings impls
 int PathfindingSettings::z_move_type() const
 {
@@ -180,6 +439,10 @@ Pathfinding::State &Pathfinding::tile_state_at( const point &p )
 {
     return this->tile_state[p.y + 1][p.x + 1];
 }
+int8_t &Pathfinding::parent_at( const point &p )
+{
+    return this->parent_map[p.y][p.x];
+}
 /// Pathfinding: d-map wide changes
 void Pathfinding::produce_d_map( point dest, int z, PathfindingSettings settings )
 {
@@ -197,37 +460,263 @@ void Pathfinding::produce_d_map( point dest, int z, PathfindingSettings settings
 
     Pathfinding::d_maps.push_back( std::move( d_map ) );
 }
+void Pathfinding::recycle_d_map( std::unique_ptr<Pathfinding> &d_map )
+{
+    d_map->reset();
+    Pathfinding::d_maps_store.push_back( std::move( d_map ) );
+}
 void Pathfinding::clear_d_maps()
 {
     for( auto &map : Pathfinding::d_maps ) {
-        map->reset_maps();
-        map->reset_tile_state();
-        map->unbiased_frontier.clear();
-        map->forbidden_moves.clear();
-        map->domain = Pathfinding::MapDomain::RELATIVE_DOMAIN;
-        map->is_explored = false;
-        Pathfinding::d_maps_store.push_back( std::move( map ) );
+        Pathfinding::recycle_d_map( map );
     }
     Pathfinding::d_maps.clear();
     Pathfinding::cached_closest_z_changes.clear();
+    for( auto &tiles : Pathfinding::dirty_tiles ) {
+        tiles.clear();
+    }
+    Pathfinding::dirty_levels.reset();
+}
+void Pathfinding::end_turn()
+{
+    Pathfinding::apply_invalidations();
+    Pathfinding::turn_counter++;
+
+    // Critters move around every turn, so maps pricing them in are only good for the turn they were made on
+    for( auto &map : Pathfinding::d_maps ) {
+        const bool is_idle = Pathfinding::turn_counter - map->last_used_turn > MAX_IDLE_TURNS;
+        if( is_idle || map->settings.mob_presence_penalty > 0 ) {
+            Pathfinding::recycle_d_map( map );
+        }
+    }
+    std::erase( Pathfinding::d_maps, nullptr );
+
+    if( Pathfinding::d_maps.size() > MAX_KEPT_D_MAPS ) {
+        std::ranges::stable_sort( Pathfinding::d_maps, []( const auto & lhs, const auto & rhs ) {
+            return lhs->last_used_turn > rhs->last_used_turn;
+        } );
+        for( size_t i = MAX_KEPT_D_MAPS; i < Pathfinding::d_maps.size(); i++ ) {
+            Pathfinding::recycle_d_map( Pathfinding::d_maps[i] );
+        }
+        Pathfinding::d_maps.resize( MAX_KEPT_D_MAPS );
+    }
+
+    Pathfinding::cached_closest_z_changes.clear();
+}
+void Pathfinding::invalidate_tile( const tripoint &p )
+{
+    if( p.x < 0 || p.x >= MAPSIZE_X || p.y < 0 || p.y >= MAPSIZE_Y ||
+        p.z < -OVERMAP_DEPTH || p.z > OVERMAP_HEIGHT ) {
+        return;
+    }
+    const point cluster = cluster_of( p.xy() );
+    Pathfinding::cluster_versions[p.z + OVERMAP_DEPTH][cluster.y * MAPSIZE + cluster.x]++;
+
+    // Maps made from now on will see the change anyway
+    if( !Pathfinding::d_maps.empty() ) {
+        Pathfinding::dirty_tiles[p.z + OVERMAP_DEPTH].insert( p.xy() );
+    }
+}
+void Pathfinding::invalidate_level( const int z )
+{
+    if( z < -OVERMAP_DEPTH || z > OVERMAP_HEIGHT ) {
+        return;
+    }
+    Pathfinding::level_versions[z + OVERMAP_DEPTH]++;
+
+    if( !Pathfinding::d_maps.empty() ) {
+        Pathfinding::dirty_levels.set( z + OVERMAP_DEPTH );
+    }
+}
+void Pathfinding::apply_invalidations()
+{
+    const tripoint abs_sub = get_map().get_abs_sub();
+    if( abs_sub != Pathfinding::d_maps_abs_sub ) {
+        // All local coords moved, nothing can be kept
+        Pathfinding::d_maps_abs_sub = abs_sub;
+        Pathfinding::clear_d_maps();
+        return;
+    }
+
+    for( auto &map : Pathfinding::d_maps ) {
+        const size_t level = map->z + OVERMAP_DEPTH;
+        const std::unordered_set<point> &changed = Pathfinding::dirty_tiles[level];
+        if( Pathfinding::dirty_levels.test( level ) || changed.contains( map->dest ) ||
+            ( !changed.empty() && !map->repair( changed ) ) ) {
+            Pathfinding::recycle_d_map( map );
+        }
+    }
+    std::erase( Pathfinding::d_maps, nullptr );
+
+    for( auto &tiles : Pathfinding::dirty_tiles ) {
+        tiles.clear();
+    }
+    Pathfinding::dirty_levels.reset();
+}
+void Pathfinding::reset()
+{
+    this->reset_maps();
+    this->reset_tile_state();
+    this->unbiased_frontier.clear();
+    this->forbidden_moves.clear();
+    this->domain = Pathfinding::MapDomain::RELATIVE_DOMAIN;
+    this->is_explored = false;
 }
 void Pathfinding::reset_maps()
 {
+    // Every tile touched during expansion is in the modify set, so past a full map's worth
+    //   of entries it is cheaper to wipe the arrays outright
+    if( this->map_modify_set.size() >= static_cast<size_t>( MAPSIZE_X * MAPSIZE_Y ) ) {
+        for( auto &row : this->p_map ) {
+            row.fill( 0.0 );
+        }
+        for( auto &row : this->g_map ) {
+            row.fill( 0.0 );
+        }
+        for( auto &row : this->parent_map ) {
+            row.fill( 0 );
+        }
+        this->map_modify_set.clear();
+        return;
+    }
+
     this->p_at( this->dest ) = 0.0;
     this->g_at( this->dest ) = 0.0;
+    this->parent_at( this->dest ) = 0;
 
     for( const point &p : this->map_modify_set ) {
         this->p_at( p ) = 0.0;
         this->g_at( p ) = 0.0;
+        this->parent_at( p ) = 0;
     }
     this->map_modify_set.clear();
 }
-void Pathfinding::reset_tile_state()
+bool Pathfinding::repair( const std::unordered_set<point> &changed )
 {
-    this->tile_state_at( this->dest ) = State::UNVISITED;
+    // Relative domain maps rebuild their tile states on every search anyway
+    if( this->domain == MapDomain::RELATIVE_DOMAIN ) {
+        for( const point &p : changed ) {
+            this->g_at( p ) = 0.0;
+        }
+        return true;
+    }
+
+    // A tile that got cheaper can shorten routes to tiles that were settled long ago,
+    //   anywhere on the map. Only a full rebuild finds those.
+    const map &here = get_map();
+    for( const point &p : changed ) {
+        const State state = this->tile_state_at( p );
+        if( state != State::ACCESSIBLE && state != State::IMPASSABLE ) {
+            continue;
+        }
+        const bool was_forbidden = std::ranges::any_of( this->forbidden_moves,
+        [&p]( const std::pair<point, point> &move ) {
+            return move.first == p || move.second == p;
+        } );
+        if( was_forbidden ) {
+            return false;
+        }
+        const int8_t parent = this->parent_at( p );
+        if( parent == 0 ) {
+            continue;
+        }
+        const point &dir = DIRS_2D[parent - 1];
+        const tripoint cur( p, this->z );
+        const tripoint next( p - dir, this->z );
+        int cur_part;
+        const vehicle *cur_vehicle = here.veh_at_internal( cur, cur_part );
+        int _;
+        const vehicle *next_vehicle = here.veh_at_internal( next, _ );
+        const float new_g = is_step_allowed( cur, cur_vehicle, next, next_vehicle ) ?
+                            step_g_cost( here, this->settings, cur, cur_vehicle, cur_part, next_vehicle, dir,
+                                         this->settings.mob_presence_penalty > 0 ) :
+                            INFINITY;
+        if( new_g < this->g_at( p ) ) {
+            return false;
+        }
+    }
+
+    // g-values only depend on the tile itself
+    for( const point &p : changed ) {
+        this->g_at( p ) = 0.0;
+    }
 
-    for( const point &p : this->tile_state_modify_set ) {
+    // Collect changed tiles and everything whose p-value was derived through them
+    std::unordered_set<point> stale;
+    std::vector<point> stack;
+    for( const point &p : changed ) {
+        if( this->tile_state_at( p ) == State::UNVISITED ) {
+            // Nothing was derived from it yet
+            continue;
+        }
+        stale.insert( p );
+        stack.push_back( p );
+    }
+    if( stale.empty() ) {
+        return true;
+    }
+
+    while( !stack.empty() ) {
+        const point p = stack.back();
+        stack.pop_back();
+
+        for( const point &dir : DIRS_2D ) {
+            const point child = p + dir;
+            if( !this->in_bounds( child ) || stale.contains( child ) ) {
+                continue;
+            }
+            const int8_t parent = this->parent_at( child );
+            if( parent == 0 || child - DIRS_2D[parent - 1] != p ) {
+                continue;
+            }
+            stale.insert( child );
+            stack.push_back( child );
+        }
+    }
+
+    for( const point &p : stale ) {
         this->tile_state_at( p ) = State::UNVISITED;
+        this->p_at( p ) = 0.0;
+        this->g_at( p ) = 0.0;
+        this->parent_at( p ) = 0;
+    }
+    std::erase_if( this->forbidden_moves, [&stale]( const std::pair<point, point> &move ) {
+        return stale.contains( move.first ) || stale.contains( move.second );
+    } );
+
+    // Expansion resumes from the untouched tiles bordering the reset area
+    std::erase_if( this->unbiased_frontier, [&stale]( const point & p ) {
+        return stale.contains( p );
+    } );
+    std::unordered_set<point> frontier( this->unbiased_frontier.begin(),
+                                        this->unbiased_frontier.end() );
+    for( const point &p : stale ) {
+        for( const point &dir : DIRS_2D ) {
+            const point next = p + dir;
+            if( !this->in_bounds( next ) || stale.contains( next ) ) {
+                continue;
+            }
+            if( this->tile_state_at( next ) == State::ACCESSIBLE && frontier.insert( next ).second ) {
+                this->unbiased_frontier.push_back( next );
+            }
+        }
+    }
+
+    this->is_explored = false;
+    return true;
+}
+void Pathfinding::reset_tile_state()
+{
+    if( this->tile_state_modify_set.size() >= static_cast<size_t>( MAPSIZE_X * MAPSIZE_Y ) ) {
+        for( auto &row : this->tile_state ) {
+            row.fill( State::UNVISITED );
+        }
+    } else {
+        this->tile_state_at( this->dest ) = State::UNVISITED;
+
+        for( const point &p : this->tile_state_modify_set ) {
+            this->tile_state_at( p ) = State::UNVISITED;
+        }
     }
 
     this->tile_state_modify_set.clear();
@@ -528,11 +1017,7 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
     std::unordered_set<point> culled_frontier;
     ExpansionOutcome result = ExpansionOutcome::UNSET;
 
-    const bool can_open_doors = !is_inf( this->settings.door_open_cost );
-    const bool can_bash = this->settings.bash_strength_val > 0;
-    const bool can_climb = !is_inf( this->settings.climb_cost );
     const bool care_about_mobs = this->settings.mob_presence_penalty > 0;
-    const bool care_about_traps = this->settings.trap_cost > 0;
     const map &here = get_map();
 
     while( !biased_frontier.empty() ) {
@@ -565,7 +1050,8 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
         const vehicle *next_vehicle;
         next_vehicle = here.veh_at_internal( next_point_with_z, _ );
 
-        for( const point &dir : DIRS_2D ) {
+        for( size_t dir_index = 0; dir_index < DIRS_2D.size(); dir_index++ ) {
+            const point &dir = DIRS_2D[dir_index];
             // It's cur_point because we're working backwards from destination
             const point cur_point = next_point + dir;
             const tripoint cur_point_with_z = tripoint( cur_point, this->z );
@@ -582,161 +1068,23 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
             const vehicle *cur_vehicle;
             cur_vehicle = here.veh_at_internal( cur_point_with_z, cur_vehicle_part );
 
-            {
-                bool is_move_valid = true;
-
-                const bool is_valid_to_step_into_veh =
-                    cur_vehicle == nullptr ?
-                    true :
-                    cur_vehicle->allowed_move( cur_vehicle->tripoint_to_mount( cur_point_with_z ),
-                                               cur_vehicle->tripoint_to_mount( next_point_with_z ) );
-
-                const bool is_valid_to_step_out_of_veh =
-                    next_vehicle == nullptr ?
-                    true :
-                    next_vehicle->allowed_move( next_vehicle->tripoint_to_mount( cur_point_with_z ),
-                                                next_vehicle->tripoint_to_mount( next_point_with_z ) );
-
-                is_move_valid &= is_valid_to_step_into_veh;
-                is_move_valid &= is_valid_to_step_out_of_veh;
-
-                if( !is_move_valid ) {
-                    this->forbidden_moves.emplace( cur_point, next_point );
-                    continue;
-                }
+            if( !is_step_allowed( cur_point_with_z, cur_vehicle, next_point_with_z, next_vehicle ) ) {
+                this->forbidden_moves.emplace( cur_point, next_point );
+                continue;
             }
 
-            const maptile &new_tile = here.maptile_at_internal( cur_point_with_z );
-            const auto &terrain = new_tile.get_ter_t();
-            const auto &furniture = new_tile.get_furn_t();
-            const int move_cost = here.move_cost_internal( furniture, terrain, cur_vehicle, cur_vehicle_part );
-
             float cur_g = this->g_at( cur_point );
             // May be false for relative search, so we'll reuse g-values there
             const bool is_g_calc_needed = cur_g == 0.0;
 
             if( is_g_calc_needed ) {
-                bool is_diag = dir.x != 0 && dir.y != 0;
-                cur_g += is_diag ? 0.75 * move_cost : 0.5 * move_cost;
-                cur_g *= this->settings.move_cost_coeff;
-
-                // First, check for trivial cost modifiers
-                const bool is_rough = move_cost > 2;
-                const bool is_sharp = terrain.has_flag( TFLAG_SHARP );
-
-                cur_g += is_rough ? this->settings.rough_terrain_cost : 0.0;
-                cur_g += is_sharp ? this->settings.sharp_terrain_cost : 0.0;
-
-                if( care_about_mobs && !std::isinf( cur_g ) ) {
-                    cur_g += g->critter_at( cur_point_with_z, true ) != nullptr ?
-                             this->settings.mob_presence_penalty :
-                             0.0;
-                }
-
-                if( care_about_traps && !std::isinf( cur_g ) ) {
-                    const trap &maybe_ter_trap = terrain.trap.obj();
-                    const trap &maybe_trap = maybe_ter_trap.is_benign() ? new_tile.get_trap_t() : maybe_ter_trap;
-                    const bool is_trap = !maybe_trap.is_benign();
-
-                    cur_g += is_trap ? this->settings.trap_cost : 0.0;
-                }
-
-                const bool is_ledge = here.has_zlevels() && terrain.has_flag( TFLAG_NO_FLOOR );
-                if( is_ledge && !this->settings.can_fly ) {
-                    // Close ledges outright for non-fliers
-                    cur_g += INFINITY;
-                }
-
-                // And finally, add a potential field extra
-                if( !std::isinf( cur_g ) && this->settings.extra_g_costs.contains( cur_point ) ) {
-                    cur_g += this->settings.extra_g_costs.at( cur_point );
-                }
-
-                const bool is_passable = move_cost != 0;
-                float obstacle_g = 0;
-                // Calculate the cost for if the tile is impassable
-                while( !std::isinf( cur_g ) && !is_passable ) {
-                    const bool is_climbable = terrain.has_flag( TFLAG_CLIMBABLE );
-                    const bool is_door = !!terrain.open || !!furniture.open;
-
-                    if( cur_vehicle != nullptr ) {
-                        // Do processing for possible vehicle first
-                        const auto vpobst = vpart_position( const_cast<vehicle &>( *cur_vehicle ),
-                                                            cur_vehicle_part ).obstacle_at_part();
-                        const int obstacle_part = vpobst ? vpobst->part_index() : -1;
-
-                        if( obstacle_part >= 0 ) {
-                            int _;
-                            const bool part_is_door = cur_vehicle->part_flag( obstacle_part, VPFLAG_OPENABLE );
-                            const bool part_opens_from_inside = cur_vehicle->part_flag( obstacle_part, "OPENCLOSE_INSIDE" );
-                            const bool is_cur_point_inside = here.veh_at_internal( cur_point_with_z, _ ) == next_vehicle;
-                            const bool valid_to_open = part_is_door && ( part_opens_from_inside ? is_cur_point_inside : true );
-
-                            if( can_open_doors && valid_to_open ) {
-                                obstacle_g = this->settings.door_open_cost;
-                            } else if( can_bash ) {
-                                const int htd = cur_vehicle->hits_to_destroy( obstacle_part,
-                                                this->settings.bash_strength_val * this->settings.bash_strength_quanta,
-                                                DT_BASH );
-                                if( htd == 0 ) {
-                                    // We cannot bash down this part
-                                    obstacle_g = INFINITY;
-                                    break;
-                                } else {
-                                    obstacle_g = this->settings.bash_cost * htd;
-                                    break;
-                                }
-                            } else {
-                                // Nothing can be done here. Don't bother with other checks since vehicles take priority.
-                                obstacle_g = INFINITY;
-                                break;
-                            }
-                        }
-                    }
-
-                    if( is_climbable && can_climb ) {
-                        obstacle_g = this->settings.climb_cost;
-                        break;
-                    }
-                    if( is_door && can_open_doors ) {
-                        // Doors that can only be open from the inside
-                        const bool door_opens_from_inside = terrain.has_flag( "OPENCLOSE_INSIDE" ) ||
-                                                            furniture.has_flag( "OPENCLOSE_INSIDE" );
-                        const bool is_cur_point_inside = !here.is_outside( cur_point );
-                        const bool valid_to_open = door_opens_from_inside ? is_cur_point_inside : true;
-                        if( valid_to_open ) {
-                            obstacle_g = this->settings.door_open_cost;
-                            break;
-                        }
-                    }
-                    if( can_bash ) {
-                        // Time to consider bashing the obstacle
-                        const int rating = here.bash_rating_internal(
-                                               this->settings.bash_strength_val * this->settings.bash_strength_quanta,
-                                               furniture, terrain, false, cur_vehicle, cur_vehicle_part );
-                        if( rating > 1 ) {
-                            obstacle_g = ( 10. / rating ) * this->settings.bash_cost;
-                            break;
-                        } else if( rating == 1 ) {
-                            // Rating == 1 implies it will take at least 10 turns to take this down
-                            //   which is a very unattractive target
-                            //   so we'll penalize this target a lot
-                            obstacle_g = 30.0 * this->settings.bash_cost * this->settings.bash_cost * this->settings.bash_cost;
-                            break;
-                        }
-
-                    }
-                    // We can do nothing anymore, close the tile
-                    obstacle_g = INFINITY;
-                    break;
-                }
-
-                cur_g += obstacle_g;
-
+                cur_g = step_g_cost( here, this->settings, cur_point_with_z, cur_vehicle, cur_vehicle_part,
+                                     next_vehicle, dir, care_about_mobs );
                 this->g_at( cur_point ) = cur_g;
             }
 
             this->p_at( cur_point ) = this->get_f_unbiased( next_point );
+            this->parent_at( cur_point ) = static_cast<int8_t>( dir_index + 1 );
 
             // Reintroduce this point into frontier unless the tile is closed
             if( is_inf( cur_g ) ) {
@@ -792,6 +1140,348 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
 }
 
 
+/// Pathfinding: hierarchical routes
+Pathfinding::ClusterGraph &Pathfinding::get_cluster_graph( const int z,
+        const PathfindingSettings &settings )
+{
+    const tripoint abs_sub = get_map().get_abs_sub();
+    if( abs_sub != Pathfinding::cluster_graphs_abs_sub ) {
+        // All local coords moved
+        Pathfinding::cluster_graphs.clear();
+        Pathfinding::cluster_graphs_abs_sub = abs_sub;
+    }
+
+    const uint32_t level_version = Pathfinding::level_versions[z + OVERMAP_DEPTH];
+    auto it = std::ranges::find_if( Pathfinding::cluster_graphs, [z, &settings]( const auto & graph ) {
+        return graph->z == z && graph->settings == settings;
+    } );
+    if( it != Pathfinding::cluster_graphs.end() && ( *it )->level_version != level_version ) {
+        Pathfinding::cluster_graphs.erase( it );
+        it = Pathfinding::cluster_graphs.end();
+    }
+    if( it == Pathfinding::cluster_graphs.end() ) {
+        if( Pathfinding::cluster_graphs.size() >= MAX_CLUSTER_GRAPHS ) {
+            Pathfinding::cluster_graphs.erase( std::ranges::min_element( Pathfinding::cluster_graphs, {},
+            []( const auto & graph ) {
+                return graph->last_used;
+            } ) );
+        }
+        std::unique_ptr<ClusterGraph> graph = std::make_unique<ClusterGraph>();
+        graph->z = z;
+        graph->settings = settings;
+        graph->level_version = level_version;
+        Pathfinding::cluster_graphs.push_back( std::move( graph ) );
+        it = Pathfinding::cluster_graphs.end() - 1;
+    }
+
+    ( *it )->last_used = ++Pathfinding::cluster_graph_uses;
+    return **it;
+}
+Pathfinding::Cluster &Pathfinding::get_cluster( ClusterGraph &graph, const point &cluster )
+{
+    const auto &versions = Pathfinding::cluster_versions[graph.z + OVERMAP_DEPTH];
+    const auto version_at = [&versions]( const point & c ) -> uint32_t {
+        if( c.x < 0 || c.x >= MAPSIZE || c.y < 0 || c.y >= MAPSIZE )
+        {
+            return 0;
+        }
+        return versions[c.y * MAPSIZE + c.x];
+    };
+    std::array<uint32_t, 9> cur_versions = {};
+    cur_versions[0] = version_at( cluster );
+    for( size_t i = 0; i < eight_adjacent_offsets.size(); i++ ) {
+        cur_versions[i + 1] = version_at( cluster + eight_adjacent_offsets[i] );
+    }
+
+    Cluster &result = graph.clusters[cluster.y * MAPSIZE + cluster.x];
+    if( !result.is_built || result.versions != cur_versions ) {
+        Pathfinding::build_cluster( graph, cluster );
+        result.versions = cur_versions;
+        result.is_built = true;
+    }
+    return result;
+}
+std::vector<std::pair<point, point>> Pathfinding::find_portals( const int z,
+                                  const PathfindingSettings &settings, const point &cluster, const point &dir )
+{
+    const map &here = get_map();
+    const point origin = cluster_origin( cluster );
+    const auto can_cross = [&]( const point & ours, const point & theirs ) {
+        return !is_inf( step_cost( here, settings, tripoint( ours, z ), tripoint( theirs, z ), false ) ) &&
+               !is_inf( step_cost( here, settings, tripoint( theirs, z ), tripoint( ours, z ), false ) );
+    };
+    // Diagonal neighbours only touch at a corner, a single diagonal step
+    if( dir == point_south_east || dir == point_north_east ) {
+        const point corner = origin + point( SEEX - 1, dir == point_south_east ? SEEY - 1 : 0 );
+        if( can_cross( corner, corner + dir ) ) {
+            return { { corner, corner + dir } };
+        }
+        return {};
+    }
+
+    // Tiles along our side of the border, walking along it
+    const point first = dir == point_east ? origin + point( SEEX - 1, 0 ) : origin + point( 0, SEEY - 1 );
+    const point along = dir == point_east ? point_south : point_east;
+    const int length = dir == point_east ? SEEY : SEEX;
+
+    std::vector<bool> is_straight_crossable( length );
+    for( int i = 0; i < length; i++ ) {
+        const point ours = first + along * i;
+        is_straight_crossable[i] = can_cross( ours, ours + dir );
+    }
+
+    std::vector<std::pair<point, point>> result;
+    // Tiles of a straight run connect along the border on both sides, one portal stands for all of them.
+    //   A diagonal step next to a run enters or leaves that run, so only diagonal steps between two
+    //   uncrossable tiles need portals of their own. Together they cover every way across the border.
+    for( int i = 0; i + 1 < length; i++ ) {
+        if( is_straight_crossable[i] || is_straight_crossable[i + 1] ) {
+            continue;
+        }
+        const point ours = first + along * i;
+        const point ours_next = ours + along;
+        if( can_cross( ours, ours_next + dir ) ) {
+            result.emplace_back( ours, ours_next + dir );
+        }
+        if( can_cross( ours_next, ours + dir ) ) {
+            result.emplace_back( ours_next, ours + dir );
+        }
+    }
+
+    int run_start = -1;
+    for( int i = 0; i <= length; i++ ) {
+        const bool is_crossable = i < length && is_straight_crossable[i];
+        if( is_crossable && run_start < 0 ) {
+            run_start = i;
+        } else if( !is_crossable && run_start >= 0 ) {
+            const point ours = first + along * ( ( run_start + i - 1 ) / 2 );
+            result.emplace_back( ours, ours + dir );
+            run_start = -1;
+        }
+    }
+    return result;
+}
+void Pathfinding::build_cluster( ClusterGraph &graph, const point &cluster )
+{
+    const map &here = get_map();
+    Cluster &target = graph.clusters[cluster.y * MAPSIZE + cluster.x];
+    target.nodes.clear();
+
+    const auto node_at = [&target]( const point & p ) -> ClusterNode & {
+        for( ClusterNode &node : target.nodes )
+        {
+            if( node.pos == p ) {
+                return node;
+            }
+        }
+        target.nodes.push_back( ClusterNode{ .pos = p, .edges = {} } );
+        return target.nodes.back();
+    };
+    const auto add_portal = [&]( const point & ours, const point & theirs ) {
+        const float cost = step_cost( here, graph.settings, tripoint( ours, graph.z ),
+                                      tripoint( theirs, graph.z ), false );
+        node_at( ours ).edges.emplace_back( theirs, cost );
+    };
+
+    // Portals are found from the north-west cluster of each pair, so both sides agree on them
+    if( cluster.x + 1 < MAPSIZE ) {
+        for( const auto &[ours, theirs] : find_portals( graph.z, graph.settings, cluster, point_east ) ) {
+            add_portal( ours, theirs );
+        }
+    }
+    if( cluster.y + 1 < MAPSIZE ) {
+        for( const auto &[ours, theirs] : find_portals( graph.z, graph.settings, cluster, point_south ) ) {
+            add_portal( ours, theirs );
+        }
+    }
+    if( cluster.x > 0 ) {
+        for( const auto &[theirs, ours] : find_portals( graph.z, graph.settings, cluster + point_west,
+                point_east ) ) {
+            add_portal( ours, theirs );
+        }
+    }
+    if( cluster.y > 0 ) {
+        for( const auto &[theirs, ours] : find_portals( graph.z, graph.settings, cluster + point_north,
+                point_south ) ) {
+            add_portal( ours, theirs );
+        }
+    }
+    // Corner crossings, found from the western cluster of each pair
+    if( cluster.x + 1 < MAPSIZE && cluster.y + 1 < MAPSIZE ) {
+        for( const auto &[ours, theirs] : find_portals( graph.z, graph.settings, cluster,
+                point_south_east ) ) {
+            add_portal( ours, theirs );
+        }
+    }
+    if( cluster.x + 1 < MAPSIZE && cluster.y > 0 ) {
+        for( const auto &[ours, theirs] : find_portals( graph.z, graph.settings, cluster,
+                point_north_east ) ) {
+            add_portal( ours, theirs );
+        }
+    }
+    if( cluster.x > 0 && cluster.y > 0 ) {
+        for( const auto &[theirs, ours] : find_portals( graph.z, graph.settings, cluster + point_north_west,
+                point_south_east ) ) {
+            add_portal( ours, theirs );
+        }
+    }
+    if( cluster.x > 0 && cluster.y + 1 < MAPSIZE ) {
+        for( const auto &[theirs, ours] : find_portals( graph.z, graph.settings, cluster + point_south_west,
+                point_north_east ) ) {
+            add_portal( ours, theirs );
+        }
+    }
+
+    const point origin = cluster_origin( cluster );
+    ClusterCosts costs;
+    ClusterParents parents;
+    for( ClusterNode &node : target.nodes ) {
+        cluster_dijkstra( here, graph.settings, graph.z, origin, node.pos, false, false, costs, parents );
+        for( const ClusterNode &other : target.nodes ) {
+            const float cost = costs[cluster_index( origin, other.pos )];
+            if( &other != &node && !is_inf( cost ) ) {
+                node.edges.emplace_back( other.pos, cost );
+            }
+        }
+    }
+}
+std::optional<std::vector<tripoint>> Pathfinding::get_route_hierarchical(
+                                      const point from, const point to, const int z,
+                                      const PathfindingSettings &path_settings,
+                                      const RouteSettings &route_settings )
+{
+    using Frontier = std::priority_queue<val_pair, std::vector<val_pair>, pair_greater_cmp_first>;
+
+    const map &here = get_map();
+    ClusterGraph &graph = Pathfinding::get_cluster_graph( z, path_settings );
+
+    const point from_cluster = cluster_of( from );
+    const point from_origin = cluster_origin( from_cluster );
+    const point to_cluster = cluster_of( to );
+    const point to_origin = cluster_origin( to_cluster );
+
+    // `from` and `to` join the graph as temporary nodes
+    ClusterCosts from_costs;
+    ClusterCosts to_costs;
+    ClusterParents parents;
+    cluster_dijkstra( here, path_settings, z, from_origin, from, false, false, from_costs, parents );
+    cluster_dijkstra( here, path_settings, z, to_origin, to, true, false, to_costs, parents );
+
+    const auto for_each_edge = [&]( const point & p, const auto & visit ) {
+        const point p_cluster = cluster_of( p );
+        if( p == from ) {
+            for( const ClusterNode &node : Pathfinding::get_cluster( graph, from_cluster ).nodes ) {
+                visit( node.pos, from_costs[cluster_index( from_origin, node.pos )] );
+            }
+            if( p_cluster == to_cluster ) {
+                visit( to, from_costs[cluster_index( from_origin, to )] );
+            }
+        }
+        for( const ClusterNode &node : Pathfinding::get_cluster( graph, p_cluster ).nodes ) {
+            if( node.pos != p ) {
+                continue;
+            }
+            for( const auto &[next, cost] : node.edges ) {
+                visit( next, cost );
+            }
+        }
+        if( p_cluster == to_cluster ) {
+            visit( to, to_costs[cluster_index( to_origin, p )] );
+        }
+    };
+
+    // A* over the portals. Flat ground costs `move_cost_coeff` per step, so that times chebyshev distance never overestimates.
+    const auto h = [&]( const point & p ) {
+        return path_settings.move_cost_coeff * square_dist( p, to );
+    };
+    std::unordered_map<point, float> best;
+    std::unordered_map<point, point> came_from;
+    Frontier frontier;
+    best[from] = 0.0;
+    frontier.emplace( h( from ), from );
+    bool is_found = false;
+    while( !frontier.empty() ) {
+        const auto [f, p] = frontier.top();
+        frontier.pop();
+        const float p_cost = best[p];
+        if( f > p_cost + h( p ) ) {
+            continue;
+        }
+        if( p == to ) {
+            is_found = true;
+            break;
+        }
+        for_each_edge( p, [&]( const point & next, const float cost ) {
+            if( is_inf( cost ) ) {
+                return;
+            }
+            const float next_cost = p_cost + cost;
+            auto it = best.find( next );
+            if( it == best.end() || next_cost < it->second ) {
+                best[next] = next_cost;
+                came_from[next] = p;
+                frontier.emplace( next_cost + h( next ), next );
+            }
+        } );
+    }
+    if( !is_found ) {
+        // Portals cover every crossing between tiles that can be left, so the exact search won't do better.
+        //   A target that can't be left, like a wall to bash, may still be entered from another cluster.
+        const auto can_leave = [&]( const point & p ) {
+            return std::ranges::any_of( DIRS_2D, [&]( const point & dir ) {
+                return here.inbounds( tripoint( p + dir, z ) ) &&
+                       !is_inf( step_cost( here, path_settings, tripoint( p, z ), tripoint( p + dir, z ), false ) );
+            } );
+        };
+        if( can_leave( from ) && can_leave( to ) ) {
+            return std::vector<tripoint>();
+        }
+        return std::nullopt;
+    }
+
+    std::vector<point> waypoints;
+    for( point p = to; p != from; p = came_from[p] ) {
+        waypoints.push_back( p );
+    }
+    waypoints.push_back( from );
+    std::ranges::reverse( waypoints );
+
+    // Resolve each leg into tiles. Crossing a border is a single step, the rest stays inside one cluster.
+    const bool include_critters = path_settings.mob_presence_penalty > 0;
+    std::vector<tripoint> result;
+    result.emplace_back( from, z );
+    ClusterCosts costs;
+    for( size_t i = 1; i < waypoints.size(); i++ ) {
+        const point leg_from = waypoints[i - 1];
+        const point leg_to = waypoints[i];
+        const point leg_cluster = cluster_of( leg_from );
+        if( cluster_of( leg_to ) != leg_cluster ) {
+            result.emplace_back( leg_to, z );
+            continue;
+        }
+
+        const point origin = cluster_origin( leg_cluster );
+        cluster_dijkstra( here, path_settings, z, origin, leg_from, false, include_critters, costs, parents,
+                          leg_to );
+        if( is_inf( costs[cluster_index( origin, leg_to )] ) ) {
+            return std::nullopt;
+        }
+        const size_t leg_start = result.size();
+        for( int index = cluster_index( origin, leg_to ); index != cluster_index( origin, leg_from );
+             index = parents[index] ) {
+            result.emplace_back( cluster_point( origin, index ), z );
+        }
+        std::reverse( result.begin() + leg_start, result.end() );
+    }
+
+    const int chebyshev_distance = square_dist( from, to );
+    if( result.size() - 2 > route_settings.max_s_coeff * chebyshev_distance ) {
+        // Portal routes aren't optimal, the exact search may still fit
+        return std::nullopt;
+    }
+    return result;
+}
+
 std::vector<tripoint> Pathfinding::get_route_2d(
     const point from, const point to, const int z,
     const PathfindingSettings path_settings,
@@ -801,12 +1491,25 @@ std::vector<tripoint> Pathfinding::get_route_2d(
         return std::vector<tripoint> { tripoint( from, z ), tripoint( to, z ) };
     }
 
+    // Relative search domains depend on `from`, the portal graph can't honour them
+    const bool use_hierarchy = get_option<bool>( "HIERARCHICAL_PATHFINDING" ) &&
+                               !route_settings.is_relative_search_domain() &&
+                               square_dist( from, to ) >= HIERARCHICAL_MIN_DIST;
     auto d_map_it = std::ranges::find_if(
                         Pathfinding::d_maps,
     [&to, &path_settings, z]( auto & map ) {
         return map->dest == to && map->z == z && map->settings == path_settings;
     } );
 
+    // A d_map shared with other routes to `to` is cheaper to walk than searching the portals again
+    if( use_hierarchy && d_map_it == Pathfinding::d_maps.end() ) {
+        std::optional<std::vector<tripoint>> route = Pathfinding::get_route_hierarchical(
+                    from, to, z, path_settings, route_settings );
+        if( route.has_value() ) {
+            return *route;
+        }
+    }
+
     Pathfinding *d_map;
     if( d_map_it == Pathfinding::d_maps.end() ) {
         Pathfinding::produce_d_map( to, z, path_settings );
@@ -814,6 +1517,7 @@ std::vector<tripoint> Pathfinding::get_route_2d(
     } else {
         d_map = d_map_it->get();
     }
+    d_map->last_used_turn = Pathfinding::turn_counter;
 
     if( !d_map->is_in_limited_domain( from, from, route_settings ) ) {
         // This should only fail if max f-limit is failed
@@ -1078,6 +1782,9 @@ std::vector<tripoint> Pathfinding::route(
     here.clip_to_bounds( from );
     here.clip_to_bounds( to );
 
+    // Terrain may have changed since the maps were last used this turn
+    Pathfinding::apply_invalidations();
+
     PathfindingSettings path_settings = maybe_path_settings.has_value() ? *maybe_path_settings :
                                         PathfindingSettings();
     RouteSettings route_settings = maybe_route_settings.has_value() ? *maybe_route_settings :
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <array>
+#include <bitset>
+#include <cstdint>
 #include <cstring>
 #include <map>
 #include <memory>
@@ -215,9 +217,19 @@ class Pathfinding
         // Global state: allocated dijikstra d_maps. Pull to `d_maps` from here.
         static std::vector<std::unique_ptr<Pathfinding>> d_maps_store;
 
-        // Global state: memoized dijikstra d_maps. Transfer to `d_maps_store` every game turn.
+        // Global state: memoized dijikstra d_maps. Kept across turns and repaired where the map changed,
+        //   transferred to `d_maps_store` once unused for a while or no longer valid.
         static std::vector<std::unique_ptr<Pathfinding>> d_maps;
 
+        // Global state: tiles changed since `d_maps` were last repaired, per z-level
+        static std::array<std::unordered_set<point>, OVERMAP_LAYERS> dirty_tiles;
+        // Global state: z-levels changed too much to repair, their `d_maps` are dropped
+        static std::bitset<OVERMAP_LAYERS> dirty_levels;
+        // Global state: top left loaded submap `d_maps` local coords refer to
+        static tripoint d_maps_abs_sub;
+        // Global state: number of `end_turn` calls so far, used to age out `d_maps`
+        static int turn_counter;
+
         // We store the area covered by last Z-scan (in global coords, top left loaded submap)
         // ```
         // -----
@@ -242,12 +254,50 @@ class Pathfinding
         // Global state: We cache `z_path` information taken to prevent multiple iterations for the same target
         static std::map<std::tuple<bool, int, tripoint>, ZLevelChange> cached_closest_z_changes;
 
+        // Hierarchical routing: every submap of the loaded map is a cluster.
+        // Adjacent clusters connect through portals, one in the middle of each passable stretch of their shared border,
+        //   and portals of a cluster connect to each other with the cost of the cheapest path inside that cluster.
+        // Long routes are searched on this small portal graph first, then only the chosen legs are resolved tile by tile.
+        struct ClusterNode {
+            point pos;
+            // Nodes reachable directly from this one and the cost of getting there
+            std::vector<std::pair<point, float>> edges;
+        };
+        struct Cluster {
+            bool is_built = false;
+            // `cluster_versions` of this cluster and its eight neighbours when built
+            std::array<uint32_t, 9> versions = {};
+            std::vector<ClusterNode> nodes;
+        };
+        struct ClusterGraph {
+            int z = 0;
+            // Critter positions are never priced into the graph, only into the final tile routes
+            PathfindingSettings settings;
+            uint32_t level_version = 0;
+            int last_used = 0;
+            std::array<Cluster, MAPSIZE * MAPSIZE> clusters;
+        };
+
+        // Global state: portal graphs, one per z-level and settings
+        static std::vector<std::unique_ptr<ClusterGraph>> cluster_graphs;
+        // Global state: bumped whenever a tile of the cluster changes, so its graph parts get rebuilt
+        static std::array<std::array<uint32_t, MAPSIZE * MAPSIZE>, OVERMAP_LAYERS> cluster_versions;
+        // Global state: bumped whenever a whole z-level changes
+        static std::array<uint32_t, OVERMAP_LAYERS> level_versions;
+        // Global state: top left loaded submap `cluster_graphs` local coords refer to
+        static tripoint cluster_graphs_abs_sub;
+        // Global state: number of `cluster_graphs` lookups so far, used to drop least recently used graphs
+        static int cluster_graph_uses;
+
         // Smallest adjacent f
         std::array<std::array<float, MAPSIZE_X>, MAPSIZE_Y> p_map;
         // Associated tile's g cost [movement, bashing down...]
         std::array<std::array<float, MAPSIZE_X>, MAPSIZE_Y> g_map;
         // Tile overall state [padded on all sides by 1 tile for bounds checking]
         std::array < std::array < State, MAPSIZE_X + 2 >, MAPSIZE_Y + 2 > tile_state;
+        // Which neighbour the tile's p-value was taken from, as index into `DIRS_2D` + 1. 0 if none.
+        // Lets us find every tile whose f-value depends on a changed tile.
+        std::array<std::array<int8_t, MAPSIZE_X>, MAPSIZE_Y> parent_map;
 
         // Which points in maps have we modified thus far? Used for resetting.
         std::vector<point> map_modify_set;
@@ -273,6 +323,9 @@ class Pathfinding
         // Moves we don't allow to happen
         std::set<std::pair<point, point>> forbidden_moves;
 
+        // `turn_counter` when this map was last routed on
+        int last_used_turn = 0;
+
         // Possibly shift or move all Z-changes if our `z_area` moved
         //   and scan for new changes.
         // Only process OPEN_AIR changes if `update_open_air` is true. OPEN_AIR tiles are numerous on higher Z levels
@@ -284,6 +337,10 @@ class Pathfinding
         static std::unordered_map<point, ZLevelChangeOpenAirPair> &get_z_cache_open_air( const int z );
 
         static void produce_d_map( point dest, int z, PathfindingSettings settings );
+        // Reset `d_map` and return it to `d_maps_store`
+        static void recycle_d_map( std::unique_ptr<Pathfinding> &d_map );
+        // Drop or repair `d_maps` according to the changes recorded since last call
+        static void apply_invalidations();
 
         // Get `p`-value at `p`
         float &p_at( const point &p );
@@ -293,9 +350,16 @@ class Pathfinding
         float get_f_unbiased( const point &p );
         // f1 = p + g + `h_coeff` * [distance between `start` and `p`]
         float get_f_biased( const point &p, const point &start, float h_coeff );
+        // Get parent direction at `p`, see `parent_map`
+        int8_t &parent_at( const point &p );
 
+        void reset();
         void reset_maps();
         void reset_tile_state();
+        // Forget everything derived from `changed` tiles and put the frontier back around them,
+        //   so the next expansion recomputes only that part of the map.
+        // Returns false without touching anything if a changed tile got cheaper, the map must be dropped then.
+        bool repair( const std::unordered_set<point> &changed );
         State &tile_state_at( const point &p );
         bool in_bounds( const point &p );
 
@@ -321,6 +385,24 @@ class Pathfinding
             const RouteSettings route_settings
         );
 
+        // Find or make the portal graph for `z` and `settings`
+        static ClusterGraph &get_cluster_graph( int z, const PathfindingSettings &settings );
+        // Get `cluster` of `graph`, rebuilding it if it or its neighbours changed since last built
+        static Cluster &get_cluster( ClusterGraph &graph, const point &cluster );
+        static void build_cluster( ClusterGraph &graph, const point &cluster );
+        // Pairs of tiles [ours, theirs] the portals between `cluster` and its neighbour in `dir` go through,
+        //   one per straight run of the border and one per diagonal step no run covers.
+        //   `dir` must be `point_east`, `point_south`, or `point_south_east` / `point_north_east` for the corner crossing.
+        static std::vector<std::pair<point, point>> find_portals( int z, const PathfindingSettings &settings,
+                const point &cluster, const point &dir );
+        // Route on the portal graph, then resolve it into tiles.
+        //   Empty if the portal graph proves there is no route, nullopt if its route is too long or can't be
+        //   resolved, the caller then falls back to the exact search.
+        static std::optional<std::vector<tripoint>> get_route_hierarchical(
+                    point from, point to, int z,
+                    const PathfindingSettings &path_settings,
+                    const RouteSettings &route_settings );
+
         // Continue expanding the dijikstra map until we reach `origin` or nothing remains of the frontier. Returns whether a route is present.
         ExpansionOutcome expand_2d_up_to( const point &start, const RouteSettings &route_settings );
     public:
@@ -333,6 +415,15 @@ class Pathfinding
         // Reset whole pathfinding pretty much
         static void clear_d_maps();
 
+        // Age out `d_maps` which weren't used recently or depend on critter positions, and repair the rest.
+        //   Call once at the end of every turn.
+        static void end_turn();
+
+        // Tile at `p` changed in a way that may change its move cost
+        static void invalidate_tile( const tripoint &p );
+        // Whole `z` level changed (map shifted, vehicles moved...), its `d_maps` can't be repaired
+        static void invalidate_level( int z );
+
         // Reset Z-level information. Should only be done when new Z-level changes could have appeared
         //   such as change in terrain
         static void mark_dirty_z_cache();
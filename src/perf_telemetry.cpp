@@ -0,0 +1,189 @@
+#include "perf_telemetry.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ostream>
+
+#include "fstream_utils.h"
+#include "json.h"
+
+namespace telemetry
+{
+
+namespace
+{
+
+int64_t now_micros()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+// Totals of the turn in progress. Timers may run on worker threads, hence atomic.
+std::array<std::atomic<int64_t>, num_phases> current_micros;
+std::array<std::atomic<uint32_t>, num_phases> current_calls;
+
+/**
+ * One entry of the ring. The record with index `i` is complete while `seq` is
+ * `2 * i + 2`, and being written while it is `2 * i + 1`. Readers copy the fields
+ * and only keep the copy if `seq` was the expected value both before and after.
+ */
+struct slot {
+    std::atomic<uint64_t> seq{ 0 };
+    std::atomic<int> turn{ 0 };
+    std::array<std::atomic<int64_t>, num_phases> micros;
+    std::array<std::atomic<uint32_t>, num_phases> calls;
+};
+
+std::array<slot, history_size> ring;
+// Index of the next record to write. Only the main thread writes records.
+std::atomic<uint64_t> head{ 0 };
+
+bool read_slot( uint64_t index, turn_record &out )
+{
+    const slot &s = ring[index % history_size];
+    const uint64_t complete = 2 * index + 2;
+    while( true ) {
+        const uint64_t before = s.seq.load( std::memory_order_acquire );
+        if( before == complete - 1 ) {
+            // Being written right now, the writer won't take long.
+            continue;
+        }
+        if( before != complete ) {
+            // Already overwritten by a newer turn.
+            return false;
+        }
+        out.turn = s.turn.load( std::memory_order_relaxed );
+        for( size_t i = 0; i < num_phases; i++ ) {
+            out.micros[i] = s.micros[i].load( std::memory_order_relaxed );
+            out.calls[i] = s.calls[i].load( std::memory_order_relaxed );
+        }
+        std::atomic_thread_fence( std::memory_order_acquire );
+        if( s.seq.load( std::memory_order_relaxed ) == complete ) {
+            return true;
+        }
+    }
+}
+
+} // namespace
+
+const char *phase_name( phase p )
+{
+    switch( p ) {
+        case phase::vehmove:
+            return "vehmove";
+        case phase::process_fields:
+            return "process_fields";
+        case phase::process_items:
+            return "process_items";
+        case phase::build_map_cache:
+            return "build_map_cache";
+        case phase::monmove:
+            return "monmove";
+        case phase::draw:
+            return "draw";
+        case phase::save:
+            return "save";
+        case phase::num_phases:
+            break;
+    }
+    return "unknown";
+}
+
+scoped_timer::scoped_timer( phase p ) : p( p ), start( now_micros() )
+{
+}
+
+scoped_timer::~scoped_timer()
+{
+    const size_t i = static_cast<size_t>( p );
+    current_micros[i].fetch_add( now_micros() - start, std::memory_order_relaxed );
+    current_calls[i].fetch_add( 1, std::memory_order_relaxed );
+}
+
+void end_turn( int turn )
+{
+    const uint64_t index = head.load( std::memory_order_relaxed );
+    slot &s = ring[index % history_size];
+    s.seq.store( 2 * index + 1, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_release );
+    s.turn.store( turn, std::memory_order_relaxed );
+    for( size_t i = 0; i < num_phases; i++ ) {
+        s.micros[i].store( current_micros[i].exchange( 0, std::memory_order_relaxed ),
+                           std::memory_order_relaxed );
+        s.calls[i].store( current_calls[i].exchange( 0, std::memory_order_relaxed ),
+                          std::memory_order_relaxed );
+    }
+    s.seq.store( 2 * index + 2, std::memory_order_release );
+    head.store( index + 1, std::memory_order_release );
+}
+
+std::vector<turn_record> history()
+{
+    const uint64_t end = head.load( std::memory_order_acquire );
+    const uint64_t begin = end - std::min<uint64_t>( end, history_size );
+    std::vector<turn_record> ret;
+    ret.reserve( end - begin );
+    for( uint64_t index = begin; index < end; index++ ) {
+        turn_record rec;
+        if( read_slot( index, rec ) ) {
+            ret.push_back( rec );
+        }
+    }
+    return ret;
+}
+
+void reset()
+{
+    for( size_t i = 0; i < num_phases; i++ ) {
+        current_micros[i].store( 0, std::memory_order_relaxed );
+        current_calls[i].store( 0, std::memory_order_relaxed );
+    }
+    for( slot &s : ring ) {
+        s.seq.store( 0, std::memory_order_relaxed );
+    }
+    head.store( 0, std::memory_order_release );
+}
+
+bool dump_csv( const std::string &path )
+{
+    const std::vector<turn_record> records = history();
+    return write_to_file( path, [&]( std::ostream & fout ) {
+        fout << "turn";
+        for( size_t i = 0; i < num_phases; i++ ) {
+            const char *name = phase_name( static_cast<phase>( i ) );
+            fout << ',' << name << "_us," << name << "_calls";
+        }
+        fout << '\n';
+        for( const turn_record &rec : records ) {
+            fout << rec.turn;
+            for( size_t i = 0; i < num_phases; i++ ) {
+                fout << ',' << rec.micros[i] << ',' << rec.calls[i];
+            }
+            fout << '\n';
+        }
+    }, "turn timings" );
+}
+
+bool dump_json( const std::string &path )
+{
+    const std::vector<turn_record> records = history();
+    return write_to_file( path, [&]( std::ostream & fout ) {
+        JsonOut jsout( fout, true );
+        jsout.start_array();
+        for( const turn_record &rec : records ) {
+            jsout.start_object();
+            jsout.member( "turn", rec.turn );
+            for( size_t i = 0; i < num_phases; i++ ) {
+                const std::string name = phase_name( static_cast<phase>( i ) );
+                jsout.member( name + "_us", rec.micros[i] );
+                jsout.member( name + "_calls", rec.calls[i] );
+            }
+            jsout.end_object();
+        }
+        jsout.end_array();
+    }, "turn timings" );
+}
+
+} // namespace telemetry
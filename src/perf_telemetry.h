@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Always-on timing of the expensive parts of a game turn.
+ *
+ * Unlike the zones in profile.h, which only exist in Tracy builds, this is compiled
+ * into every build so that timings can be collected from ordinary players.
+ * Timers add to the totals of the turn in progress, @ref end_turn moves those into
+ * a fixed-size ring that can be read from any thread without locking.
+ */
+namespace telemetry
+{
+
+enum class phase : int {
+    vehmove,
+    process_fields,
+    process_items,
+    build_map_cache,
+    monmove,
+    draw,
+    save,
+    num_phases
+};
+
+constexpr size_t num_phases = static_cast<size_t>( phase::num_phases );
+
+/** Number of turns kept, older ones are overwritten. */
+constexpr size_t history_size = 512;
+
+const char *phase_name( phase p );
+
+struct turn_record {
+    int turn = 0;
+    /** Total time spent in each phase during the turn, in microseconds. */
+    std::array<int64_t, num_phases> micros = {};
+    /** How many times each phase ran during the turn. */
+    std::array<uint32_t, num_phases> calls = {};
+};
+
+/**
+ * Adds the time until it goes out of scope to @p p of the current turn.
+ * Phases may nest (drawing rebuilds the map cache), the outer one includes the inner.
+ */
+class scoped_timer
+{
+    public:
+        explicit scoped_timer( phase p );
+        ~scoped_timer();
+
+        scoped_timer( const scoped_timer & ) = delete;
+        scoped_timer &operator=( const scoped_timer & ) = delete;
+
+    private:
+        phase p;
+        int64_t start;
+};
+
+/** Stores the totals collected since the previous call as the record of @p turn. */
+void end_turn( int turn );
+
+/** The stored records, oldest first. */
+std::vector<turn_record> history();
+
+/** Drops all stored records and the totals of the turn in progress. */
+void reset();
+
+/** Write @ref history as CSV, one row per turn. @returns Whether writing succeeded. */
+bool dump_csv( const std::string &path );
+/** Write @ref history as a JSON array of objects. @returns Whether writing succeeded. */
+bool dump_json( const std::string &path );
+
+} // namespace telemetry
@@ -1271,7 +1271,7 @@ void faction_manager::deserialize( JsonIn &jsin )
 void Creature_tracker::deserialize( JsonIn &jsin )
 {
     monsters_list.clear();
-    monsters_by_location.clear();
+    clear_location_maps();
     jsin.start_array();
     while( !jsin.end_array() ) {
         // TODO: would be nice if monster had a constructor using JsonIn or similar, so this could be one statement.
@@ -3274,7 +3274,7 @@ struct mm_elem {
     }
 };
 
-void mm_submap::serialize( JsonOut &jsout ) const
+void mm_submap::serialize( JsonOut &jsout, mm_tile_dictionary &dictionary ) const
 {
     jsout.start_array();
 
@@ -3285,7 +3285,7 @@ void mm_submap::serialize( JsonOut &jsout ) const
 
     const auto write_seq = [&]() {
         jsout.start_array();
-        jsout.write( last.tile.tile );
+        jsout.write( dictionary.index( last.tile.tile_handle() ) );
         jsout.write( last.tile.subtile );
         jsout.write( last.tile.rotation );
         jsout.write( last.symbol );
@@ -3317,7 +3317,7 @@ void mm_submap::serialize( JsonOut &jsout ) const
     jsout.end_array();
 }
 
-void mm_submap::deserialize( JsonIn &jsin )
+void mm_submap::deserialize( JsonIn &jsin, const std::vector<uint32_t> *handles )
 {
     jsin.start_array();
 
@@ -3332,9 +3332,19 @@ void mm_submap::deserialize( JsonIn &jsin )
                 remaining -= 1;
             } else {
                 jsin.start_array();
-                elem.tile.tile = jsin.get_string();
-                elem.tile.subtile = jsin.get_int();
-                elem.tile.rotation = jsin.get_int();
+                uint32_t handle;
+                if( handles ) {
+                    const int index = jsin.get_int();
+                    if( index < 0 || static_cast<size_t>( index ) >= handles->size() ) {
+                        jsin.error( "tile index out of range" );
+                    }
+                    handle = ( *handles )[index];
+                } else {
+                    handle = memorized_terrain_tile::intern( jsin.get_string() );
+                }
+                const int subtile = jsin.get_int();
+                const int rotation = jsin.get_int();
+                elem.tile = memorized_terrain_tile::from_handle( handle, subtile, rotation );
                 elem.symbol = jsin.get_int();
                 if( jsin.test_int() ) {
                     remaining = jsin.get_int() - 1;
@@ -3356,6 +3366,29 @@ void mm_submap::deserialize( JsonIn &jsin )
 
 void mm_region::serialize( JsonOut &jsout ) const
 {
+    // Tile ids are written once per region, submaps refer to them by index.
+    mm_tile_dictionary dictionary;
+    for( const auto &column : submaps ) {
+        for( const shared_ptr_fast<mm_submap> &sm : column ) {
+            if( sm->is_empty() ) {
+                continue;
+            }
+            for( int y = 0; y < SEEY; y++ ) {
+                for( int x = 0; x < SEEX; x++ ) {
+                    dictionary.index( sm->tile( point( x, y ) ).tile_handle() );
+                }
+            }
+        }
+    }
+
+    jsout.start_object();
+    jsout.member( "tiles" );
+    jsout.start_array();
+    for( const uint32_t handle : dictionary.handles ) {
+        jsout.write( memorized_terrain_tile::from_handle( handle, 0, 0 ).tile() );
+    }
+    jsout.end_array();
+    jsout.member( "submaps" );
     jsout.start_array();
     // NOLINTNEXTLINE(modernize-loop-convert): leaving as is for readability
     for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
@@ -3365,30 +3398,55 @@ void mm_region::serialize( JsonOut &jsout ) const
             if( sm->is_empty() ) {
                 jsout.write_null();
             } else {
-                sm->serialize( jsout );
+                sm->serialize( jsout, dictionary );
             }
         }
     }
     jsout.end_array();
+    jsout.end_object();
 }
 
 void mm_region::deserialize( JsonIn &jsin )
 {
-    jsin.start_array();
-    // NOLINTNEXTLINE(modernize-loop-convert): leaving as is for readability
-    for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
+    const auto read_submaps = [&]( const std::vector<uint32_t> *handles ) {
+        jsin.start_array();
         // NOLINTNEXTLINE(modernize-loop-convert): leaving as is for readability
-        for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
-            shared_ptr_fast<mm_submap> &sm = submaps[x][y];
-            sm = make_shared_fast<mm_submap>();
-            if( jsin.test_null() ) {
-                jsin.skip_null();
-            } else {
-                sm->deserialize( jsin );
+        for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
+            // NOLINTNEXTLINE(modernize-loop-convert): leaving as is for readability
+            for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
+                shared_ptr_fast<mm_submap> &sm = submaps[x][y];
+                sm = make_shared_fast<mm_submap>();
+                if( jsin.test_null() ) {
+                    jsin.skip_null();
+                } else {
+                    sm->deserialize( jsin, handles );
+                }
             }
         }
+        jsin.end_array();
+    };
+
+    // Regions saved before tile dictionaries were a bare array of submaps with tile ids inline.
+    if( jsin.test_array() ) {
+        read_submaps( nullptr );
+        return;
+    }
+
+    std::vector<uint32_t> handles;
+    jsin.start_object();
+    while( !jsin.end_object() ) {
+        const std::string name = jsin.get_member_name();
+        if( name == "tiles" ) {
+            jsin.start_array();
+            while( !jsin.end_array() ) {
+                handles.push_back( memorized_terrain_tile::intern( jsin.get_string() ) );
+            }
+        } else if( name == "submaps" ) {
+            read_submaps( &handles );
+        } else {
+            jsin.skip_value();
+        }
     }
-    jsin.end_array();
 }
 
 void map_memory::load_legacy( JsonIn &jsin )
@@ -3408,9 +3466,10 @@ void map_memory::load_legacy( JsonIn &jsin )
         p.y = jsin.get_int();
         p.z = jsin.get_int();
         mig_elem &elem = elems[p];
-        elem.tile.tile = jsin.get_string();
-        elem.tile.subtile = jsin.get_int();
-        elem.tile.rotation = jsin.get_int();
+        const std::string tile = jsin.get_string();
+        const int subtile = jsin.get_int();
+        const int rotation = jsin.get_int();
+        elem.tile = memorized_terrain_tile( tile, subtile, rotation );
         jsin.end_array();
     }
     jsin.start_array();
@@ -3779,20 +3838,6 @@ void submap::store( JsonOut &jsout ) const
     }
     jsout.end_array();
 
-    jsout.member( "items" );
-    jsout.start_array();
-    for( int j = 0; j < SEEY; j++ ) {
-        for( int i = 0; i < SEEX; i++ ) {
-            if( itm[i][j].empty() ) {
-                continue;
-            }
-            jsout.write( i );
-            jsout.write( j );
-            jsout.write( itm[i][j] );
-        }
-    }
-    jsout.end_array();
-
     jsout.member( "traps" );
     jsout.start_array();
     for( int j = 0; j < SEEY; j++ ) {
@@ -3832,6 +3877,25 @@ void submap::store( JsonOut &jsout ) const
     }
     jsout.end_array();
 
+    store_contents( jsout );
+}
+
+void submap::store_contents( JsonOut &jsout ) const
+{
+    jsout.member( "items" );
+    jsout.start_array();
+    for( int j = 0; j < SEEY; j++ ) {
+        for( int i = 0; i < SEEX; i++ ) {
+            if( itm[i][j].empty() ) {
+                continue;
+            }
+            jsout.write( i );
+            jsout.write( j );
+            jsout.write( itm[i][j] );
+        }
+    }
+    jsout.end_array();
+
     // Write out as array of arrays of single entries
     jsout.member( "cosmetics" );
     jsout.start_array();
@@ -3956,7 +4020,7 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version,
             int rad_num = jsin.get_int();
             for( int i = 0; i < rad_num; ++i ) {
                 if( rad_cell < SEEX * SEEY ) {
-                    set_radiation( { 0 % SEEX, rad_cell / SEEX }, rad_strength );
+                    set_radiation( { rad_cell % SEEX, rad_cell / SEEX }, rad_strength );
                     rad_cell++;
                 }
             }
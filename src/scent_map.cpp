@@ -18,6 +18,67 @@
 
 static constexpr int SCENT_RADIUS = 40;
 
+// Where the toolchain supports it, the kernels below are also compiled for newer x86 vector
+// extensions and the best version is picked when the game starts. Every version is built from
+// the same source, so the results don't depend on the CPU.
+#if defined(__x86_64__) && defined(__ELF__) && defined(__has_attribute)
+#  if __has_attribute(target_clones)
+#    define SCENT_KERNEL __attribute__((target_clones("avx2", "sse4.1", "default")))
+#  endif
+#endif
+#if !defined(SCENT_KERNEL)
+#  define SCENT_KERNEL
+#endif
+
+namespace
+{
+
+// The kernels work on a run of tiles along y, which is contiguous in the scent arrays.
+
+SCENT_KERNEL
+void decay_kernel( int *scent, size_t count )
+{
+    for( size_t i = 0; i < count; i++ ) {
+        scent[i] = std::max( 0, scent[i] - 1 );
+    }
+}
+
+// Sums the scent that can diffuse into each tile from it and its two neighbours along y,
+// and how many of those squares let scent through.
+SCENT_KERNEL
+void sum_3_kernel( const int *scent, const char *transfer, int *sum_scent, int *sum_used,
+                   int count )
+{
+    for( int y = 0; y < count; y++ ) {
+        sum_scent[y] = transfer[y - 1] * scent[y - 1] + transfer[y] * scent[y] +
+                       transfer[y + 1] * scent[y + 1];
+        sum_used[y] = transfer[y - 1] + transfer[y] + transfer[y + 1];
+    }
+}
+
+SCENT_KERNEL
+void add_3_kernel( const int *a, const int *b, const int *c, int *out, int count )
+{
+    for( int y = 0; y < count; y++ ) {
+        out[y] = a[y] + b[y] + c[y];
+    }
+}
+
+SCENT_KERNEL
+void diffuse_kernel( const int *scent, const char *transfer, const int *squares_used,
+                     const int *total, int *out, int count )
+{
+    for( int y = 0; y < count; y++ ) {
+        //Lingering scent
+        int temp_scent = scent[y] * ( 250 - squares_used[y] * transfer[y] );
+        temp_scent -= scent[y] * transfer[y] * ( 45 - squares_used[y] ) / 5;
+
+        out[y] = ( temp_scent + total[y] * transfer[y] ) / 250;
+    }
+}
+
+} // namespace
+
 static nc_color sev( const size_t level )
 {
     static const std::array<nc_color, 22> colors = { {
@@ -60,11 +121,7 @@ void scent_map::reset()
 
 void scent_map::decay()
 {
-    for( auto &elem : grscent ) {
-        for( auto &val : elem ) {
-            val = std::max( 0, val - 1 );
-        }
-    }
+    decay_kernel( &grscent[0][0], MAPSIZE_X * MAPSIZE_Y );
 }
 
 void scent_map::draw( const catacurses::window &win, const int div, const tripoint &center ) const
@@ -162,9 +219,13 @@ void scent_map::update( const tripoint &center, map &m )
     //block=0 reduce=1 normal=5
     scent_array<char> scent_transfer;
 
-    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > new_scent;
-    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > sum_3_scent_y;
-    std::array < std::array < char, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > squares_used_y;
+    // Laid out like grscent, x major, so every pass runs along contiguous y.
+    constexpr int columns = 3 + SCENT_RADIUS * 2;
+    constexpr int rows = 1 + SCENT_RADIUS * 2;
+    using scent_column = std::array<int, rows>;
+    std::array<scent_column, columns> new_scent;
+    std::array<scent_column, columns> sum_3_scent_y;
+    std::array<scent_column, columns> squares_used_y;
 
     diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = m.access_cache(
                 center.z ).vehicle_obstructed_cache;
@@ -179,67 +240,49 @@ void scent_map::update( const tripoint &center, map &m )
     m.scent_blockers( scent_transfer, point( scentmap_minx - 1, scentmap_miny - 1 ),
                       point( scentmap_maxx + 1, scentmap_maxy + 1 ) );
 
-    for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
-        sum_3_scent_y[0][x] = 0;
-        squares_used_y[0][x] = 0;
-        sum_3_scent_y[SCENT_RADIUS * 2][x] = 0;
-        squares_used_y[SCENT_RADIUS * 2][x] = 0;
-    }
-
-    for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
-        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-
-            point abs( x + scentmap_minx - 1, y + scentmap_miny );
-
-            // remember the sum of the scent val for the 3 neighboring squares that can defuse into
-            sum_3_scent_y[y][x] = 0;
-            squares_used_y[y][x] = 0;
-            for( int i = abs.y - 1; i <= abs.y + 1; ++i ) {
-                sum_3_scent_y[y][x] += scent_transfer[abs.x][i] * grscent[abs.x][i];
-                squares_used_y[y][x] += scent_transfer[abs.x][i];
-            }
-        }
+    // remember the sum of the scent val for the 3 neighboring squares that can defuse into
+    for( int x = 0; x < columns; ++x ) {
+        const int abs_x = x + scentmap_minx - 1;
+        sum_3_kernel( &grscent[abs_x][scentmap_miny], &scent_transfer[abs_x][scentmap_miny],
+                      sum_3_scent_y[x].data(), squares_used_y[x].data(), rows );
     }
 
-    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
-        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-            const point abs( x + scentmap_minx - 1, y + scentmap_miny );
-
-            int squares_used = squares_used_y[y][x - 1] + squares_used_y[y][x] + squares_used_y[y][x + 1];
-            int total = sum_3_scent_y[y][x - 1] + sum_3_scent_y[y][x] + sum_3_scent_y[y][x + 1];
-
-            //handle vehicle holes
+    scent_column squares_used;
+    scent_column total;
+    for( int x = 1; x < columns - 1; ++x ) {
+        const int abs_x = x + scentmap_minx - 1;
+        add_3_kernel( squares_used_y[x - 1].data(), squares_used_y[x].data(),
+                      squares_used_y[x + 1].data(), squares_used.data(), rows );
+        add_3_kernel( sum_3_scent_y[x - 1].data(), sum_3_scent_y[x].data(),
+                      sum_3_scent_y[x + 1].data(), total.data(), rows );
+
+        //handle vehicle holes
+        for( int y = 0; y < rows; ++y ) {
+            const point abs( abs_x, y + scentmap_miny );
             if( blocked_cache[abs.x][abs.y].nw && scent_transfer[abs.x + 1][abs.y + 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x + 1][abs.y + 1];
+                squares_used[y] -= 4;
+                total[y] -= 4 * grscent[abs.x + 1][abs.y + 1];
             }
             if( blocked_cache[abs.x][abs.y].ne && scent_transfer[abs.x - 1][abs.y + 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x - 1][abs.y + 1];
+                squares_used[y] -= 4;
+                total[y] -= 4 * grscent[abs.x - 1][abs.y + 1];
             }
             if( blocked_cache[abs.x - 1][abs.y - 1].nw && scent_transfer[abs.x - 1][abs.y - 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x - 1][abs.y - 1];
+                squares_used[y] -= 4;
+                total[y] -= 4 * grscent[abs.x - 1][abs.y - 1];
             }
             if( blocked_cache[abs.x + 1][abs.y - 1].ne && scent_transfer[abs.x + 1][abs.y - 1] == 5 ) {
-                squares_used -= 4;
-                total -= 4 * grscent[abs.x + 1][abs.y - 1];
+                squares_used[y] -= 4;
+                total[y] -= 4 * grscent[abs.x + 1][abs.y - 1];
             }
-
-            //Lingering scent
-            int temp_scent =  grscent[abs.x][abs.y] * ( 250 - squares_used  *
-                              scent_transfer[abs.x][abs.y] ) ;
-            temp_scent -=  grscent[abs.x][abs.y] * scent_transfer[abs.x][abs.y] *
-                           ( 45 - squares_used ) / 5;
-
-            new_scent[y][x] = ( temp_scent + total * scent_transfer[abs.x][abs.y] ) / 250;
-
         }
+
+        diffuse_kernel( &grscent[abs_x][scentmap_miny], &scent_transfer[abs_x][scentmap_miny],
+                        squares_used.data(), total.data(), new_scent[x].data(), rows );
     }
-    for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
-        for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-            grscent[x + scentmap_minx - 1 ][y + scentmap_miny] = new_scent[y][x];
-        }
+    for( int x = 1; x < columns - 1; ++x ) {
+        std::copy( new_scent[x].begin(), new_scent[x].end(),
+                   &grscent[x + scentmap_minx - 1][scentmap_miny] );
     }
 }
 
@@ -43,7 +43,8 @@ class scent_map
         template<typename T>
         using scent_array = std::array<std::array<T, MAPSIZE_Y>, MAPSIZE_X>;
 
-        scent_array<int> grscent;
+        // Aligned for the vectorized diffusion and decay in scent_map.cpp
+        alignas( 32 ) scent_array<int> grscent;
         scenttype_id typescent;
         std::optional<tripoint> player_last_position;
         time_point player_last_moved = calendar::before_time_starts;
@@ -1928,6 +1928,9 @@ bool handle_resize( int w, int h )
         need_invalidate_framebuffers = true;
         catacurses::stdscr = catacurses::newwin( TERMINAL_HEIGHT, TERMINAL_WIDTH, point_zero );
         throwErrorIf( !SetupRenderTarget(), "SetupRenderTarget failed" );
+        if( tilecontext ) {
+            tilecontext->invalidate_map_frame();
+        }
         game_ui::init_ui();
         ui_manager::screen_resized();
         return true;
@@ -3411,6 +3414,10 @@ static void CheckMessages()
     if( !resized && render_target_reset ) {
         throwErrorIf( !SetupRenderTarget(), "SetupRenderTarget failed" );
         reinitialize_framebuffer( true );
+        // The previous map frame went with the old target, nothing can be diffed against it
+        if( tilecontext ) {
+            tilecontext->invalidate_map_frame();
+        }
         needupdate = true;
         restore_on_out_of_scope<input_event> prev_last_input( last_input );
         // FIXME: SDL_RENDER_TARGETS_RESET only seems to be fired after the first redraw
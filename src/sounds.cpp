@@ -18,6 +18,8 @@
 #include "calendar.h"
 #include "coordinate_conversions.h"
 #include "creature.h"
+#include "creature_tracker.h"
+#include "cuboid_rectangle.h"
 #include "debug.h"
 #include "effect.h"
 #include "enums.h"
@@ -363,12 +365,20 @@ void sounds::process_sounds()
             overmap_buffer.signal_hordes( target, sig_power );
         }
         // Alert all monsters (that can hear) to the sound.
-        for( monster &critter : g->all_monsters() ) {
+        // Only those closer than twice the volume might hear it, and every level
+        // of height difference counts for at least 5 tiles.
+        const int max_dist = vol * 2 - 1;
+        if( max_dist < 0 ) {
+            continue;
+        }
+        const tripoint reach( max_dist, max_dist, max_dist / 5 );
+        for( const shared_ptr_fast<monster> &critter : g->critter_tracker->find_in_area(
+                 inclusive_cuboid<tripoint>( source - reach, source + reach ) ) ) {
             // TODO: Generalize this to Creature::hear_sound
-            const int dist = sound_distance( source, critter.pos() );
+            const int dist = sound_distance( source, critter->pos() );
             if( vol * 2 > dist ) {
                 // Exclude monsters that certainly won't hear the sound
-                critter.hear_sound( source, vol, dist );
+                critter->hear_sound( source, vol, dist );
             }
         }
     }
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+namespace cata
+{
+
+/**
+ * Sorts queued sprites by @p order_key, but only within runs of sprites that share
+ * the same @p blend_key. Blend state such as an alpha mod sticks to the texture once
+ * set, so a sprite moved past a change of it would be drawn with the wrong state.
+ */
+template<typename Sprite, typename BlendKey, typename OrderKey>
+void sort_sprites_by_texture( std::vector<Sprite> &sprites, BlendKey blend_key,
+                              OrderKey order_key )
+{
+    const auto by_order = [&order_key]( const Sprite & a, const Sprite & b ) {
+        return order_key( a ) < order_key( b );
+    };
+    auto run_begin = sprites.begin();
+    while( run_begin != sprites.end() ) {
+        const auto run_end = std::find_if( run_begin, sprites.end(), [&]( const Sprite & s ) {
+            return blend_key( s ) != blend_key( *run_begin );
+        } );
+        std::sort( run_begin, run_end, by_order );
+        run_begin = run_end;
+    }
+}
+
+} // namespace cata
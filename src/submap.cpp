@@ -48,6 +48,8 @@ void submap::swap( submap &first, submap &second )
     std::swap( first.legacy_computer, second.legacy_computer );
     std::swap( first.temperature, second.temperature );
     std::swap( first.cosmetics, second.cosmetics );
+    first.mark_modified();
+    second.mark_modified();
 
     for( int x = 0; x < SEEX; x++ ) {
         for( int y = 0; y < SEEY; y++ ) {
@@ -239,6 +241,7 @@ submap::~submap() = default;
 void submap::update_lum_rem( point p, const item &i )
 {
     is_uniform = false;
+    mark_modified();
     if( !i.is_emissive() ) {
         return;
     } else if( lum[p.x][p.y] && lum[p.x][p.y] < 255 ) {
@@ -262,6 +265,7 @@ void submap::update_lum_rem( point p, const item &i )
 
 void submap::insert_cosmetic( point p, const std::string &type, const std::string &str )
 {
+    mark_modified();
     cosmetic_t ins;
 
     ins.pos = p;
@@ -315,6 +319,7 @@ const std::string &submap::get_graffiti( point p ) const
 void submap::set_graffiti( point p, const std::string &new_graffiti )
 {
     is_uniform = false;
+    mark_modified();
     // Find signage at p if available
     const auto fresult = find_cosmetic( cosmetics, p, COSMETICS_GRAFFITI );
     if( fresult.result ) {
@@ -327,6 +332,7 @@ void submap::set_graffiti( point p, const std::string &new_graffiti )
 void submap::delete_graffiti( point p )
 {
     is_uniform = false;
+    mark_modified();
     const auto fresult = find_cosmetic( cosmetics, p, COSMETICS_GRAFFITI );
     if( fresult.result ) {
         cosmetics[ fresult.ndx ] = cosmetics.back();
@@ -355,6 +361,7 @@ std::string submap::get_signage( point p ) const
 void submap::set_signage( point p, const std::string &s )
 {
     is_uniform = false;
+    mark_modified();
     // Find signage at p if available
     const auto fresult = find_cosmetic( cosmetics, p, COSMETICS_SIGNAGE );
     if( fresult.result ) {
@@ -366,6 +373,7 @@ void submap::set_signage( point p, const std::string &s )
 void submap::delete_signage( point p )
 {
     is_uniform = false;
+    mark_modified();
     const auto fresult = find_cosmetic( cosmetics, p, COSMETICS_SIGNAGE );
     if( fresult.result ) {
         cosmetics[ fresult.ndx ] = cosmetics.back();
@@ -408,6 +416,8 @@ const computer *submap::get_computer( point p ) const
 
 computer *submap::get_computer( point p )
 {
+    // Caller may modify the computer
+    mark_modified();
     // need to update to std::map first so modifications to the returned object
     // only affects the exact point p
     update_legacy_computer();
@@ -420,6 +430,7 @@ computer *submap::get_computer( point p )
 
 void submap::set_computer( point p, const computer &c )
 {
+    mark_modified();
     update_legacy_computer();
     const auto it = computers.find( p );
     if( it != computers.end() ) {
@@ -431,10 +442,52 @@ void submap::set_computer( point p, const computer &c )
 
 void submap::delete_computer( point p )
 {
+    mark_modified();
     update_legacy_computer();
     computers.erase( p );
 }
 
+bool submap::needs_save() const
+{
+    if( generation != saved_generation || !vehicles.empty() || !active_items.empty() ||
+        !active_furniture.empty() || !partial_constructions.empty() ) {
+        return true;
+    }
+    return last_touched != saved_last_touched && has_time_dependent_state();
+}
+
+bool submap::has_time_dependent_state() const
+{
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            const ter_t &t = ter[x][y].obj();
+            if( rad[x][y] != 0 || ter[x][y] == t_tree_maple_tapped ||
+                t.has_flag( TFLAG_HARVESTED ) || frn[x][y].obj().has_flag( TFLAG_HARVESTED ) ||
+                trp[x][y].obj().is_funnel() || t.trap.obj().is_funnel() ) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool submap::has_contents() const
+{
+    if( !cosmetics.empty() || !spawns.empty() || !vehicles.empty() ||
+        !partial_constructions.empty() || !computers.empty() || legacy_computer ||
+        !active_furniture.empty() ) {
+        return true;
+    }
+    for( const auto &column : itm ) {
+        for( const location_vector<item> &items : column ) {
+            if( !items.empty() ) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 bool submap::contains_vehicle( vehicle *veh )
 {
     const auto match = std::ranges::find_if(
@@ -447,6 +500,7 @@ bool submap::contains_vehicle( vehicle *veh )
 
 void submap::rotate( int turns )
 {
+    mark_modified();
     turns = turns % 4;
 
     if( turns == 0 ) {
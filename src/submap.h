@@ -94,6 +94,7 @@ class submap : maptile_soa<SEEX, SEEY>
 
         void set_trap( point p, trap_id trap ) {
             is_uniform = false;
+            mark_modified();
             trp[p.x][p.y] = trap;
         }
 
@@ -107,6 +108,7 @@ class submap : maptile_soa<SEEX, SEEY>
 
         void set_furn( point p, furn_id furn ) {
             is_uniform = false;
+            mark_modified();
             frn[p.x][p.y] = furn;
         }
 
@@ -120,6 +122,7 @@ class submap : maptile_soa<SEEX, SEEY>
 
         void set_ter( point p, ter_id terr ) {
             is_uniform = false;
+            mark_modified();
             ter[p.x][p.y] = terr;
         }
 
@@ -133,6 +136,7 @@ class submap : maptile_soa<SEEX, SEEY>
 
         void set_radiation( point p, const int radiation ) {
             is_uniform = false;
+            mark_modified();
             rad[p.x][p.y] = radiation;
         }
 
@@ -142,11 +146,13 @@ class submap : maptile_soa<SEEX, SEEY>
 
         void set_lum( point p, uint8_t luminance ) {
             is_uniform = false;
+            mark_modified();
             lum[p.x][p.y] = luminance;
         }
 
         void update_lum_add( point p, const item &i ) {
             is_uniform = false;
+            mark_modified();
             if( i.is_emissive() && lum[p.x][p.y] < 255 ) {
                 lum[p.x][p.y]++;
             }
@@ -185,6 +191,9 @@ class submap : maptile_soa<SEEX, SEEY>
         }
 
         void set_temperature( int new_temperature ) {
+            if( temperature != new_temperature ) {
+                mark_modified();
+            }
             temperature = new_temperature;
         }
 
@@ -215,8 +224,59 @@ class submap : maptile_soa<SEEX, SEEY>
         void rotate( int turns );
 
         void store( JsonOut &jsout ) const;
+        /**
+         * Write the members that @ref submap_binary keeps as a JSON sub-block:
+         * items, cosmetics, spawns, vehicles, partial constructions, computers
+         * and active furniture. Loaded back through @ref load.
+         */
+        void store_contents( JsonOut &jsout ) const;
+        /** Whether @ref store_contents would write anything besides empty arrays. */
+        bool has_contents() const;
         void load( JsonIn &jsin, const std::string &member_name, int version, const tripoint offset );
 
+        /**
+         * Save generation tracking. Every change to the saved contents of this submap
+         * must call @ref mark_modified, so @ref mapbuffer::save can skip quads that
+         * are identical to what was last written or read.
+         */
+        /**@{*/
+        void mark_modified() {
+            generation++;
+        }
+        /** The state @ref mark_saved records, taken when the submap is written. */
+        struct save_point {
+            uint64_t generation = 0;
+            time_point last_touched;
+        };
+        save_point get_save_point() const {
+            return { generation, last_touched };
+        }
+        void mark_saved() {
+            mark_saved( get_save_point() );
+        }
+        /** Record that the submap as it was at @p saved is stored, it may have changed since. */
+        void mark_saved( const save_point &saved ) {
+            saved_generation = saved.generation;
+            saved_last_touched = saved.last_touched;
+        }
+        uint64_t get_generation() const {
+            return generation;
+        }
+        /**
+         * Whether the saved copy of this submap may be out of date. Submaps with
+         * state that changes without going through @ref mark_modified (vehicles,
+         * active items and furniture, partial constructions) always need saving.
+         */
+        bool needs_save() const;
+        /**@}*/
+
+        /**
+         * Whether actualizing this submap depends on @ref last_touched (funnels,
+         * sap, radiation, harvest regrowth), which means an updated timestamp alone
+         * still has to be saved.
+         */
+        bool has_time_dependent_state() const;
+
         // If is_uniform is true, this submap is a solid block of terrain
         // Uniform submaps aren't saved/loaded, because regenerating them is faster
         bool is_uniform;
@@ -243,6 +303,10 @@ class submap : maptile_soa<SEEX, SEEY>
         std::map<point, computer> computers;
         std::unique_ptr<computer> legacy_computer;
         int temperature = 0;
+        // New submaps start out modified, since they were never saved.
+        uint64_t generation = 1;
+        uint64_t saved_generation = 0;
+        time_point saved_last_touched = calendar::turn_zero;
 
         void update_legacy_computer();
 
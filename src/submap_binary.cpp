@@ -0,0 +1,367 @@
+#include "submap_binary.h"
+
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "calendar.h"
+#include "coordinate_conversions.h"
+#include "field.h"
+#include "game.h"
+#include "game_constants.h"
+#include "json.h"
+#include "mapdata.h"
+#include "submap.h"
+#include "trap.h"
+
+namespace submap_binary
+{
+
+namespace
+{
+
+// Starts with a NUL byte, which can never begin a JSON quad.
+constexpr char magic[] = { '\0', 'C', 'B', 'Q' };
+constexpr size_t magic_size = sizeof( magic );
+constexpr int cells = SEEX * SEEY;
+
+class byte_writer
+{
+    public:
+        void varint( uint64_t value ) {
+            while( value >= 0x80 ) {
+                data.push_back( static_cast<char>( ( value & 0x7F ) | 0x80 ) );
+                value >>= 7;
+            }
+            data.push_back( static_cast<char>( value ) );
+        }
+        void zigzag( int64_t value ) {
+            varint( ( static_cast<uint64_t>( value ) << 1 ) ^ static_cast<uint64_t>( value >> 63 ) );
+        }
+        void bytes( const std::string &str ) {
+            varint( str.size() );
+            data += str;
+        }
+
+        std::string data;
+};
+
+class byte_reader
+{
+    public:
+        explicit byte_reader( const std::string &data ) : data( data ) {}
+
+        uint64_t varint() {
+            uint64_t value = 0;
+            for( int shift = 0; shift < 64; shift += 7 ) {
+                const uint8_t byte = static_cast<uint8_t>( next() );
+                value |= static_cast<uint64_t>( byte & 0x7F ) << shift;
+                if( !( byte & 0x80 ) ) {
+                    return value;
+                }
+            }
+            throw std::runtime_error( "binary quad has an overlong varint" );
+        }
+        int64_t zigzag() {
+            const uint64_t value = varint();
+            return static_cast<int64_t>( value >> 1 ) ^ -static_cast<int64_t>( value & 1 );
+        }
+        void skip( size_t size ) {
+            if( size > data.size() - pos ) {
+                throw std::runtime_error( "binary quad is truncated" );
+            }
+            pos += size;
+        }
+        std::string bytes() {
+            const uint64_t size = varint();
+            if( size > data.size() - pos ) {
+                throw std::runtime_error( "binary quad is truncated" );
+            }
+            std::string ret = data.substr( pos, size );
+            pos += size;
+            return ret;
+        }
+
+    private:
+        char next() {
+            if( pos >= data.size() ) {
+                throw std::runtime_error( "binary quad is truncated" );
+            }
+            return data[pos++];
+        }
+
+        const std::string &data;
+        size_t pos = 0;
+};
+
+/** Assigns table indices to ids in order of first use. */
+template<typename T>
+class id_table
+{
+    public:
+        size_t intern( const int_id<T> &id ) {
+            const auto iter = indices.emplace( id, ids.size() );
+            if( iter.second ) {
+                ids.push_back( id );
+            }
+            return iter.first->second;
+        }
+        void write( byte_writer &out ) const {
+            out.varint( ids.size() );
+            for( const int_id<T> &id : ids ) {
+                out.bytes( id.id().str() );
+            }
+        }
+
+    private:
+        std::map<int_id<T>, size_t> indices;
+        std::vector<int_id<T>> ids;
+};
+
+template<typename T>
+std::vector<int_id<T>> read_id_table( byte_reader &in )
+{
+    std::vector<int_id<T>> ret( in.varint() );
+    for( int_id<T> &id : ret ) {
+        id = string_id<T>( in.bytes() ).id();
+    }
+    return ret;
+}
+
+template<typename T>
+const int_id<T> &lookup( const std::vector<int_id<T>> &table, uint64_t index )
+{
+    if( index >= table.size() ) {
+        throw std::runtime_error( "binary quad id index out of range" );
+    }
+    return table[index];
+}
+
+/** Tiles are visited row by row, the same order the JSON RLE uses. */
+point cell_point( int cell )
+{
+    return point( cell % SEEX, cell / SEEX );
+}
+
+/** Writes ( run length, value ) pairs covering every tile of the submap. */
+template<typename F>
+void write_runs( byte_writer &out, F value_at )
+{
+    int cell = 0;
+    while( cell < cells ) {
+        const uint64_t value = value_at( cell_point( cell ) );
+        int run = 1;
+        while( cell + run < cells && value_at( cell_point( cell + run ) ) == value ) {
+            run++;
+        }
+        out.varint( run );
+        out.varint( value );
+        cell += run;
+    }
+}
+
+template<typename F>
+void read_runs( byte_reader &in, F set_run )
+{
+    int cell = 0;
+    while( cell < cells ) {
+        const uint64_t run = in.varint();
+        if( run == 0 || run > static_cast<uint64_t>( cells - cell ) ) {
+            throw std::runtime_error( "binary quad has a bad run length" );
+        }
+        set_run( cell, static_cast<int>( run ), in.varint() );
+        cell += run;
+    }
+}
+
+uint64_t to_zigzag( int value )
+{
+    return ( static_cast<uint64_t>( value ) << 1 ) ^ static_cast<uint64_t>( value >> 31 );
+}
+
+int from_zigzag( uint64_t value )
+{
+    return static_cast<int>( value >> 1 ) ^ -static_cast<int>( value & 1 );
+}
+
+} // namespace
+
+bool is_binary_quad( std::istream &in )
+{
+    return in.peek() == std::char_traits<char>::to_int_type( magic[0] );
+}
+
+void write_quad( std::ostream &out,
+                 const std::vector<std::pair<tripoint, const submap *>> &submaps )
+{
+    id_table<ter_t> terrain;
+    id_table<furn_t> furniture;
+    id_table<trap> traps;
+    id_table<field_type> field_types;
+
+    byte_writer body;
+    body.varint( submaps.size() );
+    for( const auto &entry : submaps ) {
+        const tripoint &pos = entry.first;
+        const submap &sm = *entry.second;
+        body.zigzag( pos.x );
+        body.zigzag( pos.y );
+        body.zigzag( pos.z );
+        body.zigzag( to_turn<int>( sm.last_touched ) );
+        body.zigzag( sm.get_temperature() );
+
+        write_runs( body, [&]( point p ) {
+            return terrain.intern( sm.get_ter( p ) );
+        } );
+        write_runs( body, [&]( point p ) {
+            return furniture.intern( sm.get_furn( p ) );
+        } );
+        write_runs( body, [&]( point p ) {
+            return traps.intern( sm.get_trap( p ) );
+        } );
+        write_runs( body, [&]( point p ) {
+            return to_zigzag( sm.get_radiation( p ) );
+        } );
+
+        int field_cells = 0;
+        byte_writer fields;
+        for( int cell = 0; cell < cells; cell++ ) {
+            const field &fd = sm.get_field( cell_point( cell ) );
+            if( fd.field_count() == 0 ) {
+                continue;
+            }
+            field_cells++;
+            fields.varint( cell );
+            fields.varint( fd.field_count() );
+            for( const auto &elem : fd ) {
+                const field_entry &cur = elem.second;
+                fields.varint( field_types.intern( cur.get_field_type() ) );
+                fields.zigzag( cur.get_field_intensity() );
+                fields.zigzag( to_turns<int>( cur.get_field_age() ) );
+            }
+        }
+        body.varint( field_cells );
+        body.data += fields.data;
+
+        // Lum is not stored, it is rebuilt while loading the emissive items.
+        std::string contents;
+        if( sm.has_contents() ) {
+            std::ostringstream buffer;
+            JsonOut jsout( buffer );
+            jsout.start_object();
+            sm.store_contents( jsout );
+            jsout.end_object();
+            contents = buffer.str();
+        }
+        body.bytes( contents );
+    }
+
+    byte_writer header;
+    header.varint( format_version );
+    header.varint( savegame_version );
+    terrain.write( header );
+    furniture.write( header );
+    traps.write( header );
+    field_types.write( header );
+
+    out.write( magic, magic_size );
+    out << header.data << body.data;
+}
+
+void read_quad( std::istream &in,
+                const std::function<void( const tripoint &, std::unique_ptr<submap> )> &on_submap )
+{
+    const std::string data{ std::istreambuf_iterator<char>( in ), std::istreambuf_iterator<char>() };
+    if( data.size() < magic_size || std::memcmp( data.data(), magic, magic_size ) != 0 ) {
+        throw std::runtime_error( "not a binary quad" );
+    }
+    byte_reader reader( data );
+    reader.skip( magic_size );
+
+    const uint64_t layout = reader.varint();
+    if( layout > static_cast<uint64_t>( format_version ) ) {
+        throw std::runtime_error( "binary quad was written by a newer version" );
+    }
+    const int version = static_cast<int>( reader.varint() );
+    const std::vector<ter_id> terrain = read_id_table<ter_t>( reader );
+    const std::vector<furn_id> furniture = read_id_table<furn_t>( reader );
+    const std::vector<trap_id> traps = read_id_table<trap>( reader );
+    const std::vector<field_type_id> field_types = read_id_table<field_type>( reader );
+
+    const uint64_t num_submaps = reader.varint();
+    for( uint64_t n = 0; n < num_submaps; n++ ) {
+        tripoint pos;
+        pos.x = static_cast<int>( reader.zigzag() );
+        pos.y = static_cast<int>( reader.zigzag() );
+        pos.z = static_cast<int>( reader.zigzag() );
+        std::unique_ptr<submap> sm = std::make_unique<submap>( sm_to_ms_copy( pos ) );
+        sm->last_touched = calendar::turn_zero + time_duration::from_turns( reader.zigzag() );
+        sm->set_temperature( static_cast<int>( reader.zigzag() ) );
+
+        read_runs( reader, [&]( int cell, int run, uint64_t value ) {
+            const ter_id &id = lookup( terrain, value );
+            for( int i = cell; i < cell + run; i++ ) {
+                sm->set_ter( cell_point( i ), id );
+            }
+        } );
+        read_runs( reader, [&]( int cell, int run, uint64_t value ) {
+            const furn_id &id = lookup( furniture, value );
+            for( int i = cell; i < cell + run; i++ ) {
+                sm->set_furn( cell_point( i ), id );
+            }
+        } );
+        read_runs( reader, [&]( int cell, int run, uint64_t value ) {
+            const trap_id &id = lookup( traps, value );
+            for( int i = cell; i < cell + run; i++ ) {
+                sm->set_trap( cell_point( i ), id );
+            }
+        } );
+        read_runs( reader, [&]( int cell, int run, uint64_t value ) {
+            const int radiation = from_zigzag( value );
+            for( int i = cell; i < cell + run; i++ ) {
+                sm->set_radiation( cell_point( i ), radiation );
+            }
+        } );
+
+        const uint64_t field_cells = reader.varint();
+        for( uint64_t c = 0; c < field_cells; c++ ) {
+            const uint64_t cell = reader.varint();
+            if( cell >= static_cast<uint64_t>( cells ) ) {
+                throw std::runtime_error( "binary quad has a bad field position" );
+            }
+            const point p = cell_point( static_cast<int>( cell ) );
+            field &fd = sm->get_field( p );
+            const uint64_t entries = reader.varint();
+            for( uint64_t e = 0; e < entries; e++ ) {
+                const field_type_id &ft = lookup( field_types, reader.varint() );
+                const int intensity = static_cast<int>( reader.zigzag() );
+                const time_duration age = time_duration::from_turns( reader.zigzag() );
+                if( fd.find_field( ft ) == nullptr ) {
+                    sm->field_count++;
+                }
+                fd.add_field( ft, intensity, age );
+            }
+        }
+
+        const std::string contents = reader.bytes();
+        if( !contents.empty() ) {
+            std::istringstream buffer( contents );
+            JsonIn jsin( buffer );
+            jsin.start_object();
+            while( !jsin.end_object() ) {
+                const std::string member_name = jsin.get_member_name();
+                sm->load( jsin, member_name, version, sm_to_ms_copy( pos ) );
+            }
+        }
+
+        on_submap( pos, std::move( sm ) );
+    }
+}
+
+} // namespace submap_binary
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "point.h"
+
+class submap;
+
+/**
+ * Compact binary encoding of a map quad, used by @ref mapbuffer instead of JSON.
+ *
+ * Terrain, furniture, traps, radiation and fields are stored as run-length
+ * encoded arrays of indices into an id table shared by the whole quad, so
+ * loading resolves each distinct id once instead of once per tile. Members
+ * with nested objects (items, vehicles, computers...) are kept as a JSON
+ * sub-block per submap, written by @ref submap::store_contents and skipped
+ * entirely when empty.
+ *
+ * JSON stays the interchange and debugging format: readers detect the format
+ * from the first bytes, so both kinds of quads can live in the same world.
+ */
+namespace submap_binary
+{
+
+/** Bumped whenever the layout changes. Older layouts must stay readable. */
+constexpr int format_version = 1;
+
+/**
+ * Whether @p in is positioned at a binary quad. Only peeks, so the stream can still be
+ * handed to @ref JsonIn otherwise. JSON quads always start with '['.
+ */
+bool is_binary_quad( std::istream &in );
+
+/** Write the given submaps (at most 4, with their absolute submap coordinates) as one quad. */
+void write_quad( std::ostream &out,
+                 const std::vector<std::pair<tripoint, const submap *>> &submaps );
+
+/**
+ * Decode a quad written by @ref write_quad.
+ * @param on_submap Receives every submap along with its absolute submap coordinates.
+ * @throws std::runtime_error if the data is truncated or malformed.
+ */
+void read_quad( std::istream &in,
+                const std::function<void( const tripoint &, std::unique_ptr<submap> )> &on_submap );
+
+} // namespace submap_binary
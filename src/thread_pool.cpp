@@ -0,0 +1,133 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+namespace cata
+{
+
+namespace
+{
+
+// Pool and index of the worker running on this thread, if any.
+constexpr size_t not_a_worker = static_cast<size_t>( -1 );
+thread_local const thread_pool *current_pool = nullptr;
+thread_local size_t current_worker = not_a_worker;
+
+} // namespace
+
+thread_pool::thread_pool( size_t num_threads, size_t max_queued ) : max_queued( max_queued )
+{
+    num_threads = std::max<size_t>( num_threads, 1 );
+    for( size_t i = 0; i < num_threads; i++ ) {
+        queues.push_back( std::make_unique<worker_queue>() );
+    }
+    for( size_t i = 0; i < num_threads; i++ ) {
+        workers.emplace_back( [this, i]() {
+            worker_loop( i );
+        } );
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard<std::mutex> lk( sleep_mutex );
+        stopping = true;
+    }
+    sleep_cv.notify_all();
+    for( std::thread &t : workers ) {
+        if( t.joinable() ) {
+            t.join();
+        }
+    }
+    // Anything still queued will never run, don't leave its futures hanging.
+    for( std::unique_ptr<worker_queue> &q : queues ) {
+        for( std::deque<task> &tasks : q->tasks ) {
+            for( task &t : tasks ) {
+                t.cancel();
+            }
+        }
+    }
+}
+
+void thread_pool::enqueue( task &&t, task_priority priority )
+{
+    if( queued.load() >= max_queued ) {
+        // Caller runs: keeps memory bounded and can't deadlock a worker waiting on itself.
+        t.execute();
+        return;
+    }
+
+    size_t target;
+    if( current_pool == this ) {
+        target = current_worker;
+    } else {
+        target = next_queue.fetch_add( 1 ) % queues.size();
+    }
+    {
+        worker_queue &q = *queues[target];
+        std::lock_guard<std::mutex> lk( q.mutex );
+        q.tasks[static_cast<size_t>( priority )].push_back( std::move( t ) );
+        queued++;
+    }
+    {
+        // Taking the lock orders this against a worker checking for work before sleeping.
+        std::lock_guard<std::mutex> lk( sleep_mutex );
+    }
+    sleep_cv.notify_one();
+}
+
+bool thread_pool::try_pop( size_t worker, task &out )
+{
+    // Highest priority first; within a priority, own queue from the front, then steal
+    // from the back of the others, which holds the most recently queued tasks.
+    for( size_t prio = 0; prio < static_cast<size_t>( task_priority::num_priorities ); prio++ ) {
+        for( size_t offset = 0; offset < queues.size(); offset++ ) {
+            const size_t victim = ( worker + offset ) % queues.size();
+            worker_queue &q = *queues[victim];
+            std::lock_guard<std::mutex> lk( q.mutex );
+            std::deque<task> &tasks = q.tasks[prio];
+            if( tasks.empty() ) {
+                continue;
+            }
+            if( victim == worker ) {
+                out = std::move( tasks.front() );
+                tasks.pop_front();
+            } else {
+                out = std::move( tasks.back() );
+                tasks.pop_back();
+            }
+            queued--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void thread_pool::worker_loop( size_t worker )
+{
+    current_pool = this;
+    current_worker = worker;
+    while( true ) {
+        task t;
+        if( try_pop( worker, t ) ) {
+            t.execute();
+            continue;
+        }
+        std::unique_lock<std::mutex> lk( sleep_mutex );
+        sleep_cv.wait( lk, [this]() {
+            return stopping || queued.load() > 0;
+        } );
+        if( stopping ) {
+            return;
+        }
+    }
+}
+
+thread_pool &get_thread_pool()
+{
+    static thread_pool pool( std::max( 1u, std::thread::hardware_concurrency() ) - 1, 1024 );
+    return pool;
+}
+
+} // namespace cata
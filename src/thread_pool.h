@@ -0,0 +1,192 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cata
+{
+
+/** Order in which queued tasks are started. Running tasks are never preempted. */
+enum class task_priority : int {
+    high = 0,
+    normal,
+    low,
+    num_priorities
+};
+
+/** Reported through the future of a task that was cancelled before it started. */
+class task_cancelled : public std::runtime_error
+{
+    public:
+        task_cancelled() : std::runtime_error( "task cancelled" ) {}
+};
+
+/**
+ * Shared flag for cancelling a group of tasks. Copies refer to the same flag.
+ * Tasks that already started are not interrupted, but may poll @ref cancelled.
+ */
+class cancellation_token
+{
+    public:
+        void cancel() {
+            flag->store( true );
+        }
+        bool cancelled() const {
+            return flag->load();
+        }
+
+    private:
+        std::shared_ptr<std::atomic<bool>> flag = std::make_shared<std::atomic<bool>>( false );
+};
+
+/**
+ * Type-erased `void()` callable for queued tasks. Unlike std::function it takes
+ * move-only callables, such as lambdas owning a std::unique_ptr or a std::promise.
+ */
+class task_function
+{
+    public:
+        task_function() = default;
+        template<typename F>
+        requires( !std::is_same_v<std::decay_t<F>, task_function> )
+        explicit task_function( F &&func ) :
+            impl( std::make_unique<callable<std::decay_t<F>>>( std::forward<F>( func ) ) ) {}
+
+        void operator()() {
+            impl->call();
+        }
+
+    private:
+        struct callable_base {
+            virtual ~callable_base() = default;
+            virtual void call() = 0;
+        };
+
+        template<typename F>
+        struct callable : callable_base {
+            F func;
+            explicit callable( F &&func ) : func( std::move( func ) ) {}
+            explicit callable( const F &func ) : func( func ) {}
+            void call() override {
+                func();
+            }
+        };
+
+        std::unique_ptr<callable_base> impl;
+};
+
+/**
+ * Fixed set of worker threads with per-worker task queues.
+ *
+ * Tasks submitted from a worker go to that worker's queue, other threads spread
+ * theirs round-robin. Idle workers take from the front of their own queue and
+ * steal from the back of the others. The number of queued tasks is bounded: once
+ * full, @ref submit runs the task on the calling thread instead.
+ *
+ * Use @ref get_thread_pool for the process-wide instance rather than creating
+ * new pools, so concurrent subsystems don't oversubscribe the cores.
+ */
+class thread_pool
+{
+    public:
+        thread_pool( size_t num_threads, size_t max_queued );
+        ~thread_pool();
+
+        thread_pool( const thread_pool & ) = delete;
+        thread_pool &operator=( const thread_pool & ) = delete;
+
+        /**
+         * Queue @p func to run on a worker.
+         * @returns Future for the result of @p func, or holding @ref task_cancelled
+         * if @p token was cancelled before the task started.
+         */
+        template<typename F>
+        auto submit( F &&func, task_priority priority = task_priority::normal,
+                     const cancellation_token &token = cancellation_token() )
+        -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+            using result_t = std::invoke_result_t<std::decay_t<F>>;
+            auto promise = std::make_shared<std::promise<result_t>>();
+            std::future<result_t> ret = promise->get_future();
+
+            task t;
+            t.token = token;
+            t.run = task_function( [promise, func = std::forward<F>( func )]() mutable {
+                try {
+                    if constexpr( std::is_void_v<result_t> ) {
+                        func();
+                        promise->set_value();
+                    } else {
+                        promise->set_value( func() );
+                    }
+                } catch( ... ) {
+                    promise->set_exception( std::current_exception() );
+                }
+            } );
+            t.cancel = task_function( [promise]() {
+                promise->set_exception( std::make_exception_ptr( task_cancelled() ) );
+            } );
+            enqueue( std::move( t ), priority );
+            return ret;
+        }
+
+        size_t num_threads() const {
+            return workers.size();
+        }
+
+        /** Number of tasks queued but not started yet. */
+        size_t num_queued() const {
+            return queued.load();
+        }
+
+    private:
+        struct task {
+            task_function run;
+            task_function cancel;
+            cancellation_token token;
+
+            void execute() {
+                if( token.cancelled() ) {
+                    cancel();
+                } else {
+                    run();
+                }
+            }
+        };
+
+        struct worker_queue {
+            std::mutex mutex;
+            std::array<std::deque<task>, static_cast<size_t>( task_priority::num_priorities )> tasks;
+        };
+
+        void enqueue( task &&t, task_priority priority );
+        bool try_pop( size_t worker, task &out );
+        void worker_loop( size_t worker );
+
+        std::vector<std::unique_ptr<worker_queue>> queues;
+        std::vector<std::thread> workers;
+        size_t max_queued;
+        std::atomic<size_t> queued{ 0 };
+        std::atomic<size_t> next_queue{ 0 };
+
+        // Only used for sleeping and waking idle workers.
+        std::mutex sleep_mutex;
+        std::condition_variable sleep_cv;
+        bool stopping = false;
+};
+
+/** The process-wide pool, sized to leave one core for the main thread. */
+thread_pool &get_thread_pool();
+
+} // namespace cata
@@ -5552,6 +5552,21 @@ void vehicle::make_active( item &target )
     active_items.add( target );
 }
 
+void vehicle::wake_item( item &it, const int part )
+{
+    if( it.is_food() && active_items.wake( it ) ) {
+        it.accumulate_rot( global_part_pos3( part ), parts[part].cargo_temperature, get_weather(),
+                           false );
+    }
+}
+
+void vehicle::wake_items( const int part )
+{
+    for( item *it : parts[part].items ) {
+        wake_item( *it, part );
+    }
+}
+
 detached_ptr<item> vehicle::add_charges( int part, detached_ptr<item> &&itm )
 {
     if( !itm->count_by_charges() ) {
@@ -5651,6 +5666,7 @@ detached_ptr<item> vehicle::remove_item( int part, item *it )
 vehicle_stack::iterator vehicle::remove_item( int part, vehicle_stack::const_iterator it,
         detached_ptr<item> *ret )
 {
+    wake_item( **it, part );
     // remove from the active items cache (if it isn't there does nothing)
     active_items.remove( *it );
 
@@ -5797,6 +5813,7 @@ void vehicle::gain_moves()
 void vehicle::dump_items_from_part( const size_t index )
 {
     vehicle_part &vp = parts[ index ];
+    wake_items( static_cast<int>( index ) );
     for( detached_ptr<item> &e : vp.items.clear() ) {
         g->m.add_item_or_charges( global_part_pos3( vp ), std::move( e ) );
     }
@@ -6923,6 +6940,8 @@ int vehicle::damage_direct( int p, int dmg, damage_type type )
         stop_autodriving();
     }
     here.set_memory_seen_cache_dirty( global_part_pos3( p ) );
+    // Bashing costs depend on the part's remaining hp
+    here.set_pathfinding_cache_dirty( global_part_pos3( p ) );
     if( parts[p].is_broken() ) {
         return break_off( p, dmg );
     }
@@ -6945,6 +6964,7 @@ int vehicle::damage_direct( int p, int dmg, damage_type type )
         // destroyed parts lose any contained fuels, battery charges or ammo
         leak_fuel( parts [ p ] );
 
+        wake_items( p );
         for( auto &e : parts[p].items.clear() ) {
             g->m.add_item_or_charges( global_part_pos3( p ), std::move( e ) );
         }
@@ -1260,6 +1260,13 @@ class vehicle
          * hot or perishable liquid to a container.
          */
         void make_active( item &target );
+        /**
+         * Catches up on the rot of a perishable in the cargo of @p part that processing
+         * put to sleep, see map::wake_item.
+         */
+        void wake_item( item &it, int part );
+        /** Wakes all of the cargo of @p part, e.g. before it leaves the vehicle. */
+        void wake_items( int part );
         /**
          * Try to add an item to part's cargo.
          */
@@ -16,6 +16,7 @@
 #include "game.h"
 #include "item.h"
 #include "item_contents.h"
+#include "item_summary.h"
 #include "itype.h"
 #include "locations.h"
 #include "map.h"
@@ -84,6 +85,7 @@ void vehicle_part::copy_static_from( const vehicle_part &source )
     removed = source.removed;
     enabled = source.enabled;
     flags = source.flags;
+    cargo_temperature = source.cargo_temperature;
     passenger_id = source.passenger_id;
     open = source.open;
     direction = source.direction;
@@ -195,6 +197,12 @@ void vehicle_part::add_item( detached_ptr<item> &&item )
     items.push_back( std::move( item ) );
 }
 
+const item_summary &vehicle_part::items_summary() const
+{
+    return static_cast<const item_pile_location *>( items.get_location() )->get_summary(
+               items.as_vector() );
+}
+
 std::string vehicle_part::name( bool with_prefix ) const
 {
     auto res = info().name();
@@ -14,6 +14,7 @@
 
 class vehicle;
 class item_location;
+struct item_summary;
 class vehicle_cursor;
 class npc;
 
@@ -260,6 +261,12 @@ struct vehicle_part {
         bool enabled = true;
         int flags = 0;
 
+        /**
+         * Temperature of the cargo when it was last processed. Perishables asleep in it
+         * rot at this one, they are woken when it changes. Not saved.
+         */
+        temperature_flag cargo_temperature = temperature_flag::TEMP_NORMAL;
+
         /** ID of player passenger */
         character_id passenger_id;
 
@@ -316,6 +323,9 @@ struct vehicle_part {
             return items.as_vector();
         }
 
+        /** Summary of @ref get_items, kept until the items change. */
+        const item_summary &items_summary() const;
+
         std::vector<detached_ptr<item>> clear_items() {
             return items.clear();
         }
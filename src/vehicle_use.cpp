@@ -1635,6 +1635,7 @@ void vehicle::open_or_close( const int part_index, const bool opening )
     here.set_transparency_cache_dirty( sm_pos.z );
     const tripoint part_location = mount_to_tripoint( parts[part_index].mount );
     here.set_seen_cache_dirty( part_location );
+    here.set_pathfinding_cache_dirty( part_location );
     const int dist = rl_dist( get_player_character().pos(), part_location );
     if( dist < 20 ) {
         sfx::play_variant_sound( opening ? "vehicle_open" : "vehicle_close",
@@ -1643,6 +1644,7 @@ void vehicle::open_or_close( const int part_index, const bool opening )
     for( auto const &vec : find_lines_of_parts( part_index, "OPENABLE" ) ) {
         for( auto const &partID : vec ) {
             parts[partID].open = opening;
+            here.set_pathfinding_cache_dirty( mount_to_tripoint( parts[partID].mount ) );
         }
     }
 
@@ -823,11 +823,13 @@ void location_visitable<map_cursor>::remove_items_with( const
     point offset;
     submap *sub = here.get_submap_at( *cur, offset );
 
-    visit_internal( [&filter, sub, offset]( detached_ptr<item> &&e ) {
+    visit_internal( [&filter, &here, cur, sub, offset]( detached_ptr<item> &&e ) {
         item &obj = *e;
         VisitResponse res = filter( std::move( e ) );
         // NOLINTNEXTLINE(bugprone-use-after-move)
         if( !e ) {
+            // Sleeping food keeps its rot state until it would change, the rest is caught up here
+            here.wake_item( obj, *cur );
             // remove from the active items cache (if it isn't there does nothing)
             sub->active_items.remove( &obj );
 
@@ -875,10 +877,14 @@ void location_visitable<vehicle_cursor>::remove_items_with( const
     vehicle_part &part = cur->veh.part( idx );
     bool removed = false;
 
-    visit_internal( [&filter, &removed]( detached_ptr<item> &&e ) {
+    visit_internal( [&filter, &removed, cur, idx]( detached_ptr<item> &&e ) {
+        item &obj = *e;
         VisitResponse ret = filter( std::move( e ) );
         // NOLINTNEXTLINE(bugprone-use-after-move)
         if( !e ) {
+            // Same as for the map, see location_visitable<map_cursor>::remove_items_with
+            cur->veh.wake_item( obj, idx );
+            cur->veh.active_items.remove( &obj );
             removed = true;
         }
         return ret;
@@ -2,21 +2,29 @@
 
 #include <algorithm>
 #include <sstream>
+#include <condition_variable>
 #include <cstring>
 #include <chrono>
+#include <deque>
+#include <future>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
 
 #include "game.h"
 #include "avatar.h"
 #include "debug.h"
 #include "cata_utility.h"
 #include "filesystem.h"
+#include "memory_stream.h"
 #include "output.h"
 #include "worldfactory.h"
 #include "mod_manager.h"
 #include "path_info.h"
 #include "compress.h"
 #include "sqlite3.h"
-#include "zlib.h"
 
 #define dbg(x) DebugLogFL((x),DC::Main)
 static sqlite3 *open_db( const std::string &path )
@@ -43,6 +51,11 @@ static sqlite3 *open_db( const std::string &path )
             compression    TEXT DEFAULT NULL,
             data           BLOB NOT NULL
         );
+        CREATE TABLE IF NOT EXISTS dictionaries (
+            name           TEXT PRIMARY KEY NOT NULL,
+            data           BLOB NOT NULL,
+            created        INTEGER NOT NULL
+        );
     )sql";
 
     char *sqlErrMsg = 0;
@@ -299,21 +312,18 @@ static bool file_exist_in_db( sqlite3 *db, const std::string &path )
     return fileCount > 0;
 }
 
-static void write_to_db( sqlite3 *db, const std::string &path, file_write_fn writer )
+static void write_blob_to_db( sqlite3 *db, const std::string &path, const std::string &data,
+                              const compression_codec &codec )
 {
-    std::ostringstream oss;
-    writer( oss );
-    auto data = oss.str();
-
     std::vector<std::byte> compressedData;
-    zlib_compress( data, compressedData );
+    codec.compress( data, compressedData );
 
     size_t basePos = path.find_last_of( "/\\" );
     auto parent = ( basePos == std::string::npos ) ? "" : path.substr( 0, basePos );
 
     auto sql = R"sql(
         INSERT INTO files(path, parent, data, compression)
-        VALUES (:path, :parent, :data, 'zlib')
+        VALUES (:path, :parent, :data, :compression)
         ON CONFLICT(path) DO UPDATE
             SET data = excluded.data,
                 parent = excluded.parent,
@@ -332,7 +342,9 @@ static void write_to_db( sqlite3 *db, const std::string &path, file_write_fn wri
         sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":parent" ), parent.c_str(), -1,
                            SQLITE_TRANSIENT ) != SQLITE_OK ||
         sqlite3_bind_blob( stmt, sqlite3_bind_parameter_index( stmt, ":data" ), compressedData.data(),
-                           compressedData.size(), SQLITE_TRANSIENT ) != SQLITE_OK ) {
+                           compressedData.size(), SQLITE_TRANSIENT ) != SQLITE_OK ||
+        sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":compression" ),
+                           codec.name().c_str(), -1, SQLITE_TRANSIENT ) != SQLITE_OK ) {
         dbg( DL::Error ) << "Failed to bind parameters: " << sqlite3_errmsg( db ) << '\n';
         sqlite3_finalize( stmt );
         throw std::runtime_error( "DB query failed" );
@@ -344,11 +356,153 @@ static void write_to_db( sqlite3 *db, const std::string &path, file_write_fn wri
     sqlite3_finalize( stmt );
 }
 
-static bool read_from_db( sqlite3 *db, const std::string &path, file_read_fn reader,
-                          bool optional )
+static std::string serialize_for_db( file_write_fn writer )
 {
-    const char *sql = "SELECT data, compression FROM files WHERE path = :path LIMIT 1";
+    std::ostringstream oss;
+    writer( oss );
+    return oss.str();
+}
+
+static void write_to_db( sqlite3 *db, const std::string &path, file_write_fn writer,
+                         const compression_codec &codec = compression::default_codec() )
+{
+    write_blob_to_db( db, path, serialize_for_db( writer ), codec );
+}
+
+/**
+ * Moves compression and SQLite inserts of a save transaction off the main thread.
+ *
+ * The main thread only serializes file contents and queues them. While the writer is
+ * running it is the sole user of the database connection, so any main thread access
+ * to the database must call @ref drain first.
+ */
+class db_write_queue
+{
+    public:
+        db_write_queue( sqlite3 *db, const compression_codec &codec ) : db( db ), codec( codec ) {
+            worker = std::thread( [this]() {
+                run();
+            } );
+        }
 
+        ~db_write_queue() {
+            {
+                std::lock_guard<std::mutex> lk( mutex );
+                stopping = true;
+            }
+            cv_work.notify_all();
+            if( worker.joinable() ) {
+                worker.join();
+            }
+        }
+
+        db_write_queue( const db_write_queue & ) = delete;
+        db_write_queue &operator=( const db_write_queue & ) = delete;
+
+        void push( const std::string &path, std::string &&data ) {
+            std::unique_lock<std::mutex> lk( mutex );
+            // Apply backpressure so a huge save doesn't hold the whole world in memory twice.
+            if( queued_bytes > max_queued_bytes ) {
+                const auto wait_start = std::chrono::steady_clock::now();
+                cv_done.wait( lk, [this]() {
+                    return queued_bytes <= max_queued_bytes;
+                } );
+                stats.main_thread_wait_ms += ms_since( wait_start );
+            }
+            stats.files_written++;
+            stats.bytes_serialized += data.size();
+            queued_bytes += data.size();
+            queue.emplace_back( path, std::move( data ) );
+            lk.unlock();
+            cv_work.notify_one();
+        }
+
+        /** Block until every queued write has been committed to the connection. */
+        void drain() {
+            std::unique_lock<std::mutex> lk( mutex );
+            if( queue.empty() && !busy ) {
+                return;
+            }
+            const auto wait_start = std::chrono::steady_clock::now();
+            cv_done.wait( lk, [this]() {
+                return queue.empty() && !busy;
+            } );
+            stats.main_thread_wait_ms += ms_since( wait_start );
+        }
+
+        /** Drains the queue and returns collected statistics. Rethrows the first worker error. */
+        save_tx_stats finish() {
+            drain();
+            std::lock_guard<std::mutex> lk( mutex );
+            if( !error.empty() ) {
+                throw std::runtime_error( "Background save failed: " + error );
+            }
+            return stats;
+        }
+
+    private:
+        static constexpr size_t max_queued_bytes = 64 * 1024 * 1024;
+
+        static int64_t ms_since( std::chrono::steady_clock::time_point start ) {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now() - start ).count();
+        }
+
+        void run() {
+            std::unique_lock<std::mutex> lk( mutex );
+            while( true ) {
+                cv_work.wait( lk, [this]() {
+                    return stopping || !queue.empty();
+                } );
+                if( queue.empty() ) {
+                    return;
+                }
+                std::pair<std::string, std::string> job = std::move( queue.front() );
+                queue.pop_front();
+                busy = true;
+                lk.unlock();
+
+                const auto work_start = std::chrono::steady_clock::now();
+                std::string err;
+                try {
+                    write_blob_to_db( db, job.first, job.second, codec );
+                } catch( const std::exception &e ) {
+                    err = job.first + ": " + e.what();
+                }
+                const int64_t work_ms = ms_since( work_start );
+
+                lk.lock();
+                busy = false;
+                queued_bytes -= job.second.size();
+                stats.worker_ms += work_ms;
+                if( error.empty() && !err.empty() ) {
+                    error = err;
+                }
+                cv_done.notify_all();
+            }
+        }
+
+        sqlite3 *db;
+        const compression_codec &codec;
+        std::thread worker;
+        std::mutex mutex;
+        std::condition_variable cv_work;
+        std::condition_variable cv_done;
+        std::deque<std::pair<std::string, std::string>> queue;
+        size_t queued_bytes = 0;
+        bool busy = false;
+        bool stopping = false;
+        std::string error;
+        save_tx_stats stats;
+};
+
+/**
+ * Dictionary codecs are registered the first time a row using them is read,
+ * or when the world picks one for writing.
+ */
+static const compression_codec *load_dictionary_codec( sqlite3 *db, const std::string &name )
+{
+    const char *sql = "SELECT data FROM dictionaries WHERE name = :name LIMIT 1";
     sqlite3_stmt *stmt = nullptr;
 
     if( sqlite3_prepare_v2( db, sql, -1, &stmt, nullptr ) != SQLITE_OK ) {
@@ -356,47 +510,251 @@ static bool read_from_db( sqlite3 *db, const std::string &path, file_read_fn rea
         throw std::runtime_error( "DB query failed" );
     }
 
-    if( sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":path" ), path.c_str(), -1,
+    if( sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":name" ), name.c_str(), -1,
                            SQLITE_TRANSIENT ) != SQLITE_OK ) {
         dbg( DL::Error ) << "Failed to bind parameter: " << sqlite3_errmsg( db ) << '\n';
         sqlite3_finalize( stmt );
         throw std::runtime_error( "DB query failed" );
     }
 
+    const compression_codec *result = nullptr;
     if( sqlite3_step( stmt ) == SQLITE_ROW ) {
-        // Retrieve the count result
         const void *blobData = sqlite3_column_blob( stmt, 0 );
-        int blobSize = sqlite3_column_bytes( stmt, 0 );
-        auto compression_raw = sqlite3_column_text( stmt, 1 );
-        std::string compression = compression_raw ? reinterpret_cast<const char *>( compression_raw ) : "";
-
-        if( blobData == nullptr ) {
-            return false; // Return an empty string if there's no data
+        const int blobSize = sqlite3_column_bytes( stmt, 0 );
+        const std::string dictionary( static_cast<const char *>( blobData ), blobSize );
+        result = &compression::register_dictionary( dictionary );
+        if( result->name() != name ) {
+            dbg( DL::Error ) << "Dictionary " << name << " is corrupted";
+            result = nullptr;
         }
+    }
+    sqlite3_finalize( stmt );
+    return result;
+}
 
-        std::string dataString;
-        if( compression.empty() ) {
-            dataString = std::string( static_cast<const char *>( blobData ), blobSize );
-        } else if( compression == "zlib" ) {
-            zlib_decompress( blobData, blobSize, dataString );
-        } else {
-            throw std::runtime_error( "Unknown compression format: " + compression );
+/** The most recently trained dictionary in the db, if any. */
+static const compression_codec *latest_dictionary_codec( sqlite3 *db )
+{
+    const char *sql = "SELECT name FROM dictionaries ORDER BY created DESC LIMIT 1";
+    sqlite3_stmt *stmt = nullptr;
+
+    if( sqlite3_prepare_v2( db, sql, -1, &stmt, nullptr ) != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
+        throw std::runtime_error( "DB query failed" );
+    }
+
+    std::string name;
+    if( sqlite3_step( stmt ) == SQLITE_ROW ) {
+        name = reinterpret_cast<const char *>( sqlite3_column_text( stmt, 0 ) );
+    }
+    sqlite3_finalize( stmt );
+    return name.empty() ? nullptr : load_dictionary_codec( db, name );
+}
+
+static void decode_blob( sqlite3 *db, const std::string &compression, const void *blobData,
+                         int blobSize, std::string &output )
+{
+    if( compression.empty() ) {
+        output = std::string( static_cast<const char *>( blobData ), blobSize );
+        return;
+    }
+    const compression_codec *codec = compression::find_codec( compression );
+    if( codec == nullptr && compression::is_dictionary_codec( compression ) ) {
+        codec = load_dictionary_codec( db, compression );
+    }
+    if( codec == nullptr ) {
+        throw std::runtime_error( "Unknown compression format: " + compression );
+    }
+    codec->decompress( blobData, blobSize, output );
+}
+
+/**
+ * Map db format versions, stored as the db's user_version. Builds refuse to open
+ * map data of a version newer than they know.
+ * 0: rows only use built in codecs.
+ * 1: rows may use dictionary codecs, stored in the dictionaries table.
+ */
+static constexpr int map_db_version_dictionaries = 1;
+static constexpr int map_db_version = map_db_version_dictionaries;
+
+static int get_db_version( sqlite3 *db )
+{
+    sqlite3_stmt *stmt = nullptr;
+    if( sqlite3_prepare_v2( db, "PRAGMA user_version", -1, &stmt, nullptr ) != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
+        throw std::runtime_error( "DB query failed" );
+    }
+    const int version = sqlite3_step( stmt ) == SQLITE_ROW ? sqlite3_column_int( stmt, 0 ) : 0;
+    sqlite3_finalize( stmt );
+    return version;
+}
+
+static bool set_db_version( sqlite3 *db, const int version )
+{
+    const std::string sql = string_format( "PRAGMA user_version = %d", version );
+    if( sqlite3_exec( db, sql.c_str(), nullptr, nullptr, nullptr ) != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to set db version: " << sqlite3_errmsg( db ) << '\n';
+        return false;
+    }
+    return true;
+}
+
+// Enough quads that a sample represents more than the starting area
+static constexpr int min_dictionary_quads = 256;
+static constexpr size_t max_dictionary_size = 32 * 1024;
+
+static int count_map_quads( sqlite3 *db )
+{
+    sqlite3_stmt *stmt = nullptr;
+    if( sqlite3_prepare_v2( db, "SELECT count(*) FROM files WHERE path LIKE 'maps/%'", -1, &stmt,
+                            nullptr ) != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
+        return 0;
+    }
+    const int count = sqlite3_step( stmt ) == SQLITE_ROW ? sqlite3_column_int( stmt, 0 ) : 0;
+    sqlite3_finalize( stmt );
+    return count;
+}
+
+/** Decompressed contents of up to @p count map quads picked at random. */
+static std::vector<std::string> sample_map_quads( sqlite3 *db, const int count )
+{
+    // Only the row ids are shuffled, the blobs are read just for the picked rows
+    const char *sql = R"sql(
+        SELECT data, compression FROM files WHERE rowid IN (
+            SELECT rowid FROM files WHERE path LIKE 'maps/%' ORDER BY random() LIMIT :limit
+        )
+    )sql";
+    sqlite3_stmt *stmt = nullptr;
+
+    if( sqlite3_prepare_v2( db, sql, -1, &stmt, nullptr ) != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
+        return {};
+    }
+    sqlite3_bind_int( stmt, sqlite3_bind_parameter_index( stmt, ":limit" ), count );
+
+    std::vector<std::string> samples;
+    try {
+        while( sqlite3_step( stmt ) == SQLITE_ROW ) {
+            const auto compression_raw = sqlite3_column_text( stmt, 1 );
+            const std::string compression = compression_raw ?
+                                            reinterpret_cast<const char *>( compression_raw ) : "";
+            std::string data;
+            decode_blob( db, compression, sqlite3_column_blob( stmt, 0 ), sqlite3_column_bytes( stmt, 0 ),
+                         data );
+            samples.push_back( std::move( data ) );
         }
+    } catch( const std::exception &err ) {
+        dbg( DL::Error ) << "Failed to read dictionary samples: " << err.what();
+        samples.clear();
+    }
+    sqlite3_finalize( stmt );
+    return samples;
+}
+
+/**
+ * Store a trained dictionary in the db and raise its version, so builds that
+ * can't read dictionary codecs refuse it.
+ * @returns nullptr if it couldn't be stored.
+ */
+static const compression_codec *store_map_dictionary( sqlite3 *db, const std::string &dictionary )
+{
+    const compression_codec &codec = compression::register_dictionary( dictionary );
 
-        std::istringstream stream( dataString );
-        reader( stream );
+    const char *sql =
+        "INSERT OR IGNORE INTO dictionaries(name, data, created) VALUES (:name, :data, :created)";
+    sqlite3_stmt *stmt = nullptr;
+    if( sqlite3_prepare_v2( db, sql, -1, &stmt, nullptr ) != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
+        return nullptr;
+    }
+    const int64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+                            std::chrono::system_clock::now().time_since_epoch() ).count();
+    if( sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":name" ), codec.name().c_str(),
+                           -1, SQLITE_TRANSIENT ) != SQLITE_OK ||
+        sqlite3_bind_blob( stmt, sqlite3_bind_parameter_index( stmt, ":data" ), dictionary.data(),
+                           dictionary.size(), SQLITE_TRANSIENT ) != SQLITE_OK ||
+        sqlite3_bind_int64( stmt, sqlite3_bind_parameter_index( stmt, ":created" ), now ) != SQLITE_OK ||
+        sqlite3_step( stmt ) != SQLITE_DONE ) {
+        dbg( DL::Error ) << "Failed to store dictionary: " << sqlite3_errmsg( db ) << '\n';
         sqlite3_finalize( stmt );
-    } else {
-        auto err = sqlite3_errmsg( db );
+        return nullptr;
+    }
+    sqlite3_finalize( stmt );
+
+    if( get_db_version( db ) < map_db_version_dictionaries &&
+        !set_db_version( db, map_db_version_dictionaries ) ) {
+        return nullptr;
+    }
+
+    dbg( DL::Info ) << "Trained map compression dictionary " << codec.name() << " ("
+                    << dictionary.size() << " bytes)";
+    return &codec;
+}
+
+/**
+ * Fetch and decompress the blob stored at @p path.
+ * @returns false if there is no such row.
+ * @throws std::runtime_error if the query fails or the blob can't be decoded.
+ */
+static bool read_blob_from_db( sqlite3 *db, const std::string &path, std::string &output )
+{
+    const char *sql = "SELECT data, compression FROM files WHERE path = :path LIMIT 1";
+
+    sqlite3_stmt *stmt = nullptr;
+
+    if( sqlite3_prepare_v2( db, sql, -1, &stmt, nullptr ) != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
+        throw std::runtime_error( "DB query failed" );
+    }
+
+    if( sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":path" ), path.c_str(), -1,
+                           SQLITE_TRANSIENT ) != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to bind parameter: " << sqlite3_errmsg( db ) << '\n';
+        sqlite3_finalize( stmt );
+        throw std::runtime_error( "DB query failed" );
+    }
+
+    if( sqlite3_step( stmt ) != SQLITE_ROW ) {
         sqlite3_finalize( stmt );
+        return false;
+    }
+
+    // Retrieve the count result
+    const void *blobData = sqlite3_column_blob( stmt, 0 );
+    int blobSize = sqlite3_column_bytes( stmt, 0 );
+    auto compression_raw = sqlite3_column_text( stmt, 1 );
+    std::string compression = compression_raw ? reinterpret_cast<const char *>( compression_raw ) : "";
+
+    if( blobData == nullptr ) {
+        sqlite3_finalize( stmt );
+        return false; // Return an empty string if there's no data
+    }
 
+    try {
+        decode_blob( db, compression, blobData, blobSize, output );
+    } catch( const std::exception & ) {
+        sqlite3_finalize( stmt );
+        throw;
+    }
+    sqlite3_finalize( stmt );
+    return true;
+}
+
+static bool read_from_db( sqlite3 *db, const std::string &path, file_read_fn reader,
+                          bool optional )
+{
+    std::string dataString;
+    if( !read_blob_from_db( db, path, dataString ) ) {
         if( !optional ) {
-            dbg( DL::Error ) << "Failed to execute query: " << err << '\n';
+            dbg( DL::Error ) << "Failed to execute query: " << sqlite3_errmsg( db ) << '\n';
             throw std::runtime_error( "DB query failed" );
         }
         return false;
     }
 
+    memory_istream stream( dataString );
+    reader( stream );
     return true;
 }
 
@@ -409,9 +767,220 @@ static bool read_from_db_json( sqlite3 *db, const std::string &path, file_read_j
     }, optional );
 }
 
+/**
+ * Reads and decompresses map quads on a background thread ahead of the main thread
+ * asking for them, so @ref world::read_map_quad can return staged data immediately.
+ *
+ * Only raw file contents are staged; parsing still happens on the main thread, since
+ * creating submaps and items isn't thread safe. Staged data is tagged with the
+ * committed write epoch at request time, so the world can tell whether it went stale.
+ *
+ * The worker uses its own read-only connection. It must be paused while the main
+ * connection writes, otherwise the writer could find the database locked.
+ */
+class map_prefetcher
+{
+    public:
+        struct staged_file {
+            bool found = false;
+            std::string data;
+            uint64_t epoch = 0;
+        };
+
+        map_prefetcher( const std::string &folder, bool use_db ) : folder( folder ) {
+            if( use_db ) {
+                if( sqlite3_open_v2( ( folder + "/map.sqlite3" ).c_str(), &db, SQLITE_OPEN_READONLY,
+                                     nullptr ) != SQLITE_OK ) {
+                    sqlite3_close( db );
+                    throw std::runtime_error( "Failed to open map db for prefetching" );
+                }
+            }
+            worker = std::thread( [this]() {
+                run();
+            } );
+        }
+
+        ~map_prefetcher() {
+            {
+                std::lock_guard<std::mutex> lk( mutex );
+                stopping = true;
+            }
+            cv_work.notify_all();
+            if( worker.joinable() ) {
+                worker.join();
+            }
+            if( db ) {
+                sqlite3_close( db );
+            }
+        }
+
+        map_prefetcher( const map_prefetcher & ) = delete;
+        map_prefetcher &operator=( const map_prefetcher & ) = delete;
+
+        /**
+         * Replace the pending requests. Requests from an earlier prediction that weren't
+         * started yet are dropped, the player has probably changed course since.
+         */
+        void request( std::vector<std::pair<std::string, uint64_t>> &&paths ) {
+            std::unique_lock<std::mutex> lk( mutex );
+            pending.clear();
+            for( auto &path : paths ) {
+                if( !staged.contains( path.first ) && path.first != in_flight ) {
+                    pending.push_back( std::move( path ) );
+                }
+            }
+            lk.unlock();
+            cv_work.notify_one();
+        }
+
+        /**
+         * Remove and return the staged contents of @p path, waiting for it if the worker
+         * is reading it right now.
+         */
+        std::optional<staged_file> take( const std::string &path ) {
+            std::unique_lock<std::mutex> lk( mutex );
+            cv_done.wait( lk, [&]() {
+                return in_flight != path;
+            } );
+            std::erase_if( pending, [&]( const std::pair<std::string, uint64_t> &p ) {
+                return p.first == path;
+            } );
+            const auto iter = staged.find( path );
+            if( iter == staged.end() ) {
+                return std::nullopt;
+            }
+            staged_file ret = std::move( iter->second );
+            staged.erase( iter );
+            std::erase( staged_order, path );
+            return ret;
+        }
+
+        /** Whether @p path has been read and was found missing. Doesn't wait for the worker. */
+        bool is_missing( const std::string &path ) {
+            std::lock_guard<std::mutex> lk( mutex );
+            const auto iter = staged.find( path );
+            return iter != staged.end() && !iter->second.found;
+        }
+
+        /**
+         * Drop everything read or about to be read for @p path, it was just written.
+         * Returns whether a read was thrown away.
+         */
+        bool forget( const std::string &path ) {
+            std::lock_guard<std::mutex> lk( mutex );
+            std::erase_if( pending, [&]( const std::pair<std::string, uint64_t> &p ) {
+                return p.first == path;
+            } );
+            if( in_flight == path ) {
+                in_flight_forgotten = true;
+                return true;
+            }
+            if( staged.erase( path ) == 0 ) {
+                return false;
+            }
+            std::erase( staged_order, path );
+            return true;
+        }
+
+        /** Stop starting new reads and wait for the current one. Nests. */
+        void pause() {
+            std::unique_lock<std::mutex> lk( mutex );
+            paused++;
+            cv_done.wait( lk, [this]() {
+                return in_flight.empty();
+            } );
+        }
+
+        void resume() {
+            {
+                std::lock_guard<std::mutex> lk( mutex );
+                paused--;
+            }
+            cv_work.notify_one();
+        }
+
+    private:
+        // A few rows of quads ahead of a fast vehicle on each z-level. Most of them are
+        // missing and only take an entry.
+        static constexpr size_t max_staged = 256;
+
+        void run() {
+            std::unique_lock<std::mutex> lk( mutex );
+            while( true ) {
+                cv_work.wait( lk, [this]() {
+                    return stopping || ( paused == 0 && !pending.empty() );
+                } );
+                if( stopping ) {
+                    return;
+                }
+                const auto [path, epoch] = std::move( pending.front() );
+                pending.pop_front();
+                in_flight = path;
+                lk.unlock();
+
+                staged_file file;
+                file.epoch = epoch;
+                bool ok = true;
+                try {
+                    if( db ) {
+                        file.found = read_blob_from_db( db, path, file.data );
+                    } else {
+                        const std::string full_path = folder + "/" + path;
+                        // Missing files may still exist under a legacy name, leave those
+                        // to the main thread.
+                        ok = ::file_exist( full_path );
+                        if( ok ) {
+                            cata_ifstream fin = std::move( cata_ifstream().mode( cata_ios_mode::binary ).open(
+                                                               full_path ) );
+                            ok = fin.is_open();
+                            if( ok ) {
+                                file.data.assign( std::istreambuf_iterator<char>( *fin ),
+                                                  std::istreambuf_iterator<char>() );
+                                file.found = true;
+                                ok = !fin.bad();
+                            }
+                        }
+                    }
+                } catch( const std::exception & ) {
+                    // The main thread will read it again and report the error.
+                    ok = false;
+                }
+
+                lk.lock();
+                in_flight.clear();
+                if( ok && !in_flight_forgotten ) {
+                    if( staged_order.size() >= max_staged ) {
+                        staged.erase( staged_order.front() );
+                        staged_order.pop_front();
+                    }
+                    staged[path] = std::move( file );
+                    staged_order.push_back( path );
+                }
+                in_flight_forgotten = false;
+                cv_done.notify_all();
+            }
+        }
+
+        std::string folder;
+        sqlite3 *db = nullptr;
+        std::thread worker;
+        std::mutex mutex;
+        std::condition_variable cv_work;
+        std::condition_variable cv_done;
+        std::deque<std::pair<std::string, uint64_t>> pending;
+        std::string in_flight;
+        /** Set when @ref in_flight was written while being read. */
+        bool in_flight_forgotten = false;
+        std::map<std::string, staged_file> staged;
+        std::deque<std::string> staged_order;
+        int paused = 0;
+        bool stopping = false;
+};
+
 world::world( WORLDINFO *info )
     : info( info )
     , save_tx_start_ts( 0 )
+    , map_quads_for_training( min_dictionary_quads )
 {
     if( !assure_dir_exist( "" ) ) {
         dbg( DL::Error ) << "Unable to create or open world directory structure: " << info->folder_path();
@@ -419,6 +988,22 @@ world::world( WORLDINFO *info )
 
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
         map_db = open_db( info->folder_path() + "/map.sqlite3" );
+        const int version = get_db_version( map_db );
+        if( version > map_db_version ) {
+            dbg( DL::Error ) << "Map data in " << info->folder_path() << " has format version " << version
+                             << ", this build only reads up to " << map_db_version;
+            sqlite3_close( map_db );
+            map_db = nullptr;
+            throw std::runtime_error( "Map data was saved by a newer version of the game" );
+        }
+        map_codec = latest_dictionary_codec( map_db );
+        if( map_codec == nullptr ) {
+            map_codec = &compression::default_codec();
+            map_quads_written = count_map_quads( map_db );
+        } else if( version < map_db_version_dictionaries ) {
+            // Stored before the version was raised along with it
+            set_db_version( map_db, map_db_version_dictionaries );
+        }
     } else {
         if( !assure_dir_exist( "/maps" ) ) {
             dbg( DL::Error ) << "Unable to create or open world directory structure: " << info->folder_path();
@@ -432,6 +1017,10 @@ world::~world()
         dbg( DL::Error ) << "Save transaction was not committed before world destruction";
     }
 
+    // The background writer and reader may still be using the database.
+    map_db_queue.reset();
+    map_prefetch.reset();
+
     if( map_db ) {
         sqlite3_close( map_db );
     }
@@ -451,7 +1040,14 @@ void world::start_save_tx()
                        ).count();
 
     if( map_db ) {
+        if( map_prefetch ) {
+            map_prefetch->pause();
+        }
+        adopt_map_dictionary();
         sqlite3_exec( map_db, "BEGIN TRANSACTION", NULL, NULL, NULL );
+        if( get_option<bool>( "ASYNC_SAVE" ) ) {
+            map_db_queue = std::make_unique<db_write_queue>( map_db, *map_codec );
+        }
     }
 
     if( save_db ) {
@@ -465,22 +1061,152 @@ int64_t world::commit_save_tx()
         throw std::runtime_error( "Attempted to commit a save transaction while none was in progress" );
     }
 
-    if( map_db ) {
-        sqlite3_exec( map_db, "COMMIT", NULL, NULL, NULL );
+    last_save_stats = save_tx_stats();
+    if( map_db_queue ) {
+        try {
+            last_save_stats = map_db_queue->finish();
+        } catch( const std::exception & ) {
+            // A partial save must never be committed, fail it like a synchronous write would
+            map_db_queue.reset();
+            rollback_save_tx();
+            throw;
+        }
+        map_db_queue.reset();
+    }
+
+    const auto commit_start = std::chrono::steady_clock::now();
+    if( map_db && sqlite3_exec( map_db, "COMMIT", NULL, NULL, NULL ) != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to commit map data: " << sqlite3_errmsg( map_db );
+        rollback_save_tx();
+        throw std::runtime_error( "Failed to commit map data" );
     }
 
     if( save_db ) {
         sqlite3_exec( save_db, "COMMIT", NULL, NULL, NULL );
     }
 
+    last_save_stats.commit_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                    std::chrono::steady_clock::now() - commit_start ).count();
+    commit_map_write_epochs();
+    if( map_db && map_prefetch ) {
+        map_prefetch->resume();
+    }
+    for( const std::function<void()> &on_committed : map_commit_callbacks ) {
+        on_committed();
+    }
+    map_commit_callbacks.clear();
+
     int64_t now = std::chrono::duration_cast< std::chrono::milliseconds >(
                       std::chrono::system_clock::now().time_since_epoch()
                   ).count();
     int64_t duration = now - save_tx_start_ts;
     save_tx_start_ts = 0;
+    last_save_stats.total_ms = duration;
+
+    dbg( DL::Info ) << "Save committed in " << duration << "ms ("
+                    << last_save_stats.main_thread_wait_ms << "ms waiting on background writer, "
+                    << last_save_stats.worker_ms << "ms background work, "
+                    << last_save_stats.commit_ms << "ms commit, "
+                    << last_save_stats.files_written << " files, "
+                    << last_save_stats.bytes_serialized << " bytes)";
+    if( prefetch_stats.requested > 0 ) {
+        dbg( DL::Info ) << "Map prefetch: " << prefetch_stats.requested << " requested, "
+                        << prefetch_stats.hits << " hits, " << prefetch_stats.misses << " misses, "
+                        << prefetch_stats.stale << " stale";
+    }
+
+    start_map_dictionary_training();
     return duration;
 }
 
+void world::start_map_dictionary_training()
+{
+    // Once the world has seen enough map data, map writes switch to a trained dictionary.
+    // Existing rows keep their codec and are rewritten as they get saved again.
+    if( !map_db || compression::is_dictionary_codec( map_codec->name() ) ||
+        map_dictionary_training.valid() || map_quads_written < map_quads_for_training ) {
+        return;
+    }
+    // Overwrites were counted too, look at what is really there
+    map_quads_written = count_map_quads( map_db );
+    if( map_quads_written < map_quads_for_training ) {
+        return;
+    }
+    // Should training come up empty, wait for the world to double before the next try
+    map_quads_for_training = map_quads_written * 2;
+
+    std::vector<std::string> samples = sample_map_quads( map_db, min_dictionary_quads );
+    map_dictionary_training = std::async( std::launch::async,
+    [samples = std::move( samples )]() {
+        return compression::train_dictionary( samples, max_dictionary_size );
+    } );
+}
+
+void world::adopt_map_dictionary()
+{
+    if( !map_dictionary_training.valid() ||
+        map_dictionary_training.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready ) {
+        return;
+    }
+    const std::string dictionary = map_dictionary_training.get();
+    if( dictionary.empty() ) {
+        return;
+    }
+    // Stored outside of the save transaction, no row may use it before it is committed
+    if( const compression_codec *trained = store_map_dictionary( map_db, dictionary ) ) {
+        map_codec = trained;
+    }
+}
+
+void world::rollback_save_tx()
+{
+    if( map_db ) {
+        sqlite3_exec( map_db, "ROLLBACK", NULL, NULL, NULL );
+        if( map_prefetch ) {
+            map_prefetch->resume();
+        }
+    }
+
+    if( save_db ) {
+        sqlite3_exec( save_db, "ROLLBACK", NULL, NULL, NULL );
+    }
+    map_commit_callbacks.clear();
+    save_tx_start_ts = 0;
+}
+
+void world::drain_map_db_queue() const
+{
+    if( map_db_queue ) {
+        map_db_queue->drain();
+    }
+}
+
+void world::write_map_db( const std::string &path, file_write_fn writer ) const
+{
+    if( map_db_queue ) {
+        map_db_queue->push( path, serialize_for_db( writer ) );
+    } else if( map_prefetch && save_tx_start_ts == 0 ) {
+        // Outside of a save transaction the prefetcher isn't paused yet.
+        map_prefetch->pause();
+        try {
+            write_to_db( map_db, path, writer, *map_codec );
+        } catch( ... ) {
+            map_prefetch->resume();
+            throw;
+        }
+        map_prefetch->resume();
+    } else {
+        write_to_db( map_db, path, writer, *map_codec );
+    }
+}
+
+void world::commit_map_write_epochs() const
+{
+    map_committed_epoch = map_write_epoch;
+    // Nothing prefetched from before these writes is left, and later prefetches see them.
+    map_quad_write_epochs.clear();
+}
+
 /**
  * DOMAIN SPECIFIC: MAP
  */
@@ -496,44 +1222,150 @@ static std::string get_quad_filename( const tripoint &om_addr )
     return string_format( "%d.%d.%d.map", om_addr.x, om_addr.y, om_addr.z );
 }
 
-bool world::read_map_quad( const tripoint &om_addr, file_read_json_fn reader ) const
+// Fix for old saves where the path was generated using std::stringstream, which
+// did format the number using the current locale. That formatting may insert
+// thousands separators, so the resulting path is "map/1,234.7.8.map" instead
+// of "map/1234.7.8.map".
+static std::string get_legacy_quad_path( const std::string &dirname, const tripoint &om_addr )
+{
+    std::ostringstream buffer;
+    buffer << dirname << "/" << om_addr.x << "." << om_addr.y << "." << om_addr.z << ".map";
+    return buffer.str();
+}
+
+bool world::read_map_quad( const tripoint &om_addr,
+                           const std::function<void( std::istream &, const std::string & )> &reader ) const
 {
     const std::string dirname = get_quad_dirname( om_addr );
     std::string quad_path = dirname + "/" + get_quad_filename( om_addr );
 
+    if( map_prefetch ) {
+        if( std::optional<map_prefetcher::staged_file> staged = map_prefetch->take( quad_path ) ) {
+            const auto written = map_quad_write_epochs.find( quad_path );
+            if( written == map_quad_write_epochs.end() || written->second <= staged->epoch ) {
+                prefetch_stats.hits++;
+                if( !staged->found ) {
+                    return false;
+                }
+                memory_istream stream( staged->data );
+                reader( stream, quad_path );
+                return true;
+            }
+            prefetch_stats.stale++;
+        }
+        prefetch_stats.misses++;
+    }
+
     // V2 logic
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        return read_from_db_json( map_db, quad_path, reader, true );
+        drain_map_db_queue();
+        return read_from_db( map_db, quad_path, [&]( std::istream & fin ) {
+            reader( fin, quad_path );
+        }, true );
     } else {
         if( !file_exist( quad_path ) ) {
-            // Fix for old saves where the path was generated using std::stringstream, which
-            // did format the number using the current locale. That formatting may insert
-            // thousands separators, so the resulting path is "map/1,234.7.8.map" instead
-            // of "map/1234.7.8.map".
-            std::ostringstream buffer;
-            buffer << dirname << "/" << om_addr.x << "." << om_addr.y << "." << om_addr.z << ".map";
-            if( file_exist( buffer.str() ) ) {
-                quad_path = buffer.str();
+            std::string legacy_path = get_legacy_quad_path( dirname, om_addr );
+            if( file_exist( legacy_path ) ) {
+                quad_path = std::move( legacy_path );
             }
         }
 
-        return read_from_file_json( quad_path, reader, true );
+        return read_from_file( quad_path, [&]( std::istream & fin ) {
+            reader( fin, quad_path );
+        }, true );
+    }
+}
+
+// Pregeneration asks about the same few quads ahead of the player turn after turn
+static constexpr size_t max_cached_quad_lookups = 4096;
+
+bool world::is_map_quad_missing( const tripoint &om_addr ) const
+{
+    const std::string dirname = get_quad_dirname( om_addr );
+    const std::string quad_path = dirname + "/" + get_quad_filename( om_addr );
+    if( map_quad_write_epochs.contains( quad_path ) ) {
+        return false;
+    }
+    if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+        // Asking the database would wait for pending writes, a prefetch knows without that.
+        return map_prefetch && map_prefetch->is_missing( quad_path );
+    }
+    const auto cached = map_quad_missing_cache.find( quad_path );
+    if( cached != map_quad_missing_cache.end() ) {
+        return cached->second;
+    }
+    if( map_quad_missing_cache.size() >= max_cached_quad_lookups ) {
+        map_quad_missing_cache.clear();
     }
+    const bool missing = !file_exist( quad_path ) &&
+                         !file_exist( get_legacy_quad_path( dirname, om_addr ) );
+    map_quad_missing_cache.emplace( quad_path, missing );
+    return missing;
 }
 
-bool world::write_map_quad( const tripoint &om_addr, file_write_fn writer ) const
+bool world::write_map_quad( const tripoint &om_addr, file_write_fn writer,
+                            const std::function<void()> &on_committed ) const
 {
     const std::string dirname = get_quad_dirname( om_addr );
     std::string quad_path = dirname + "/" + get_quad_filename( om_addr );
 
+    map_quad_write_epochs[quad_path] = ++map_write_epoch;
+    if( map_prefetch && map_prefetch->forget( quad_path ) ) {
+        prefetch_stats.stale++;
+    }
+
     // V2 logic
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        write_to_db( map_db, quad_path, writer );
+        write_map_db( quad_path, writer );
+        map_quads_written++;
+        if( save_tx_start_ts == 0 ) {
+            commit_map_write_epochs();
+            if( on_committed ) {
+                on_committed();
+            }
+        } else if( on_committed ) {
+            map_commit_callbacks.push_back( on_committed );
+        }
         return true;
     } else {
         assure_dir_exist( dirname );
-        return write_to_file( quad_path, writer );
+        const bool written = write_to_file( quad_path, writer );
+        map_quad_missing_cache.erase( quad_path );
+        commit_map_write_epochs();
+        if( written && on_committed ) {
+            on_committed();
+        }
+        return written;
+    }
+}
+
+void world::prefetch_map_quads( const std::vector<tripoint> &om_addrs )
+{
+    if( !map_prefetch ) {
+        try {
+            map_prefetch = std::make_unique<map_prefetcher>( info->folder_path(),
+                           info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 );
+        } catch( const std::exception &err ) {
+            dbg( DL::Error ) << err.what();
+            return;
+        }
+        if( save_tx_start_ts != 0 && map_db ) {
+            map_prefetch->pause();
+        }
+    }
+
+    std::vector<std::pair<std::string, uint64_t>> paths;
+    for( const tripoint &om_addr : om_addrs ) {
+        std::string quad_path = get_quad_dirname( om_addr ) + "/" + get_quad_filename( om_addr );
+        const auto written = map_quad_write_epochs.find( quad_path );
+        if( written != map_quad_write_epochs.end() && written->second > map_committed_epoch ) {
+            // Not readable from another connection until the save is committed.
+            continue;
+        }
+        paths.emplace_back( std::move( quad_path ), map_committed_epoch );
     }
+    prefetch_stats.requested += paths.size();
+    map_prefetch->request( std::move( paths ) );
 }
 
 /**
@@ -553,6 +1385,7 @@ std::string world::overmap_player_filename( const point_abs_om &p ) const
 bool world::overmap_exists( const point_abs_om &p ) const
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+        drain_map_db_queue();
         return file_exist_in_db( map_db, overmap_terrain_filename( p ) );
     } else {
         return file_exist( overmap_terrain_filename( p ) );
@@ -562,6 +1395,7 @@ bool world::overmap_exists( const point_abs_om &p ) const
 bool world::read_overmap( const point_abs_om &p, file_read_fn reader ) const
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+        drain_map_db_queue();
         return read_from_db( map_db, overmap_terrain_filename( p ), reader, true );
     } else {
         return read_from_file( overmap_terrain_filename( p ), reader, true );
@@ -581,7 +1415,7 @@ bool world::read_overmap_player_visibility( const point_abs_om &p, file_read_fn
 bool world::write_overmap( const point_abs_om &p, file_write_fn writer ) const
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        write_to_db( map_db, overmap_terrain_filename( p ), writer );
+        write_map_db( overmap_terrain_filename( p ), writer );
         return true;
     } else {
         return write_to_file( overmap_terrain_filename( p ), writer );
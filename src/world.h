@@ -1,7 +1,11 @@
 #pragma once
 
 #include <functional>
+#include <future>
+#include <map>
+#include <memory>
 #include <string>
+#include <vector>
 #include "json.h"
 #include "options.h"
 #include "type_id.h"
@@ -9,6 +13,9 @@
 #include "fstream_utils.h"
 
 class avatar;
+class compression_codec;
+class db_write_queue;
+class map_prefetcher;
 class sqlite3;
 
 class save_t
@@ -43,6 +50,32 @@ enum save_format : int {
     V2_COMPRESSED_SQLITE3 = 1,
 };
 
+/** Timing and volume of the last committed save transaction. */
+struct save_tx_stats {
+    /** Wall time between @ref world::start_save_tx and the end of the commit. */
+    int64_t total_ms = 0;
+    /** Time the main thread spent blocked on the background writer. */
+    int64_t main_thread_wait_ms = 0;
+    /** Time the background writer spent compressing and inserting. */
+    int64_t worker_ms = 0;
+    /** Time spent in the final SQLite COMMIT. */
+    int64_t commit_ms = 0;
+    int files_written = 0;
+    size_t bytes_serialized = 0;
+};
+
+/** Effectiveness of map quad prefetching since the world was loaded. */
+struct map_prefetch_stats {
+    /** Quads handed to the background reader, counting repeated requests. */
+    int requested = 0;
+    /** Quad reads served from prefetched data. */
+    int hits = 0;
+    /** Quad reads that had to go to disk on the main thread. */
+    int misses = 0;
+    /** Prefetched quads thrown away because they were written in the meantime. */
+    int stale = 0;
+};
+
 /**
  * Structure containing metadata about a world. No actual world data is processed here.
  *
@@ -99,19 +132,52 @@ class world
          *
          * When using the V1 non-sqlite save system, this merely records some metadata
          * so we can print how long the save took.
+         *
+         * With the ASYNC_SAVE option, map database writes made during the transaction
+         * are compressed and inserted by a background thread; the commit waits for it.
          */
         /**@{*/
         void start_save_tx();
         int64_t commit_save_tx();
         /**@}*/
 
+        const save_tx_stats &get_last_save_stats() const {
+            return last_save_stats;
+        }
+
         /*
          * Targeted/domain-specific file operations. Different save formats may choose to
          * lay out files differently, so centralize file placement logic here rather than
          * scattering it throughout the codebase.
          */
-        bool read_map_quad( const tripoint &om_addr, file_read_json_fn reader ) const;
-        bool write_map_quad( const tripoint &om_addr, file_write_fn writer ) const;
+        /** @p reader also gets the path of the quad, to name it in load errors. */
+        bool read_map_quad( const tripoint &om_addr,
+                            const std::function<void( std::istream &, const std::string & )> &reader ) const;
+        /**
+         * @p on_committed runs once the quad is stored for good: right away outside of a
+         * save transaction, otherwise after a successful @ref commit_save_tx. It never
+         * runs for writes that fail or get rolled back.
+         */
+        bool write_map_quad( const tripoint &om_addr, file_write_fn writer,
+                             const std::function<void()> &on_committed = nullptr ) const;
+        /**
+         * Start reading the given quads on a background thread, so a later
+         * @ref read_map_quad finds them ready. Replaces any earlier requests
+         * that haven't been started yet.
+         */
+        void prefetch_map_quads( const std::vector<tripoint> &om_addrs );
+        /**
+         * Whether the quad at @p om_addr is known to have never been saved, without reading it.
+         * May return false for missing quads the database hasn't been asked about by a prefetch.
+         */
+        bool is_map_quad_missing( const tripoint &om_addr ) const;
+        const map_prefetch_stats &get_map_prefetch_stats() const {
+            return prefetch_stats;
+        }
+        /** Number of quads whose uncommitted writes are remembered for telling stale prefetches apart. */
+        size_t get_tracked_map_quad_writes() const {
+            return map_quad_write_epochs.size();
+        }
 
         bool overmap_exists( const point_abs_om &p ) const;
         bool read_overmap( const point_abs_om &p, file_read_fn reader ) const;
@@ -168,12 +234,56 @@ class world
     private:
         /** If non-zero, indicates we're in the middle of a save event */
         int64_t save_tx_start_ts = 0;
+        /** Abandon the current save transaction, e.g. when the background writer failed. */
+        void rollback_save_tx();
 
         std::string overmap_terrain_filename( const point_abs_om &p ) const;
         std::string overmap_player_filename( const point_abs_om &p ) const;
         std::string get_player_path() const;
 
         sqlite3 *map_db = nullptr;
+        /** Codec for new writes to @ref map_db; a trained dictionary codec once available. */
+        const compression_codec *map_codec = nullptr;
+        /** Background writer for @ref map_db, only present during an async save transaction. */
+        std::unique_ptr<db_write_queue> map_db_queue;
+        /** Must be called before the main thread touches @ref map_db. */
+        void drain_map_db_queue() const;
+        void write_map_db( const std::string &path, file_write_fn writer ) const;
+        /** Mark all map quad writes so far as committed, their epochs aren't needed anymore. */
+        void commit_map_write_epochs() const;
+
+        /** Dictionary trained in the background from map quads sampled after a commit. */
+        std::future<std::string> map_dictionary_training;
+        /** Map quads in @ref map_db, counting overwrites too. Training waits for enough of them. */
+        mutable int map_quads_written = 0;
+        int map_quads_for_training = 0;
+        /** Sample map quads and train a dictionary from them, if the world grew enough since the last try. */
+        void start_map_dictionary_training();
+        /** Switch map writes to the trained dictionary, once the training has finished. */
+        void adopt_map_dictionary();
+
+        /** Background quad reader, started by the first @ref prefetch_map_quads. */
+        std::unique_ptr<map_prefetcher> map_prefetch;
+        mutable map_prefetch_stats prefetch_stats;
+        /**
+         * Every map quad write gets a new epoch. Prefetched data is only used if its
+         * quad wasn't written after the last commit preceding the request.
+         * Writes drop prefetched copies of their quad, so only the epochs of
+         * uncommitted writes are kept.
+         */
+        /**@{*/
+        mutable uint64_t map_write_epoch = 0;
+        mutable uint64_t map_committed_epoch = 0;
+        mutable std::map<std::string, uint64_t> map_quad_write_epochs;
+        /**@}*/
+        /**
+         * V1 answers of @ref is_map_quad_missing by quad path, so asking again costs no file
+         * lookups. Quad files only appear through @ref write_map_quad, which updates it.
+         */
+        mutable std::map<std::string, bool> map_quad_missing_cache;
+        /** Callbacks of map quad writes waiting for the current save transaction to commit. */
+        mutable std::vector<std::function<void()>> map_commit_callbacks;
+        save_tx_stats last_save_stats;
 
         sqlite3 *save_db = nullptr;
         std::string last_save_id = "";
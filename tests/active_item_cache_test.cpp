@@ -1,15 +1,29 @@
 #include "catch/catch.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <set>
+#include <vector>
 
+#include "active_item_cache.h"
+#include "avatar.h"
 #include "calendar.h"
 #include "game.h"
 #include "game_constants.h"
 #include "item.h"
 #include "map.h"
+#include "map_selector.h"
+#include "mapbuffer.h"
 #include "point.h"
 #include "state_helpers.h"
+#include "submap.h"
+#include "type_id.h"
+#include "units.h"
+#include "units_temperature.h"
+#include "vehicle.h"
+#include "vehicle_part.h"
+#include "visitable.h"
+#include "weather.h"
 
 TEST_CASE( "place_active_item_at_various_coordinates", "[item]" )
 {
@@ -50,3 +64,121 @@ TEST_CASE( "place_active_item_at_various_coordinates", "[item]" )
         }
     }
 }
+
+static bool processed_this_turn( active_item_cache &cache, const item &it )
+{
+    const std::vector<item *> items = cache.get_for_processing();
+    return std::ranges::find( items, &it ) != items.end();
+}
+
+TEST_CASE( "perishables on the ground sleep until their rot state changes", "[item][rot]" )
+{
+    clear_all_state();
+    calendar::turn = calendar::start_of_cataclysm + 1_hours;
+    get_weather().temperature = 20_c;
+    get_weather().clear_temp_cache();
+    map &here = get_map();
+    const tripoint spot = get_avatar().pos() + point_east;
+
+    detached_ptr<item> food = item::spawn( "apple" );
+    food->set_relative_rot( 0.5 );
+    item &apple = *food;
+    here.add_item( spot, std::move( food ) );
+    REQUIRE( apple.only_rots() );
+    const time_duration asleep = apple.time_until_rot_state_change();
+    REQUIRE( asleep > 1_hours );
+
+    const tripoint abs_sub = here.get_abs_sub() + tripoint( spot.x / SEEX, spot.y / SEEY, spot.z );
+    active_item_cache &cache = MAPBUFFER.lookup_submap( abs_sub )->active_items;
+    here.process_items();
+    CHECK_FALSE( cache.empty() );
+    CHECK_FALSE( processed_this_turn( cache, apple ) );
+
+    SECTION( "woken once the state may change" ) {
+        calendar::turn += asleep;
+        CHECK( processed_this_turn( cache, apple ) );
+    }
+
+    SECTION( "rot caught up on when removed" ) {
+        const time_duration rot_before = apple.get_rot();
+        calendar::turn += 30_minutes;
+        detached_ptr<item> removed = here.i_rem( spot, &apple );
+        REQUIRE( removed );
+        CHECK( removed->get_rot() > rot_before );
+        CHECK( cache.empty() );
+    }
+
+    SECTION( "left asleep when only looked at by a removal" ) {
+        map_cursor( spot ).remove_items_with( []( detached_ptr<item> && ) {
+            return VisitResponse::NEXT;
+        } );
+        CHECK_FALSE( processed_this_turn( cache, apple ) );
+    }
+
+    SECTION( "rot until the temperature changes is at the old temperature" ) {
+        detached_ptr<item> reference = item::spawn( apple );
+        detached_ptr<item> chilled = item::spawn( apple );
+        calendar::turn += 30_minutes;
+        here.furn_set( spot, furn_str_id( "f_glass_fridge_on" ) );
+        CHECK( processed_this_turn( cache, apple ) );
+        reference->accumulate_rot( spot, temperature_flag::TEMP_NORMAL, get_weather(), false );
+        chilled->accumulate_rot( spot, temperature_flag::TEMP_FRIDGE, get_weather(), false );
+        CHECK( apple.get_rot() == reference->get_rot() );
+        CHECK( apple.get_rot() > chilled->get_rot() );
+    }
+
+    SECTION( "woken when added again" ) {
+        cache.add( apple );
+        CHECK( processed_this_turn( cache, apple ) );
+        CHECK_FALSE( cache.wake( apple ) );
+    }
+}
+
+TEST_CASE( "perishables in vehicle cargo sleep until their temperature changes",
+           "[item][rot][vehicle]" )
+{
+    clear_all_state();
+    calendar::turn = calendar::start_of_cataclysm + 1_hours;
+    get_weather().temperature = 20_c;
+    get_weather().clear_temp_cache();
+    map &here = get_map();
+    const tripoint spot = get_avatar().pos() + point( 2, 0 );
+
+    vehicle *veh = here.add_vehicle( vproto_id( "none" ), spot, 0_degrees, 0, 0 );
+    REQUIRE( veh != nullptr );
+    veh->install_part( point_zero, vpart_id( "frame_vertical" ) );
+    const int fridge = veh->install_part( point_zero, vpart_id( "minifridge" ) );
+    REQUIRE( fridge >= 0 );
+    here.add_vehicle_to_cache( veh );
+    veh->part( fridge ).enabled = false;
+
+    detached_ptr<item> food = item::spawn( "apple" );
+    food->set_relative_rot( 0.5 );
+    item &apple = *food;
+    REQUIRE_FALSE( veh->add_item( fridge, std::move( food ) ) );
+    REQUIRE( apple.only_rots() );
+    here.process_items();
+    CHECK_FALSE( veh->active_items.empty() );
+    CHECK_FALSE( processed_this_turn( veh->active_items, apple ) );
+
+    detached_ptr<item> reference = item::spawn( apple );
+    detached_ptr<item> chilled = item::spawn( apple );
+    calendar::turn += 30_minutes;
+    const tripoint pos = veh->global_part_pos3( fridge );
+    reference->accumulate_rot( pos, temperature_flag::TEMP_NORMAL, get_weather(), false );
+    chilled->accumulate_rot( pos, temperature_flag::TEMP_FRIDGE, get_weather(), false );
+
+    SECTION( "switching the fridge on wakes them at the old temperature" ) {
+        veh->part( fridge ).enabled = true;
+        here.process_items();
+        CHECK( apple.get_rot() == reference->get_rot() );
+        CHECK( apple.get_rot() > chilled->get_rot() );
+    }
+
+    SECTION( "rot caught up on when taken out" ) {
+        detached_ptr<item> removed = veh->remove_item( fridge, &apple );
+        REQUIRE( removed );
+        CHECK( removed->get_rot() == reference->get_rot() );
+        CHECK( veh->active_items.empty() );
+    }
+}
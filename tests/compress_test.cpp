@@ -0,0 +1,201 @@
+#include "catch/catch.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "avatar.h"
+#include "calendar.h"
+#include "cata_utility.h"
+#include "coordinate_conversions.h"
+#include "compress.h"
+#include "game.h"
+#include "item.h"
+#include "json.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapbuffer.h"
+#include "mapdata.h"
+#include "state_helpers.h"
+#include "submap.h"
+
+// Fill the reality bubble with some variety, then serialize groups of four
+// submaps the same way mapbuffer writes quads.
+static std::vector<std::string> make_quad_blobs()
+{
+    clear_map();
+    map &here = get_map();
+    const std::vector<ter_id> terrain = { t_grass, t_dirt, t_floor, t_wall, t_pavement };
+    const std::vector<furn_id> furniture = { f_null, f_null, f_null, f_chair, f_table };
+    const int mapsize = here.getmapsize() * SEEX;
+    for( int x = 0; x < mapsize; ++x ) {
+        for( int y = 0; y < mapsize; ++y ) {
+            const tripoint p( x, y, 0 );
+            const int region = ( x / 5 ) * 7 + ( y / 3 );
+            here.ter_set( p, terrain[region % terrain.size()] );
+            here.furn_set( p, furniture[( region + x ) % furniture.size()] );
+            if( ( x * 31 + y * 17 ) % 23 == 0 ) {
+                here.add_item( p, item::spawn( "rock", calendar::turn ) );
+            }
+        }
+    }
+
+    std::vector<std::string> blobs;
+    std::ostringstream out;
+    int in_quad = 0;
+    std::unique_ptr<JsonOut> jsout;
+    for( auto &elem : MAPBUFFER ) {
+        if( elem.first.z != 0 || elem.second == nullptr ) {
+            continue;
+        }
+        if( in_quad == 0 ) {
+            out.str( std::string() );
+            jsout = std::make_unique<JsonOut>( out );
+            jsout->start_array();
+        }
+        jsout->start_object();
+        jsout->member( "version", savegame_version );
+        jsout->member( "coordinates", elem.first );
+        elem.second->store( *jsout );
+        jsout->end_object();
+        if( ++in_quad == 4 ) {
+            jsout->end_array();
+            blobs.push_back( out.str() );
+            in_quad = 0;
+        }
+    }
+    return blobs;
+}
+
+static void check_roundtrip( const compression_codec &codec, const std::string &input )
+{
+    std::vector<std::byte> compressed;
+    codec.compress( input, compressed );
+    std::string output;
+    codec.decompress( compressed.data(), compressed.size(), output );
+    CHECK( output == input );
+}
+
+TEST_CASE( "compression_codec_roundtrip", "[compress]" )
+{
+    const std::string text = R"([{"version":33,"terrain":["t_grass","t_dirt",["t_floor",12]]}])";
+    const std::string dictionary = compression::train_dictionary( { text, text }, 1024 );
+    REQUIRE_FALSE( dictionary.empty() );
+
+    const compression_codec &dict_codec = compression::register_dictionary( dictionary );
+    CHECK( compression::is_dictionary_codec( dict_codec.name() ) );
+    CHECK( compression::find_codec( dict_codec.name() ) == &dict_codec );
+    CHECK( compression::find_codec( "no_such_codec" ) == nullptr );
+
+    for( const compression_codec *codec : {
+             &compression::default_codec(), &dict_codec
+         } ) {
+        CAPTURE( codec->name() );
+        check_roundtrip( *codec, text );
+        check_roundtrip( *codec, std::string() );
+        // Larger than the initial output buffer guess of the decompressors
+        check_roundtrip( *codec, std::string( 100000, 'a' ) );
+    }
+}
+
+static void benchmark_codecs( const std::vector<std::string> &blobs )
+{
+    REQUIRE( blobs.size() > 4 );
+
+    // Train on half, measure on the other half, like a dictionary trained early in a world
+    std::vector<std::string> training;
+    std::vector<std::string> samples;
+    for( size_t i = 0; i < blobs.size(); ++i ) {
+        ( i % 2 == 0 ? training : samples ).push_back( blobs[i] );
+    }
+    const compression_codec &dict_codec = compression::register_dictionary(
+            compression::train_dictionary( training, 32 * 1024 ) );
+
+    for( const compression_codec *codec : {
+             &compression::default_codec(), &dict_codec
+         } ) {
+        size_t raw_size = 0;
+        size_t compressed_size = 0;
+        std::vector<std::vector<std::byte>> compressed( samples.size() );
+        const auto start = std::chrono::steady_clock::now();
+        for( size_t i = 0; i < samples.size(); ++i ) {
+            codec->compress( samples[i], compressed[i] );
+            raw_size += samples[i].size();
+            compressed_size += compressed[i].size();
+        }
+        const auto mid = std::chrono::steady_clock::now();
+        std::string out;
+        for( const std::vector<std::byte> &c : compressed ) {
+            codec->decompress( c.data(), c.size(), out );
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        const double compress_s = std::chrono::duration<double>( mid - start ).count();
+        const double decompress_s = std::chrono::duration<double>( end - mid ).count();
+        const double raw_mb = raw_size / ( 1024.0 * 1024.0 );
+        WARN( codec->name() << ": " << samples.size() << " quads, ratio " <<
+              static_cast<double>( raw_size ) / compressed_size << ", compress " <<
+              raw_mb / compress_s << " MiB/s, decompress " << raw_mb / decompress_s << " MiB/s" );
+
+        BENCHMARK( "compress " + codec->name() + " " + std::to_string( blobs.size() ) ) {
+            std::vector<std::byte> c;
+            codec->compress( samples.front(), c );
+            return c.size();
+        };
+        BENCHMARK( "decompress " + codec->name() + " " + std::to_string( blobs.size() ) ) {
+            codec->decompress( compressed.front().data(), compressed.front().size(), out );
+            return out.size();
+        };
+    }
+}
+
+// Generate overmap terrains away from the reality bubble with the real mapgen,
+// and serialize each one the way mapbuffer writes its quad.
+static std::vector<std::string> make_mapgen_quad_blobs()
+{
+    clear_all_state();
+    // Tests use a placeholder mapgen unless told otherwise.
+    restore_on_out_of_scope<bool> restore_disable_mapgen( disable_mapgen );
+    disable_mapgen = false;
+
+    const tripoint origin = get_avatar().global_omt_location().raw() + tripoint( 40, 0, 0 );
+    std::vector<std::string> blobs;
+    for( int omt_x = 0; omt_x < 8; ++omt_x ) {
+        for( int omt_y = 0; omt_y < 8; ++omt_y ) {
+            const tripoint omt = origin + point( omt_x, omt_y );
+            map::generate_omt( tripoint_abs_omt( omt ) );
+
+            std::ostringstream out;
+            JsonOut jsout( out );
+            jsout.start_array();
+            for( const point &offset : {
+                     point_zero, point_south, point_east, point_south_east
+                 } ) {
+                const tripoint sm_addr = omt_to_sm_copy( omt ) + offset;
+                submap *sm = MAPBUFFER.lookup_submap( sm_addr );
+                REQUIRE( sm != nullptr );
+                jsout.start_object();
+                jsout.member( "version", savegame_version );
+                jsout.member( "coordinates", sm_addr );
+                sm->store( jsout );
+                jsout.end_object();
+            }
+            jsout.end_array();
+            blobs.push_back( out.str() );
+        }
+    }
+    return blobs;
+}
+
+TEST_CASE( "compression_codec_benchmark", "[.][compress][benchmark]" )
+{
+    SECTION( "synthetic terrain" ) {
+        benchmark_codecs( make_quad_blobs() );
+    }
+    SECTION( "map generated by the real mapgen" ) {
+        benchmark_codecs( make_mapgen_quad_blobs() );
+    }
+}
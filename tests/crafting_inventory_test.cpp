@@ -0,0 +1,145 @@
+#include "catch/catch.hpp"
+
+#include <map>
+#include <vector>
+
+#include "avatar.h"
+#include "calendar.h"
+#include "game.h"
+#include "inventory.h"
+#include "item.h"
+#include "item_summary.h"
+#include "map.h"
+#include "map_iterator.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+static const quality_id qual_BOIL( "BOIL" );
+static const quality_id qual_HAMMER( "HAMMER" );
+
+using quality_counts = std::map<quality_id, std::map<int, int>>;
+
+// What update_quality_cache computed before map piles were summarized.
+static quality_counts visited_qualities( const inventory &inv )
+{
+    quality_counts ret;
+    inv.visit_items( [&ret]( const item * e ) {
+        for( const std::pair<const quality_id, int> &quality : e->get_qualities() ) {
+            ret[quality.first][quality.second] += e->count_by_charges() ? e->charges : 1;
+        }
+        return VisitResponse::NEXT;
+    } );
+    return ret;
+}
+
+static item *find_on_map( map &here, const tripoint &p, const itype_id &type )
+{
+    for( item *it : here.i_at( p ) ) {
+        if( it->typeId() == type ) {
+            return it;
+        }
+    }
+    return nullptr;
+}
+
+static inventory qualities_around( const tripoint &p )
+{
+    inventory inv;
+    inv.form_from_map( p, 1, &get_avatar() );
+    inv.update_quality_cache();
+    return inv;
+}
+
+TEST_CASE( "map inventory qualities follow changes to the piles", "[crafting][inventory]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    const tripoint origin = get_avatar().pos();
+    const tripoint spot = origin + point_east;
+    here.add_item( spot, item::spawn( "pot" ) );
+    here.add_item( spot, item::spawn( "hammer" ) );
+    here.add_item( origin + point_west, item::spawn( "hammer" ) );
+
+    inventory inv = qualities_around( origin );
+    CHECK( inv.get_quality_cache() == visited_qualities( inv ) );
+    CHECK( inv.has_quality( qual_BOIL ) );
+    CHECK( inv.has_quality( qual_HAMMER, 1, 2 ) );
+
+    SECTION( "removing an item" ) {
+        here.i_rem( spot, find_on_map( here, spot, itype_id( "hammer" ) ) );
+        inv = qualities_around( origin );
+        CHECK( inv.get_quality_cache() == visited_qualities( inv ) );
+        CHECK_FALSE( inv.has_quality( qual_HAMMER, 1, 2 ) );
+    }
+
+    SECTION( "filling a container on the ground" ) {
+        item *pot = find_on_map( here, spot, itype_id( "pot" ) );
+        REQUIRE( pot != nullptr );
+        pot->put_in( item::spawn( "water", calendar::start_of_cataclysm, 2 ) );
+        inv = qualities_around( origin );
+        CHECK( inv.get_quality_cache() == visited_qualities( inv ) );
+        CHECK_FALSE( inv.has_quality( qual_BOIL ) );
+    }
+
+    SECTION( "converting an item in place" ) {
+        find_on_map( here, spot, itype_id( "pot" ) )->convert( itype_id( "rock" ) );
+        inv = qualities_around( origin );
+        CHECK( inv.get_quality_cache() == visited_qualities( inv ) );
+        CHECK_FALSE( inv.has_quality( qual_BOIL ) );
+    }
+}
+
+static item_summary fresh_summary( map &here, const tripoint &p )
+{
+    std::vector<item *> items;
+    for( item *it : here.i_at( p ) ) {
+        items.push_back( it );
+    }
+    return item_summary::summarize( items );
+}
+
+TEST_CASE( "pile summaries count items in and out", "[crafting][inventory]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    const tripoint spot = get_avatar().pos() + point_east;
+    here.add_item( spot, item::spawn( "pot" ) );
+    here.add_item( spot, item::spawn( "hammer" ) );
+    // Builds the summary, later changes are counted into it
+    REQUIRE( here.items_summary( spot ).qualities == fresh_summary( here, spot ).qualities );
+
+    here.add_item( spot, item::spawn( "hammer" ) );
+    CHECK( here.items_summary( spot ).qualities == fresh_summary( here, spot ).qualities );
+    CHECK( here.items_summary( spot ).qualities.at( qual_HAMMER ).at( 3 ) == 2 );
+
+    here.i_rem( spot, find_on_map( here, spot, itype_id( "pot" ) ) );
+    CHECK( here.items_summary( spot ).qualities == fresh_summary( here, spot ).qualities );
+    CHECK_FALSE( here.items_summary( spot ).qualities.contains( qual_BOIL ) );
+}
+
+TEST_CASE( "map inventory qualities benchmark", "[.][crafting][inventory][benchmark]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    const tripoint origin = get_avatar().pos();
+    constexpr int range = 6;
+    for( const tripoint &p : here.points_in_radius( origin, range ) ) {
+        for( int i = 0; i < 10; i++ ) {
+            here.add_item( p, item::spawn( "hammer" ) );
+            here.add_item( p, item::spawn( "pot" ) );
+            here.add_item( p, item::spawn( "rock" ) );
+        }
+    }
+
+    inventory inv;
+    BENCHMARK( "summed pile qualities" ) {
+        inv.form_from_map( origin, range, &get_avatar() );
+        inv.update_quality_cache();
+        return inv.get_quality_cache().size();
+    };
+    BENCHMARK( "visited item qualities, as before summaries" ) {
+        inv.form_from_map( origin, range, &get_avatar() );
+        return visited_qualities( inv ).size();
+    };
+}
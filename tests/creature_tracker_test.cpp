@@ -0,0 +1,100 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include "creature_tracker.h"
+#include "cuboid_rectangle.h"
+#include "game.h"
+#include "json.h"
+#include "line.h"
+#include "map_helpers.h"
+#include "monster.h"
+#include "point.h"
+#include "state_helpers.h"
+
+static std::vector<const monster *> sorted( const std::vector<shared_ptr_fast<monster>> &found )
+{
+    std::vector<const monster *> ret;
+    for( const shared_ptr_fast<monster> &critter : found ) {
+        ret.push_back( critter.get() );
+    }
+    std::ranges::sort( ret );
+    return ret;
+}
+
+// What scanning every monster finds.
+template<typename Pred>
+static std::vector<const monster *> scanned( Pred &&pred )
+{
+    std::vector<const monster *> ret;
+    for( const monster &critter : g->all_monsters() ) {
+        if( pred( critter.pos() ) ) {
+            ret.push_back( &critter );
+        }
+    }
+    std::ranges::sort( ret );
+    return ret;
+}
+
+static void check_queries_match_scan()
+{
+    const Creature_tracker &tracker = *g->critter_tracker;
+    for( const tripoint &center : {
+             tripoint( 10, 10, 0 ), tripoint( 40, 25, 0 ), tripoint( 0, 0, 0 ), tripoint( 100, 100, 0 )
+         } ) {
+        for( const int radius : { 0, 1, 5, 13, 30, 200 } ) {
+            CAPTURE( center, radius );
+            CHECK( sorted( tracker.find_in_radius( center, radius ) ) ==
+            scanned( [&]( const tripoint & p ) {
+                return rl_dist( center, p ) <= radius;
+            } ) );
+        }
+    }
+    const inclusive_cuboid<tripoint> area( tripoint( 9, 5, 0 ), tripoint( 36, 12, 0 ) );
+    CHECK( sorted( tracker.find_in_area( area ) ) == scanned( [&]( const tripoint & p ) {
+        return area.contains( p );
+    } ) );
+}
+
+TEST_CASE( "creature tracker range queries match scanning all monsters", "[monster]" )
+{
+    clear_all_state();
+    std::vector<monster *> spawned;
+    for( const tripoint &p : {
+             tripoint( 10, 10, 0 ), tripoint( 11, 11, 0 ), tripoint( 23, 11, 0 ), tripoint( 24, 12, 0 ),
+             tripoint( 35, 5, 0 ), tripoint( 60, 60, 0 ), tripoint( 2, 70, 0 )
+         } ) {
+        spawned.push_back( &spawn_test_monster( "mon_zombie", p ) );
+    }
+    check_queries_match_scan();
+
+    SECTION( "after monsters move across submaps" ) {
+        spawned[0]->setpos( tripoint( 37, 12, 0 ) );
+        spawned[5]->setpos( tripoint( 12, 12, 0 ) );
+        check_queries_match_scan();
+    }
+
+    SECTION( "after monsters swap places" ) {
+        g->swap_critters( *spawned[1], *spawned[6] );
+        check_queries_match_scan();
+    }
+
+    SECTION( "after a monster dies" ) {
+        spawned[2]->die( nullptr );
+        g->cleanup_dead();
+        check_queries_match_scan();
+    }
+
+    SECTION( "after the tracker is loaded over itself" ) {
+        Creature_tracker &tracker = *g->critter_tracker;
+        std::ostringstream os;
+        JsonOut jsout( os );
+        tracker.serialize( jsout );
+        std::istringstream is( os.str() );
+        JsonIn jsin( is );
+        tracker.deserialize( jsin );
+        check_queries_match_scan();
+    }
+}
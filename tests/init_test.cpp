@@ -0,0 +1,42 @@
+#include "catch/catch.hpp"
+
+#include <string>
+
+#include "filesystem.h"
+#include "game.h"
+#include "init.h"
+#include "world.h"
+
+TEST_CASE( "data check stamps are kept per mod set", "[init]" )
+{
+    const std::string path = g->get_active_world()->info->folder_path() +
+                             "/data_check_stamps_test.txt";
+    remove_file( path );
+    const size_t base_game = 1;
+    const size_t with_mods = 2;
+    {
+        data_check_stamps stamps( path );
+        CHECK_FALSE( stamps.passed( base_game, "0.F 123" ) );
+        REQUIRE( stamps.mark_passed( base_game, "0.F 123" ) );
+        REQUIRE( stamps.mark_passed( with_mods, "0.F 456" ) );
+    }
+
+    data_check_stamps stamps( path );
+    SECTION( "hit for each mod set that passed" ) {
+        CHECK( stamps.passed( base_game, "0.F 123" ) );
+        CHECK( stamps.passed( with_mods, "0.F 456" ) );
+    }
+    SECTION( "miss for changed data or another mod set" ) {
+        CHECK_FALSE( stamps.passed( base_game, "0.F 124" ) );
+        CHECK_FALSE( stamps.passed( base_game, "0.G 123" ) );
+        CHECK_FALSE( stamps.passed( 3, "0.F 123" ) );
+    }
+    SECTION( "changed data replaces the stamp of its own mod set" ) {
+        REQUIRE( stamps.mark_passed( base_game, "0.F 124" ) );
+        const data_check_stamps reread( path );
+        CHECK_FALSE( reread.passed( base_game, "0.F 123" ) );
+        CHECK( reread.passed( base_game, "0.F 124" ) );
+        CHECK( reread.passed( with_mods, "0.F 456" ) );
+    }
+    remove_file( path );
+}
@@ -7,6 +7,7 @@
 #include "json.h"
 #include "cached_options.h"
 #include "cata_utility.h"
+#include "memory_stream.h"
 #include "string_formatter.h"
 #include "type_id.h"
 
@@ -246,21 +247,40 @@ TEST_CASE( "translation_text_style_check_error_recovery", "[json][translation]"
     }
 }
 
+// Runs @p test on a JsonIn over a std::istringstream and over a memory_istream,
+// which JsonIn reads directly.
+template<typename Test>
+static void with_each_stream( const std::string &json, Test &&test )
+{
+    {
+        INFO( "std::istringstream" );
+        std::istringstream iss( json );
+        JsonIn jsin( iss );
+        test( jsin );
+    }
+    {
+        INFO( "memory_istream" );
+        memory_istream mis( json );
+        JsonIn jsin( mis );
+        test( jsin );
+    }
+}
+
 static void test_get_string( const std::string &str, const std::string &json )
 {
     CAPTURE( json );
-    std::istringstream iss( json );
-    JsonIn jsin( iss );
-    CHECK( jsin.get_string() == str );
+    with_each_stream( json, [&str]( JsonIn & jsin ) {
+        CHECK( jsin.get_string() == str );
+    } );
 }
 
 template<typename Matcher>
 static void test_get_string_throws_matches( Matcher &&matcher, const std::string &json )
 {
     CAPTURE( json );
-    std::istringstream iss( json );
-    JsonIn jsin( iss );
-    CHECK_THROWS_MATCHES( jsin.get_string(), JsonError, matcher );
+    with_each_stream( json, [&matcher]( JsonIn & jsin ) {
+        CHECK_THROWS_MATCHES( jsin.get_string(), JsonError, matcher );
+    } );
 }
 
 template<typename Matcher>
@@ -269,9 +289,9 @@ static void test_string_error_throws_matches( Matcher &&matcher, const std::stri
 {
     CAPTURE( json );
     CAPTURE( offset );
-    std::istringstream iss( json );
-    JsonIn jsin( iss );
-    CHECK_THROWS_MATCHES( jsin.string_error( "<message>", offset ), JsonError, matcher );
+    with_each_stream( json, [&matcher, offset]( JsonIn & jsin ) {
+        CHECK_THROWS_MATCHES( jsin.string_error( "<message>", offset ), JsonError, matcher );
+    } );
 }
 
 TEST_CASE( "jsonin_get_string", "[json]" )
@@ -462,6 +482,48 @@ TEST_CASE( "jsonin_get_string", "[json]" )
         R"("foo\nbar")", 5 );
 }
 
+TEST_CASE( "jsonin_memory_stream_matches_istringstream", "[json]" )
+{
+    const std::string json =
+        "[\n"
+        "  { \"id\": \"a long enough identifier\", \"n\": -12.5e3, \"list\": [ 1, 2, 3 ] },\n"
+        "\t{ \"name\": \"caf\u00e9 \\\"quoted\\\" \\u2026\", \"flag\": true, \"none\": null },\n"
+        "        { \"nested\": { \"deeper\": [ false, \"\", 0 ] } }\n"
+        "]\n";
+    // Positions of every value and what was read, to compare both streams.
+    const auto walk = []( JsonIn & jsin ) {
+        std::vector<std::string> seen;
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            seen.push_back( std::to_string( jsin.tell() ) );
+            JsonObject jo = jsin.get_object();
+            jo.allow_omitted_members();
+            for( const JsonMember member : jo ) {
+                seen.push_back( member.name() );
+                if( member.test_string() ) {
+                    seen.push_back( member.get_string() );
+                }
+                seen.push_back( std::to_string( jsin.tell() ) );
+            }
+        }
+        return seen;
+    };
+    std::vector<std::string> from_stringstream;
+    std::vector<std::string> from_memory;
+    {
+        std::istringstream iss( json );
+        JsonIn jsin( iss );
+        from_stringstream = walk( jsin );
+    }
+    {
+        memory_istream mis( json );
+        JsonIn jsin( mis );
+        from_memory = walk( jsin );
+    }
+    CHECK( from_memory == from_stringstream );
+    CHECK( from_memory.size() > 10 );
+}
+
 TEST_CASE( "serialize_optional", "[json]" )
 {
     SECTION( "simple_empty_optional" ) {
@@ -0,0 +1,119 @@
+#include "catch/catch.hpp"
+
+#include <vector>
+
+#include "calendar.h"
+#include "game.h"
+#include "map.h"
+#include "options_helpers.h"
+#include "point.h"
+#include "shadowcasting.h"
+#include "state_helpers.h"
+#include "type_id.h"
+#include "units_angle.h"
+#include "weather.h"
+
+static std::vector<four_quadrants> lightmap_after_rebuild( map &here, int z )
+{
+    here.invalidate_map_cache( z );
+    here.build_map_cache( z );
+    const level_cache &cache = here.access_cache( z );
+    return std::vector<four_quadrants>( &cache.lm[0][0], &cache.lm[0][0] + MAPSIZE_X * MAPSIZE_Y );
+}
+
+static std::vector<four_quadrants> full_lightmap( map &here, int z )
+{
+    override_option incremental( "INCREMENTAL_LIGHTMAP", "false" );
+    return lightmap_after_rebuild( here, z );
+}
+
+static void check_same_light( const std::vector<four_quadrants> &incremental,
+                              const std::vector<four_quadrants> &full )
+{
+    REQUIRE( incremental.size() == full.size() );
+    int differing = 0;
+    for( size_t i = 0; i < full.size(); i++ ) {
+        if( incremental[i].values != full[i].values ) {
+            differing++;
+        }
+    }
+    CHECK( differing == 0 );
+}
+
+TEST_CASE( "incremental lightmap matches a full rebuild", "[lightmap][shadowcasting]" )
+{
+    clear_all_state();
+    override_option incremental( "INCREMENTAL_LIGHTMAP", "true" );
+    const ter_id t_utility_light( "t_utility_light" );
+    const ter_id t_brick_wall( "t_brick_wall" );
+    const ter_id t_floor( "t_floor" );
+
+    g->place_player( tripoint( 60, 60, 0 ) );
+    get_weather().weather_id = weather_type_id( "clear" );
+    calendar::turn = calendar::turn_zero;
+    g->reset_light_level();
+
+    map &here = get_map();
+    const int z = 0;
+    const tripoint lamp( 50, 50, z );
+    const tripoint other_lamp( 70, 55, z );
+    here.ter_set( lamp, t_utility_light );
+    here.ter_set( other_lamp, t_utility_light );
+    for( int y = 45; y <= 55; y++ ) {
+        here.ter_set( tripoint( 55, y, z ), t_brick_wall );
+    }
+
+    // First build casts everything, the second reuses all of it.
+    lightmap_after_rebuild( here, z );
+    check_same_light( lightmap_after_rebuild( here, z ), full_lightmap( here, z ) );
+
+    SECTION( "wall removed next to a light" ) {
+        here.ter_set( tripoint( 55, 50, z ), t_floor );
+        check_same_light( lightmap_after_rebuild( here, z ), full_lightmap( here, z ) );
+    }
+
+    SECTION( "wall built far from any light" ) {
+        here.ter_set( tripoint( 10, 120, z ), t_brick_wall );
+        check_same_light( lightmap_after_rebuild( here, z ), full_lightmap( here, z ) );
+    }
+
+    SECTION( "light moved" ) {
+        here.ter_set( lamp, t_floor );
+        here.ter_set( lamp + point_south_east, t_utility_light );
+        check_same_light( lightmap_after_rebuild( here, z ), full_lightmap( here, z ) );
+    }
+}
+
+TEST_CASE( "vehicle changes only recast the light around them", "[lightmap][shadowcasting]" )
+{
+    clear_all_state();
+    override_option incremental( "INCREMENTAL_LIGHTMAP", "true" );
+    // Consoles light less than two submaps around them
+    const ter_id t_console( "t_console" );
+
+    g->place_player( tripoint( 60, 60, 0 ) );
+    get_weather().weather_id = weather_type_id( "clear" );
+    calendar::turn = calendar::turn_zero;
+    g->reset_light_level();
+
+    map &here = get_map();
+    const int z = 0;
+    here.ter_set( tripoint( 20, 20, z ), t_console );
+    here.ter_set( tripoint( 100, 100, z ), t_console );
+
+    lightmap_after_rebuild( here, z );
+    lightmap_after_rebuild( here, z );
+    const light_source_cache *sources = here.get_light_source_cache( z );
+    REQUIRE( sources != nullptr );
+    CHECK( sources->cast_count == 0 );
+    const int all_sources = sources->reused_count;
+    REQUIRE( all_sources >= 2 );
+
+    // Turned diagonally, so it blocks light between diagonal neighbours too
+    REQUIRE( here.add_vehicle( vproto_id( "apc" ), tripoint( 100, 115, z ), -45_degrees, 0, 0 ) );
+    const std::vector<four_quadrants> incremental_light = lightmap_after_rebuild( here, z );
+    CHECK( sources->cast_count >= 1 );
+    CHECK( sources->reused_count >= 1 );
+    CHECK( sources->cast_count + sources->reused_count == all_sources );
+    check_same_light( incremental_light, full_lightmap( here, z ) );
+}
@@ -0,0 +1,43 @@
+#include "catch/catch.hpp"
+
+#include <optional>
+
+#include "line_of_sight_cache.h"
+#include "point.h"
+
+TEST_CASE( "line of sight cache stores pairs regardless of order", "[vision]" )
+{
+    line_of_sight_cache cache;
+    const tripoint a( 10, 20, 0 );
+    const tripoint b( 30, 5, 0 );
+    const tripoint c( 31, 5, 0 );
+    const tripoint below( 31, 5, -1 );
+
+    CHECK_FALSE( cache.get( a, b ).has_value() );
+    cache.set( a, b, true );
+    cache.set( c, a, false );
+    CHECK( cache.get( a, b ) == std::optional<bool>( true ) );
+    CHECK( cache.get( b, a ) == std::optional<bool>( true ) );
+    CHECK( cache.get( a, c ) == std::optional<bool>( false ) );
+    CHECK_FALSE( cache.get( a, below ).has_value() );
+
+    SECTION( "results can be overwritten" ) {
+        cache.set( b, a, false );
+        CHECK( cache.get( a, b ) == std::optional<bool>( false ) );
+    }
+
+    SECTION( "points outside the reality bubble are not cached" ) {
+        const tripoint outside( -1, 5, 0 );
+        cache.set( a, outside, true );
+        CHECK_FALSE( cache.get( a, outside ).has_value() );
+    }
+
+    SECTION( "clearing forgets everything" ) {
+        cache.clear();
+        CHECK_FALSE( cache.get( a, b ).has_value() );
+        CHECK_FALSE( cache.get( a, c ).has_value() );
+        cache.set( a, c, true );
+        CHECK( cache.get( a, c ) == std::optional<bool>( true ) );
+        CHECK_FALSE( cache.get( a, b ).has_value() );
+    }
+}
@@ -10,6 +10,7 @@
 #include "lru_cache.h"
 #include "map.h"
 #include "map_memory.h"
+#include "memory_fast.h"
 #include "point.h"
 #include "string_formatter.h"
 
@@ -42,7 +43,7 @@ TEST_CASE( "map_memory_defaults", "[map_memory]" )
     memory.prepare_region( p1, p2 );
     CHECK( memory.get_symbol( p1 ) == 0 );
     memorized_terrain_tile default_tile = memory.get_tile( p1 );
-    CHECK( default_tile.tile.empty() );
+    CHECK( default_tile.tile().empty() );
     CHECK( default_tile.subtile == 0 );
     CHECK( default_tile.rotation == 0 );
 }
@@ -75,7 +76,69 @@ TEST_CASE( "map_memory_forgets", "[map_memory]" )
     memory.memorize_symbol( p3, 1 );
 }
 
-// TODO: map memory save / load
+static std::string serialized( const mm_region &region )
+{
+    std::ostringstream os;
+    JsonOut jsout( os );
+    region.serialize( jsout );
+    return os.str();
+}
+
+TEST_CASE( "map_memory_region_roundtrip", "[map_memory]" )
+{
+    static_assert( sizeof( memorized_terrain_tile ) == 8, "memorized tiles should stay compact" );
+
+    mm_region region;
+    for( auto &column : region.submaps ) {
+        for( shared_ptr_fast<mm_submap> &sm : column ) {
+            sm = make_shared_fast<mm_submap>();
+        }
+    }
+    region.submaps[0][0]->set_tile( point( 1, 2 ), memorized_terrain_tile( "t_dirt", 1, 2 ) );
+    region.submaps[0][0]->set_tile( point( 3, 4 ), memorized_terrain_tile( "vp_frame", 0, 270 ) );
+    region.submaps[2][1]->set_tile( point( 0, 0 ), memorized_terrain_tile( "t_dirt", 0, 0 ) );
+    region.submaps[2][1]->set_symbol( point( 5, 5 ), 'x' );
+
+    const std::string json = serialized( region );
+    CAPTURE( json );
+    // Each tile id is written once per region
+    CHECK( json.find( "t_dirt" ) == json.rfind( "t_dirt" ) );
+
+    mm_region loaded;
+    std::istringstream is( json );
+    JsonIn jsin( is );
+    loaded.deserialize( jsin );
+    CHECK( serialized( loaded ) == json );
+    CHECK( loaded.submaps[0][0]->tile( point( 1, 2 ) ) == memorized_terrain_tile( "t_dirt", 1, 2 ) );
+    CHECK( loaded.submaps[0][0]->tile( point( 3, 4 ) ).tile() == "vp_frame" );
+    CHECK( loaded.submaps[0][0]->tile( point( 3, 4 ) ).rotation == 270 );
+    CHECK( loaded.submaps[0][0]->tile( point( 0, 0 ) ) == mm_submap::default_tile );
+    CHECK( loaded.submaps[2][1]->symbol( point( 5, 5 ) ) == 'x' );
+    CHECK( loaded.submaps[1][1]->is_empty() );
+}
+
+TEST_CASE( "map_memory_loads_regions_without_dictionary", "[map_memory]" )
+{
+    // Submaps wrote their tile ids inline before regions had a dictionary
+    std::string json = "[";
+    for( int i = 0; i < MM_REG_SIZE * MM_REG_SIZE; i++ ) {
+        json += i == 0 ? "" : ",";
+        json += i == 1 ? string_format( "[[\"f_chair\",0,3,0],[\"t_floor\",2,0,35,%d]]",
+                                        SEEX * SEEY - 1 ) : "null";
+    }
+    json += "]";
+
+    mm_region region;
+    std::istringstream is( json );
+    JsonIn jsin( is );
+    region.deserialize( jsin );
+    const mm_submap &sm = *region.submaps[1][0];
+    CHECK( sm.tile( point_zero ) == memorized_terrain_tile( "f_chair", 0, 3 ) );
+    CHECK( sm.tile( point( SEEX - 1, SEEY - 1 ) ) == memorized_terrain_tile( "t_floor", 2, 0 ) );
+    CHECK( sm.symbol( point_zero ) == 0 );
+    CHECK( sm.symbol( point_east ) == 35 );
+    CHECK( region.submaps[0][0]->is_empty() );
+}
 
 #include <chrono>
 
@@ -4,13 +4,19 @@
 #include <vector>
 
 #include "avatar.h"
+#include "calendar.h"
+#include "coordinate_conversions.h"
 #include "enums.h"
 #include "game.h"
 #include "game_constants.h"
+#include "item.h"
 #include "map.h"
 #include "map_helpers.h"
+#include "mapbuffer.h"
 #include "point.h"
+#include "safe_reference.h"
 #include "state_helpers.h"
+#include "submap.h"
 #include "type_id.h"
 
 TEST_CASE( "destroy_grabbed_furniture" )
@@ -144,3 +150,73 @@ TEST_CASE( "bash_through_roof_can_destroy_multiple_times" )
         }
     }
 }
+
+TEST_CASE( "in_place_item_changes_mark_the_submap_for_saving", "[map][submap]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    const tripoint pos( 60, 60, 0 );
+    here.add_item( pos, item::spawn( itype_id( "rock" ) ) );
+    here.add_item( pos, item::spawn( itype_id( "bottle_plastic" ) ) );
+    safe_reference<item> rock;
+    safe_reference<item> bottle;
+    for( item *it : here.i_at( pos ) ) {
+        if( it->typeId() == itype_id( "rock" ) ) {
+            rock = safe_reference<item>( it );
+        } else {
+            bottle = safe_reference<item>( it );
+        }
+    }
+    REQUIRE( rock );
+    REQUIRE( bottle );
+
+    submap *sm = MAPBUFFER.lookup_submap( ms_to_sm_copy( here.getabs( pos ) ) );
+    sm->mark_saved();
+    REQUIRE_FALSE( sm->needs_save() );
+
+    SECTION( "setting a var through a held reference" ) {
+        rock->set_var( "test_progress", 42 );
+        CHECK( sm->needs_save() );
+    }
+
+    SECTION( "setting a flag through a held reference" ) {
+        rock->set_flag( flag_id( "FIELD_DRESS" ) );
+        CHECK( sm->needs_save() );
+    }
+
+    SECTION( "pouring liquid into a container on the ground" ) {
+        bottle->fill_with( item::spawn( itype_id( "water_clean" ), calendar::turn, 2 ) );
+        CHECK( sm->needs_save() );
+    }
+}
+
+TEST_CASE( "only_real_changes_mark_the_submap_for_saving", "[map][submap]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    const tripoint pos( 60, 60, 0 );
+    here.add_item( pos, item::spawn( itype_id( "rock" ) ) );
+
+    submap *sm = MAPBUFFER.lookup_submap( ms_to_sm_copy( here.getabs( pos ) ) );
+    sm->mark_saved();
+    REQUIRE_FALSE( sm->needs_save() );
+
+    SECTION( "looking at the items through a mutable stack" ) {
+        int count = 0;
+        for( item *it : here.i_at( pos ) ) {
+            count += it->typeId() == itype_id( "rock" ) ? 1 : 0;
+        }
+        CHECK( count == 1 );
+        CHECK_FALSE( sm->needs_save() );
+    }
+
+    SECTION( "adding to the stack" ) {
+        here.i_at( pos ).insert( item::spawn( itype_id( "rock" ) ) );
+        CHECK( sm->needs_save() );
+    }
+
+    SECTION( "adding a monster spawn" ) {
+        here.add_spawn( mtype_id( "mon_zombie" ), 1, pos );
+        CHECK( sm->needs_save() );
+    }
+}
@@ -1,6 +1,27 @@
 #include "catch/catch.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "calendar.h"
+#include "coordinates.h"
+#include "json.h"
+#include "json_source_location.h"
+#include "map.h"
+#include "mapdata.h"
 #include "mapgen.h"
+#include "mapgen_functions.h"
+#include "mapgendata.h"
+#include "omdata.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "trap.h"
 #include "type_id.h"
 
 TEST_CASE( "connects_to", "[mapgen][connects]" )
@@ -88,3 +109,101 @@ TEST_CASE( "connects_to", "[mapgen][connects]" )
         CHECK( connects_to( oter_id( "sewer_nesw" ), west ) );
     }
 }
+
+// Rows of an update mapgen with the given keys placed, and '.' everywhere else.
+static std::string update_rows( const std::vector<std::pair<point, char>> &keys )
+{
+    std::vector<std::string> rows( SEEY * 2, std::string( SEEX * 2, '.' ) );
+    for( const auto &[p, key] : keys ) {
+        rows[p.y][p.x] = key;
+    }
+    std::string ret;
+    for( const std::string &row : rows ) {
+        ret += ( ret.empty() ? "\"" : ", \"" ) + row + "\"";
+    }
+    return ret;
+}
+
+TEST_CASE( "mapgen_places_fixed_cells_like_other_pieces_at_an_offset", "[mapgen]" )
+{
+    clear_all_state();
+    // 'a' and 'b' are fixed, so they are placed as compiled cells.
+    // 'A' and 'B' come from parameters, so they are placed through their pieces.
+    const point fixed( 10, 12 );
+    const point through_piece( 10, 15 );
+    const std::string json = R"({
+        "parameters": {
+            "p_ter": { "type": "ter_str_id", "scope": "omt", "default": { "distribution": [ [ "t_floor", 1 ] ] } },
+            "p_furn": { "type": "furn_str_id", "scope": "omt", "default": { "distribution": [ [ "f_chair", 1 ] ] } }
+        },
+        "rows": [ )" + update_rows( {
+        { fixed, 'a' }, { fixed + point_east, 'b' },
+        { through_piece, 'A' }, { through_piece + point_east, 'B' }
+    } ) + R"( ],
+        "terrain": { "a": "t_floor", "b": "t_floor", "A": { "param": "p_ter" }, "B": { "param": "p_ter" } },
+        "furniture": { "b": "f_chair", "B": { "param": "p_furn" } }
+    })";
+    std::istringstream is( json );
+    JsonIn jsin( is );
+    JsonObject jo = jsin.get_object();
+    update_mapgen_function_json update( json_source_location{} );
+    REQUIRE( update.setup_update( jo ) );
+
+    const point offset( 5, -7 );
+    fake_map m( f_null, t_dirt, tr_null, 0 );
+    mapgendata base( tripoint_abs_omt( 0, 0, 0 ), m, 0.0f, calendar::turn, nullptr );
+    mapgendata dat( base, oter_id( "field" ) );
+    REQUIRE( update.update_map( dat, offset ) );
+
+    const auto check_placed = [&]( const point & p ) {
+        CAPTURE( p );
+        CHECK( m.ter( p + offset ) == t_floor );
+        CHECK( m.furn( p + offset ) == f_null );
+        CHECK( m.ter( p + point_east + offset ) == t_floor );
+        CHECK( m.furn( p + point_east + offset ) == f_chair );
+        // Nothing at the mirrored position
+        CHECK( m.ter( p - offset ) == t_dirt );
+        CHECK( m.furn( p + point_east - offset ) == f_null );
+    };
+    check_placed( through_piece );
+    check_placed( fixed );
+}
+
+TEST_CASE( "mapgen_benchmark", "[.][mapgen][benchmark]" )
+{
+    clear_all_state();
+    constexpr int iterations = 5;
+
+    // One terrain per mapgen id, rotations and line variants share theirs
+    std::map<std::string, oter_id> by_mapgen_id;
+    for( const oter_t &ter : overmap_terrains::get_all() ) {
+        const std::string mapgen_id = ter.get_mapgen_id();
+        if( !mapgen_id.empty() ) {
+            by_mapgen_id.emplace( mapgen_id, ter.id.id() );
+        }
+    }
+    REQUIRE( !by_mapgen_id.empty() );
+
+    std::vector<std::pair<double, std::string>> times;
+    double total_s = 0;
+    for( const auto &[mapgen_id, ter] : by_mapgen_id ) {
+        const auto start = std::chrono::steady_clock::now();
+        for( int i = 0; i < iterations; ++i ) {
+            fake_map m( f_null, t_dirt, tr_null, 0 );
+            mapgendata base( tripoint_abs_omt( 0, 0, 0 ), m, 0.0f, calendar::turn, nullptr );
+            mapgendata dat( base, ter );
+            run_mapgen_func( mapgen_id, dat );
+        }
+        const double s = std::chrono::duration<double>( std::chrono::steady_clock::now() -
+                         start ).count() / iterations;
+        times.emplace_back( s, mapgen_id );
+        total_s += s;
+    }
+
+    std::ranges::sort( times, std::greater<>() );
+    for( size_t i = 0; i < std::min<size_t>( times.size(), 20 ); ++i ) {
+        WARN( times[i].second << ": " << times[i].first * 1000.0 << " ms" );
+    }
+    WARN( times.size() << " mapgen ids, " << total_s * 1000.0 / times.size() <<
+          " ms average, " << total_s << " s per pass" );
+}
@@ -1,6 +1,8 @@
 #include "catch/catch.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #include "calendar.h"
 #include "game.h"
@@ -9,10 +11,10 @@
 #include "mapdata.h"
 #include "monster.h"
 #include "options_helpers.h"
+#include "player_helpers.h"
+#include "point.h"
 #include "state_helpers.h"
 
-struct tripoint;
-
 static monster &spawn_and_clear( const tripoint &pos, bool set_floor )
 {
     if( set_floor ) {
@@ -101,3 +103,47 @@ TEST_CASE( "monsters_dont_see_through_vehicle_holes", "[vision]" )
     CHECK( !outside.sees( inside ) );
 
 }
+
+TEST_CASE( "precomputed monster sight matches serial sight checks", "[vision]" )
+{
+    clear_all_state();
+    calendar::turn = midday;
+    put_player_underground();
+    map &here = get_map();
+
+    // Walls and a rotated vehicle in the way of some of the lines
+    for( int y = 30; y < 70; y++ ) {
+        here.ter_set( tripoint( 55, y, 0 ), t_wall );
+    }
+    for( int x = 35; x < 50; x++ ) {
+        here.ter_set( tripoint( x, 47, 0 ), t_wall );
+    }
+    here.add_vehicle( vproto_id( "apc" ), tripoint( 80, 50, 0 ), -45_degrees, 0, 0 );
+
+    for( int i = 0; i < 16; i++ ) {
+        spawn_test_monster( i % 4 == 0 ? "mon_dog" : "mon_zombie",
+                            tripoint( 38 + i % 4 * 9, 36 + i / 4 * 9, 0 ) );
+    }
+    spawn_npc( point( 92, 46 ), "test_talker" );
+    spawn_npc( point( 44, 60 ), "test_talker" );
+    here.build_map_cache( 0 );
+
+    g->precompute_monster_sight();
+
+    int pairs = 0;
+    std::vector<const Creature *> targets;
+    for( monster &critter : g->all_monsters() ) {
+        targets.clear();
+        critter.get_sight_targets( targets );
+        for( const Creature *target : targets ) {
+            const tripoint from = std::min( critter.pos(), target->pos() );
+            const tripoint to = std::max( critter.pos(), target->pos() );
+            CAPTURE( from, to );
+            REQUIRE( here.has_cached_sees( from, to ) );
+            // The worker's result, now in the cache, against the same check made on this thread
+            CHECK( here.sees( from, to, -1 ) == here.sees_uncached( from, to ) );
+            pairs++;
+        }
+    }
+    CHECK( pairs > 0 );
+}
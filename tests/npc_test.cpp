@@ -1,5 +1,6 @@
 #include "catch/catch.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <optional>
 #include <set>
@@ -18,6 +19,7 @@
 #include "map.h"
 #include "map_helpers.h"
 #include "memory_fast.h"
+#include "monster.h"
 #include "npc.h"
 #include "npc_class.h"
 #include "numeric_interval.h"
@@ -508,3 +510,29 @@ TEST_CASE( "random npc spawn chance" )
     CHECK( npc_overmap::spawn_chance_in_hour( 4 * days_in_year, 1.0 ) == Approx( 0.25 / 24.0 ) );
     CHECK( npc_overmap::spawn_chance_in_hour( 8 * days_in_year, 1.0 ) == Approx( 0.125 / 24.0 ) );
 }
+
+TEST_CASE( "npc_world_snapshot_is_shared_within_a_turn" )
+{
+    clear_all_state();
+    const monster &first = spawn_test_monster( "mon_zombie", tripoint( 10, 10, 0 ) );
+    const auto has = []( const npc_ai::world_snapshot & snap, const monster & critter ) {
+        return std::ranges::any_of( snap.monsters,
+        [&]( const npc_ai::world_snapshot::monster_threat & entry ) {
+            return entry.critter.get() == &critter;
+        } );
+    };
+
+    {
+        const npc_ai::world_snapshot_scope scope( npc_ai::world_snapshot::take() );
+        const monster &second = spawn_test_monster( "mon_zombie", tripoint( 12, 10, 0 ) );
+        const shared_ptr_fast<const npc_ai::world_snapshot> during = npc_ai::snapshot();
+        CHECK( during == npc_ai::snapshot() );
+        CHECK( has( *during, first ) );
+        // Taken before it spawned
+        CHECK_FALSE( has( *during, second ) );
+    }
+
+    const shared_ptr_fast<const npc_ai::world_snapshot> after = npc_ai::snapshot();
+    CHECK( after != npc_ai::snapshot() );
+    CHECK( after->monsters.size() == 2 );
+}
@@ -0,0 +1,144 @@
+#include "catch/catch.hpp"
+
+#include <vector>
+
+#include "game_constants.h"
+#include "line.h"
+#include "map.h"
+#include "mapdata.h"
+#include "options_helpers.h"
+#include "pathfinding.h"
+#include "point.h"
+#include "state_helpers.h"
+
+// Cluster (2, 2) spans tiles 24..35, walled in by a ring just outside of it
+static constexpr int ring_min = 2 * SEEX - 1;
+static constexpr int ring_max = 3 * SEEX;
+
+static void build_ring()
+{
+    map &here = get_map();
+    for( int i = ring_min; i <= ring_max; i++ ) {
+        here.ter_set( tripoint( i, ring_min, 0 ), t_wall );
+        here.ter_set( tripoint( i, ring_max, 0 ), t_wall );
+        here.ter_set( tripoint( ring_min, i, 0 ), t_wall );
+        here.ter_set( tripoint( ring_max, i, 0 ), t_wall );
+    }
+}
+
+static std::vector<tripoint> route_with( const bool hierarchical, const tripoint &from,
+        const tripoint &to )
+{
+    override_option opt( "HIERARCHICAL_PATHFINDING", hierarchical ? "true" : "false" );
+    // A d_map left over from the other search would be reused instead
+    Pathfinding::clear_d_maps();
+    return Pathfinding::route( from, to );
+}
+
+static void check_route( const std::vector<tripoint> &route, const tripoint &from,
+                         const tripoint &to )
+{
+    REQUIRE_FALSE( route.empty() );
+    CHECK( route.front() == from );
+    CHECK( route.back() == to );
+    const map &here = get_map();
+    for( size_t i = 1; i < route.size(); i++ ) {
+        CAPTURE( route[i] );
+        CHECK( square_dist( route[i - 1], route[i] ) == 1 );
+        CHECK( here.passable( route[i] ) );
+    }
+}
+
+TEST_CASE( "hierarchical routes match exact routes", "[pathfinding]" )
+{
+    clear_all_state();
+    Pathfinding::invalidate_level( 0 );
+    map &here = get_map();
+
+    const tripoint from( 30, 30, 0 );
+    const tripoint to( 70, 50, 0 );
+
+    SECTION( "across open ground" ) {
+    }
+    SECTION( "through a single gap in a wall" ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            if( y != 20 ) {
+                here.ter_set( tripoint( 50, y, 0 ), t_wall );
+            }
+        }
+    }
+    SECTION( "out of a ring open at its corner" ) {
+        build_ring();
+        here.ter_set( tripoint( ring_max, ring_max, 0 ), t_grass );
+    }
+    SECTION( "out of a ring open by a diagonal step across its side" ) {
+        build_ring();
+        // (35, 29) -> (36, 30) is the only way out, no straight step crosses there
+        here.ter_set( tripoint( ring_max, 30, 0 ), t_grass );
+        here.ter_set( tripoint( ring_max - 1, 30, 0 ), t_wall );
+    }
+
+    const std::vector<tripoint> exact = route_with( false, from, to );
+    const std::vector<tripoint> hierarchical = route_with( true, from, to );
+    check_route( exact, from, to );
+    check_route( hierarchical, from, to );
+    // Portal routes aren't always the shortest, but can't stray far from them
+    CHECK( hierarchical.size() <= exact.size() + 2 * SEEX );
+}
+
+TEST_CASE( "unreachable targets yield no route", "[pathfinding]" )
+{
+    clear_all_state();
+    Pathfinding::invalidate_level( 0 );
+    build_ring();
+
+    const tripoint inside( 30, 30, 0 );
+    const tripoint outside( 70, 50, 0 );
+
+    CHECK( route_with( false, inside, outside ).empty() );
+    CHECK( route_with( true, inside, outside ).empty() );
+    CHECK( route_with( true, outside, inside ).empty() );
+}
+
+TEST_CASE( "kept d_maps follow terrain changes", "[pathfinding]" )
+{
+    clear_all_state();
+    Pathfinding::invalidate_level( 0 );
+    override_option opt( "HIERARCHICAL_PATHFINDING", "false" );
+    Pathfinding::clear_d_maps();
+    map &here = get_map();
+
+    const tripoint from( 30, 30, 0 );
+    const tripoint to( 70, 50, 0 );
+    const auto set_wall = [&]( const ter_id & ter ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            if( y != 20 ) {
+                here.ter_set( tripoint( 50, y, 0 ), ter );
+            }
+        }
+    };
+
+    SECTION( "a wall built across the route is walked around" ) {
+        const std::vector<tripoint> before = Pathfinding::route( from, to );
+        check_route( before, from, to );
+
+        set_wall( t_wall );
+        // Same d_map, repaired around the wall
+        const std::vector<tripoint> repaired = Pathfinding::route( from, to );
+        check_route( repaired, from, to );
+        CHECK( repaired.size() > before.size() );
+        CHECK( repaired.size() == route_with( false, from, to ).size() );
+    }
+    SECTION( "a wall torn down opens the shorter route" ) {
+        set_wall( t_wall );
+        const std::vector<tripoint> before = Pathfinding::route( from, to );
+        check_route( before, from, to );
+
+        set_wall( t_grass );
+        // A tile getting cheaper can't be repaired, the d_map is built again
+        const std::vector<tripoint> rebuilt = Pathfinding::route( from, to );
+        check_route( rebuilt, from, to );
+        CHECK( rebuilt.size() < before.size() );
+        CHECK( rebuilt.size() == route_with( false, from, to ).size() );
+    }
+}
@@ -0,0 +1,50 @@
+#include "catch/catch.hpp"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "perf_telemetry.h"
+
+TEST_CASE( "turn timings are recorded per phase", "[telemetry]" )
+{
+    telemetry::reset();
+    {
+        telemetry::scoped_timer timer( telemetry::phase::monmove );
+        std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+    }
+    {
+        telemetry::scoped_timer timer( telemetry::phase::monmove );
+    }
+    telemetry::end_turn( 7 );
+
+    const std::vector<telemetry::turn_record> records = telemetry::history();
+    REQUIRE( records.size() == 1 );
+    const telemetry::turn_record &rec = records.front();
+    CHECK( rec.turn == 7 );
+    const size_t monmove = static_cast<size_t>( telemetry::phase::monmove );
+    CHECK( rec.micros[monmove] >= 2000 );
+    CHECK( rec.calls[monmove] == 2 );
+    const size_t draw = static_cast<size_t>( telemetry::phase::draw );
+    CHECK( rec.micros[draw] == 0 );
+    CHECK( rec.calls[draw] == 0 );
+    telemetry::reset();
+}
+
+TEST_CASE( "turn timing history keeps the most recent turns", "[telemetry]" )
+{
+    telemetry::reset();
+    const int total = static_cast<int>( telemetry::history_size ) + 10;
+    for( int turn = 0; turn < total; turn++ ) {
+        telemetry::end_turn( turn );
+    }
+
+    const std::vector<telemetry::turn_record> records = telemetry::history();
+    REQUIRE( records.size() == telemetry::history_size );
+    CHECK( records.front().turn == 10 );
+    CHECK( records.back().turn == total - 1 );
+    for( size_t i = 1; i < records.size(); i++ ) {
+        CHECK( records[i].turn == records[i - 1].turn + 1 );
+    }
+    telemetry::reset();
+}
@@ -0,0 +1,173 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <array>
+
+#include "game.h"
+#include "map.h"
+#include "point.h"
+#include "rng.h"
+#include "scent_map.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+static constexpr int scent_radius = 40;
+
+template<typename T>
+using scent_grid = std::array<std::array<T, MAPSIZE_Y>, MAPSIZE_X>;
+
+// The scalar diffusion scent_map::update used before it was vectorized.
+static void reference_update( scent_grid<int> &grscent, const tripoint &center, map &m )
+{
+    scent_grid<char> scent_transfer;
+    std::array < std::array < int, 3 + scent_radius * 2 >, 1 + scent_radius * 2 > new_scent;
+    std::array < std::array < int, 3 + scent_radius * 2 >, 1 + scent_radius * 2 > sum_3_scent_y;
+    std::array < std::array < char, 3 + scent_radius * 2 >, 1 + scent_radius * 2 > squares_used_y;
+
+    diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = m.access_cache(
+                center.z ).vehicle_obstructed_cache;
+
+    const int scentmap_minx = center.x - scent_radius;
+    const int scentmap_maxx = center.x + scent_radius;
+    const int scentmap_miny = center.y - scent_radius;
+    const int scentmap_maxy = center.y + scent_radius;
+
+    m.scent_blockers( scent_transfer, point( scentmap_minx - 1, scentmap_miny - 1 ),
+                      point( scentmap_maxx + 1, scentmap_maxy + 1 ) );
+
+    for( int x = 0; x < scent_radius * 2 + 3; ++x ) {
+        for( int y = 0; y < scent_radius * 2 + 1; ++y ) {
+            const point abs( x + scentmap_minx - 1, y + scentmap_miny );
+            sum_3_scent_y[y][x] = 0;
+            squares_used_y[y][x] = 0;
+            for( int i = abs.y - 1; i <= abs.y + 1; ++i ) {
+                sum_3_scent_y[y][x] += scent_transfer[abs.x][i] * grscent[abs.x][i];
+                squares_used_y[y][x] += scent_transfer[abs.x][i];
+            }
+        }
+    }
+
+    for( int x = 1; x < scent_radius * 2 + 2; ++x ) {
+        for( int y = 0; y < scent_radius * 2 + 1; ++y ) {
+            const point abs( x + scentmap_minx - 1, y + scentmap_miny );
+
+            int squares_used = squares_used_y[y][x - 1] + squares_used_y[y][x] + squares_used_y[y][x + 1];
+            int total = sum_3_scent_y[y][x - 1] + sum_3_scent_y[y][x] + sum_3_scent_y[y][x + 1];
+
+            if( blocked_cache[abs.x][abs.y].nw && scent_transfer[abs.x + 1][abs.y + 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x + 1][abs.y + 1];
+            }
+            if( blocked_cache[abs.x][abs.y].ne && scent_transfer[abs.x - 1][abs.y + 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x - 1][abs.y + 1];
+            }
+            if( blocked_cache[abs.x - 1][abs.y - 1].nw && scent_transfer[abs.x - 1][abs.y - 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x - 1][abs.y - 1];
+            }
+            if( blocked_cache[abs.x + 1][abs.y - 1].ne && scent_transfer[abs.x + 1][abs.y - 1] == 5 ) {
+                squares_used -= 4;
+                total -= 4 * grscent[abs.x + 1][abs.y - 1];
+            }
+
+            int temp_scent = grscent[abs.x][abs.y] * ( 250 - squares_used * scent_transfer[abs.x][abs.y] );
+            temp_scent -= grscent[abs.x][abs.y] * scent_transfer[abs.x][abs.y] * ( 45 - squares_used ) / 5;
+            new_scent[y][x] = ( temp_scent + total * scent_transfer[abs.x][abs.y] ) / 250;
+        }
+    }
+    for( int x = 1; x < scent_radius * 2 + 2; ++x ) {
+        for( int y = 0; y < scent_radius * 2 + 1; ++y ) {
+            grscent[x + scentmap_minx - 1][y + scentmap_miny] = new_scent[y][x];
+        }
+    }
+}
+
+static void randomize_scent( scent_map &sm, scent_grid<int> &copy )
+{
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            const int value = one_in( 3 ) ? rng( 0, 10000 ) : 0;
+            sm.set_unsafe( tripoint( x, y, 0 ), value );
+            copy[x][y] = value;
+        }
+    }
+}
+
+static int count_differences( const scent_map &sm, const scent_grid<int> &expected )
+{
+    int differing = 0;
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            if( sm.get_unsafe( tripoint( x, y, 0 ) ) != expected[x][y] ) {
+                differing++;
+            }
+        }
+    }
+    return differing;
+}
+
+TEST_CASE( "scent diffusion matches the scalar reference", "[scent]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    const ter_id t_brick_wall( "t_brick_wall" );
+    const ter_id t_door_c( "t_door_c" );
+    for( int i = 0; i < 200; i++ ) {
+        const tripoint p( rng( 0, MAPSIZE_X - 1 ), rng( 0, MAPSIZE_Y - 1 ), 0 );
+        here.ter_set( p, one_in( 2 ) ? t_brick_wall : t_door_c );
+    }
+    here.build_map_cache( 0 );
+
+    scent_map sm( *g );
+    scent_grid<int> expected;
+    randomize_scent( sm, expected );
+
+    const tripoint center( 60, 65, 0 );
+    for( int turn = 0; turn < 5; turn++ ) {
+        sm.update( center, here );
+        reference_update( expected, center, here );
+        CHECK( count_differences( sm, expected ) == 0 );
+    }
+
+    sm.decay();
+    for( auto &column : expected ) {
+        for( int &value : column ) {
+            value = std::max( 0, value - 1 );
+        }
+    }
+    CHECK( count_differences( sm, expected ) == 0 );
+}
+
+TEST_CASE( "scent diffusion benchmark", "[.][scent][benchmark]" )
+{
+    clear_all_state();
+    map &here = get_map();
+    here.build_map_cache( 0 );
+
+    scent_map sm( *g );
+    scent_grid<int> reference;
+    randomize_scent( sm, reference );
+    const tripoint center( 60, 60, 0 );
+
+    BENCHMARK( "scent update" ) {
+        sm.update( center, here );
+        return sm.get_unsafe( center );
+    };
+    BENCHMARK( "scalar reference update" ) {
+        reference_update( reference, center, here );
+        return reference[center.x][center.y];
+    };
+    BENCHMARK( "scent decay" ) {
+        sm.decay();
+        return sm.get_unsafe( center );
+    };
+    BENCHMARK( "scalar reference decay" ) {
+        for( auto &column : reference ) {
+            for( int &value : column ) {
+                value = std::max( 0, value - 1 );
+            }
+        }
+        return reference[center.x][center.y];
+    };
+}
@@ -0,0 +1,77 @@
+#include "catch/catch.hpp"
+
+#include <tuple>
+#include <vector>
+
+#include "sprite_batching.h"
+
+namespace
+{
+
+struct fake_sprite {
+    int texture;
+    int alpha;
+    int cell;
+    int order_in_cell;
+    size_t sequence;
+};
+
+} // namespace
+
+static std::vector<fake_sprite> sorted( std::vector<fake_sprite> sprites )
+{
+    for( size_t i = 0; i < sprites.size(); i++ ) {
+        sprites[i].sequence = i;
+    }
+    cata::sort_sprites_by_texture( sprites, []( const fake_sprite & s ) {
+        return s.alpha;
+    }, []( const fake_sprite & s ) {
+        return std::make_tuple( s.order_in_cell, s.texture, s.sequence );
+    } );
+    return sprites;
+}
+
+static std::vector<int> textures_of( const std::vector<fake_sprite> &sprites )
+{
+    std::vector<int> result;
+    for( const fake_sprite &s : sprites ) {
+        result.push_back( s.texture );
+    }
+    return result;
+}
+
+TEST_CASE( "sprites are grouped by texture within a blend state", "[tiles]" )
+{
+    // Three squares, each a floor with something on top
+    const std::vector<fake_sprite> result = sorted( {
+        { 1, -1, 0, 0, 0 }, { 2, -1, 0, 1, 0 },
+        { 3, -1, 1, 0, 0 }, { 2, -1, 1, 1, 0 },
+        { 1, -1, 2, 0, 0 }, { 3, -1, 2, 1, 0 },
+    } );
+    CHECK( textures_of( result ) == std::vector<int> { 1, 1, 3, 2, 2, 3 } );
+
+    // Every square still draws its floor before what is on top of it
+    for( int cell = 0; cell < 3; cell++ ) {
+        int last_order = -1;
+        for( const fake_sprite &s : result ) {
+            if( s.cell == cell ) {
+                CHECK( s.order_in_cell > last_order );
+                last_order = s.order_in_cell;
+            }
+        }
+    }
+}
+
+TEST_CASE( "sprites are not moved past a blend state change", "[tiles]" )
+{
+    // The faded sprite sets an alpha mod on texture 1 that the sprites after it inherit
+    const std::vector<fake_sprite> result = sorted( {
+        { 2, -1, 0, 0, 0 }, { 1, -1, 1, 0, 0 },
+        { 1, 128, 2, 0, 0 },
+        { 2, -1, 3, 0, 0 }, { 1, -1, 4, 0, 0 },
+    } );
+    CHECK( textures_of( result ) == std::vector<int> { 1, 2, 1, 1, 2 } );
+    REQUIRE( result[2].alpha == 128 );
+    CHECK( result[0].cell == 1 );
+    CHECK( result[3].cell == 4 );
+}
@@ -1,9 +1,21 @@
 #include "catch/catch.hpp"
 
-#include "submap.h"
+#include <sstream>
+#include <string>
+
+#include "calendar.h"
+#include "coordinate_conversions.h"
+#include "field.h"
+#include "field_type.h"
+#include "game.h"
 #include "game_constants.h"
 #include "int_id.h"
+#include "json.h"
+#include "mapdata.h"
 #include "point.h"
+#include "submap.h"
+#include "submap_binary.h"
+#include "trap.h"
 #include "type_id.h"
 
 TEST_CASE( "submap rotation", "[submap]" )
@@ -90,3 +102,129 @@ TEST_CASE( "submap rotation", "[submap]" )
         }
     }
 }
+
+TEST_CASE( "submap save generation tracking", "[submap]" )
+{
+    submap sm( tripoint_zero );
+
+    GIVEN( "a submap that was never saved" ) {
+        THEN( "it needs saving" ) {
+            CHECK( sm.needs_save() );
+        }
+    }
+
+    GIVEN( "a submap that was just saved" ) {
+        sm.mark_saved();
+        REQUIRE_FALSE( sm.needs_save() );
+
+        WHEN( "its terrain changes" ) {
+            sm.set_ter( point_zero, ter_id( 1 ) );
+            THEN( "it needs saving again" ) {
+                CHECK( sm.needs_save() );
+            }
+        }
+
+        WHEN( "only its last touched time changes" ) {
+            sm.last_touched = calendar::turn_zero + 1_hours;
+            THEN( "it doesn't need saving" ) {
+                CHECK_FALSE( sm.needs_save() );
+            }
+        }
+
+        WHEN( "its temperature is set to the same value" ) {
+            sm.set_temperature( sm.get_temperature() );
+            THEN( "it doesn't need saving" ) {
+                CHECK_FALSE( sm.needs_save() );
+            }
+        }
+    }
+}
+
+TEST_CASE( "submap binary format round trip", "[submap]" )
+{
+    const tripoint pos( 10, -4, 1 );
+    submap original( sm_to_ms_copy( pos ) );
+    original.set_all_ter( ter_str_id( "t_dirt" ).id() );
+    original.set_all_furn( f_null );
+    original.set_all_traps( tr_null );
+    original.set_ter( point( 3, 4 ), ter_str_id( "t_floor" ).id() );
+    original.set_furn( point( 3, 4 ), furn_str_id( "f_chair" ).id() );
+    original.set_trap( point( 5, 5 ), trap_str_id( "tr_beartrap" ).id() );
+    original.set_radiation( point( SEEX - 1, SEEY - 1 ), 7 );
+    original.get_field( point( 1, 2 ) ).add_field( field_type_str_id( "fd_blood" ).id(), 2,
+            1_turns );
+    original.set_temperature( -3 );
+    original.last_touched = calendar::turn_zero + 5_hours;
+
+    std::ostringstream out;
+    submap_binary::write_quad( out, { { pos, &original } } );
+
+    std::istringstream in( out.str() );
+    REQUIRE( submap_binary::is_binary_quad( in ) );
+
+    std::vector<std::pair<tripoint, std::unique_ptr<submap>>> loaded;
+    submap_binary::read_quad( in, [&]( const tripoint & p, std::unique_ptr<submap> sm ) {
+        loaded.emplace_back( p, std::move( sm ) );
+    } );
+    REQUIRE( loaded.size() == 1 );
+    CHECK( loaded[0].first == pos );
+
+    const submap &sm = *loaded[0].second;
+    for( int y = 0; y < SEEY; y++ ) {
+        for( int x = 0; x < SEEX; x++ ) {
+            const point p( x, y );
+            CHECK( sm.get_ter( p ) == original.get_ter( p ) );
+            CHECK( sm.get_furn( p ) == original.get_furn( p ) );
+            CHECK( sm.get_trap( p ) == original.get_trap( p ) );
+            CHECK( sm.get_radiation( p ) == original.get_radiation( p ) );
+            CHECK( sm.get_field( p ).field_count() == original.get_field( p ).field_count() );
+        }
+    }
+    const field_entry *blood = sm.get_field( point( 1, 2 ) ).find_field( field_type_str_id(
+                                   "fd_blood" ).id() );
+    REQUIRE( blood != nullptr );
+    CHECK( blood->get_field_intensity() == 2 );
+    CHECK( sm.field_count == 1 );
+    CHECK( sm.get_temperature() == -3 );
+    CHECK( sm.last_touched == original.last_touched );
+}
+
+TEST_CASE( "JSON quads are not mistaken for binary ones", "[submap]" )
+{
+    std::istringstream in( "[{\"version\":1}]" );
+    CHECK_FALSE( submap_binary::is_binary_quad( in ) );
+}
+
+TEST_CASE( "submap radiation survives a JSON round trip", "[submap]" )
+{
+    const tripoint pos( 10, -4, 1 );
+    submap original( sm_to_ms_copy( pos ) );
+    original.set_all_ter( ter_str_id( "t_dirt" ).id() );
+    original.set_all_furn( f_null );
+    original.set_all_traps( tr_null );
+    original.set_radiation( point( 3, 0 ), 2 );
+    original.set_radiation( point( SEEX - 1, SEEY - 1 ), 7 );
+
+    std::ostringstream out;
+    JsonOut jsout( out );
+    jsout.start_object();
+    original.store( jsout );
+    jsout.end_object();
+
+    std::istringstream in( out.str() );
+    JsonIn jsin( in );
+    submap loaded( sm_to_ms_copy( pos ) );
+    jsin.start_object();
+    while( !jsin.end_object() ) {
+        const std::string member_name = jsin.get_member_name();
+        loaded.load( jsin, member_name, savegame_version, multiply_xy( pos, SEEX ) );
+    }
+
+    for( int y = 0; y < SEEY; y++ ) {
+        for( int x = 0; x < SEEX; x++ ) {
+            const point p( x, y );
+            CAPTURE( p );
+            CHECK( loaded.get_radiation( p ) == original.get_radiation( p ) );
+        }
+    }
+}
@@ -0,0 +1,133 @@
+#include "catch/catch.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "thread_pool.h"
+
+TEST_CASE( "thread pool runs submitted tasks", "[thread_pool]" )
+{
+    cata::thread_pool pool( 2, 16 );
+
+    std::vector<std::future<int>> results;
+    for( int i = 0; i < 100; i++ ) {
+        results.push_back( pool.submit( [i]() {
+            return i * i;
+        } ) );
+    }
+    for( int i = 0; i < 100; i++ ) {
+        CHECK( results[i].get() == i * i );
+    }
+}
+
+TEST_CASE( "thread pool runs move-only tasks", "[thread_pool]" )
+{
+    cata::thread_pool pool( 2, 16 );
+
+    std::future<int> owned = pool.submit( [value = std::make_unique<int>( 7 )]() {
+        return *value;
+    } );
+    CHECK( owned.get() == 7 );
+
+    std::future<std::unique_ptr<int>> made = pool.submit( []() {
+        return std::make_unique<int>( 9 );
+    } );
+    std::unique_ptr<int> result = made.get();
+    REQUIRE( result );
+    CHECK( *result == 9 );
+}
+
+TEST_CASE( "thread pool reports exceptions through the future", "[thread_pool]" )
+{
+    cata::thread_pool pool( 1, 16 );
+    std::future<void> result = pool.submit( []() {
+        throw std::runtime_error( "oops" );
+    } );
+    CHECK_THROWS_AS( result.get(), std::runtime_error );
+}
+
+TEST_CASE( "thread pool skips cancelled tasks", "[thread_pool]" )
+{
+    cata::thread_pool pool( 1, 16 );
+
+    // Keep the only worker busy so the other tasks are still queued when cancelled.
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::future<void> blocker = pool.submit( [released]() {
+        released.wait();
+    } );
+
+    std::atomic<int> ran{ 0 };
+    cata::cancellation_token token;
+    std::vector<std::future<void>> cancelled;
+    for( int i = 0; i < 4; i++ ) {
+        cancelled.push_back( pool.submit( [&ran]() {
+            ran++;
+        }, cata::task_priority::normal, token ) );
+    }
+    token.cancel();
+    release.set_value();
+
+    blocker.get();
+    for( std::future<void> &f : cancelled ) {
+        CHECK_THROWS_AS( f.get(), cata::task_cancelled );
+    }
+    CHECK( ran == 0 );
+}
+
+TEST_CASE( "thread pool starts higher priority tasks first", "[thread_pool]" )
+{
+    cata::thread_pool pool( 1, 16 );
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::future<void> blocker = pool.submit( [released]() {
+        released.wait();
+    } );
+
+    std::vector<int> order;
+    std::future<void> low = pool.submit( [&order]() {
+        order.push_back( 2 );
+    }, cata::task_priority::low );
+    std::future<void> high = pool.submit( [&order]() {
+        order.push_back( 1 );
+    }, cata::task_priority::high );
+    release.set_value();
+
+    low.get();
+    high.get();
+    CHECK( order == std::vector<int> { 1, 2 } );
+}
+
+TEST_CASE( "thread pool runs tasks inline once the queue is full", "[thread_pool]" )
+{
+    cata::thread_pool pool( 1, 1 );
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::future<void> blocker = pool.submit( [released]() {
+        released.wait();
+    } );
+    // Give the worker time to pick up the blocker, so the queue is empty again.
+    while( pool.num_queued() > 0 ) {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    }
+
+    const std::thread::id caller = std::this_thread::get_id();
+    std::future<std::thread::id> queued = pool.submit( []() {
+        return std::this_thread::get_id();
+    } );
+    std::future<std::thread::id> inline_run = pool.submit( []() {
+        return std::this_thread::get_id();
+    } );
+    CHECK( inline_run.get() == caller );
+
+    release.set_value();
+    CHECK( queued.get() != caller );
+    blocker.get();
+}
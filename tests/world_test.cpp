@@ -0,0 +1,341 @@
+#include "catch/catch.hpp"
+
+#include <chrono>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <thread>
+
+#include "avatar.h"
+#include "cata_utility.h"
+#include "coordinate_conversions.h"
+#include "filesystem.h"
+#include "game.h"
+#include "map.h"
+#include "mapbuffer.h"
+#include "mapdata.h"
+#include "point.h"
+#include "sqlite3.h"
+#include "state_helpers.h"
+#include "string_formatter.h"
+#include "submap.h"
+#include "world.h"
+
+// The database only knows a quad is missing once a prefetch has read it.
+static bool wait_until_missing( const world &w, const tripoint &om_addr )
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds( 10 );
+    while( !w.is_map_quad_missing( om_addr ) ) {
+        if( std::chrono::steady_clock::now() > deadline ) {
+            return false;
+        }
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    }
+    return true;
+}
+
+static void check_saved_quads_are_not_missing( const save_format format )
+{
+    WORLDINFO info;
+    info.world_name = "quad_missing_test";
+    info.world_save_format = format;
+    remove_tree( info.folder_path() );
+
+    const tripoint saved( 3, 4, 0 );
+    const tripoint saved_above( 3, 4, 2 );
+    const tripoint never_saved( 5, 6, 0 );
+    {
+        world w( &info );
+        for( const tripoint &om_addr : {
+                 saved, saved_above
+             } ) {
+            REQUIRE( w.write_map_quad( om_addr, []( std::ostream & fout ) {
+                fout << "[]";
+            } ) );
+            CHECK_FALSE( w.is_map_quad_missing( om_addr ) );
+        }
+    }
+
+    // A new session doesn't remember what the last one wrote.
+    {
+        world w( &info );
+        w.prefetch_map_quads( { saved, saved_above, never_saved } );
+        CHECK( wait_until_missing( w, never_saved ) );
+        CHECK_FALSE( w.is_map_quad_missing( saved ) );
+        CHECK_FALSE( w.is_map_quad_missing( saved_above ) );
+    }
+
+    remove_tree( info.folder_path() );
+}
+
+TEST_CASE( "saved map quads are not reported missing", "[world]" )
+{
+    SECTION( "file saves" ) {
+        check_saved_quads_are_not_missing( save_format::V1 );
+    }
+    SECTION( "database saves" ) {
+        check_saved_quads_are_not_missing( save_format::V2_COMPRESSED_SQLITE3 );
+    }
+}
+
+TEST_CASE( "missing file quads are remembered until written", "[world]" )
+{
+    WORLDINFO info;
+    info.world_name = "quad_missing_cache_test";
+    info.world_save_format = save_format::V1;
+    remove_tree( info.folder_path() );
+
+    const tripoint om_addr( 3, 4, 0 );
+    world w( &info );
+    REQUIRE( w.is_map_quad_missing( om_addr ) );
+    // Written behind the world's back, so only the remembered answer says missing
+    const std::string quad_path = info.folder_path() + "/maps/0.0.0/3.4.0.map";
+    assure_dir_exist( info.folder_path() + "/maps/0.0.0" );
+    REQUIRE( write_to_file( quad_path, []( std::ostream & fout ) {
+        fout << "[]";
+    } ) );
+    CHECK( w.is_map_quad_missing( om_addr ) );
+
+    REQUIRE( w.write_map_quad( om_addr, []( std::ostream & fout ) {
+        fout << "[]";
+    } ) );
+    CHECK_FALSE( w.is_map_quad_missing( om_addr ) );
+
+    remove_tree( info.folder_path() );
+}
+
+static std::string read_quad( const world &w, const tripoint &om_addr )
+{
+    std::string contents = "<missing>";
+    w.read_map_quad( om_addr, [&]( std::istream & fin, const std::string & ) {
+        contents.assign( std::istreambuf_iterator<char>( fin ), std::istreambuf_iterator<char>() );
+    } );
+    return contents;
+}
+
+static void write_quad( const world &w, const tripoint &om_addr, const std::string &contents )
+{
+    REQUIRE( w.write_map_quad( om_addr, [&]( std::ostream & fout ) {
+        fout << contents;
+    } ) );
+}
+
+TEST_CASE( "prefetched quads are served without reading them again", "[world]" )
+{
+    WORLDINFO info;
+    info.world_name = "quad_prefetch_test";
+    info.world_save_format = save_format::V2_COMPRESSED_SQLITE3;
+    remove_tree( info.folder_path() );
+
+    const tripoint saved( 3, 4, 0 );
+    const tripoint never_saved( 5, 6, 0 );
+    const tripoint marker( 7, 8, 0 );
+    world w( &info );
+    write_quad( w, saved, "[1]" );
+
+    // Prefetches are read in order, so everything before the marker is staged once it is
+    w.prefetch_map_quads( { saved, never_saved, marker } );
+    REQUIRE( wait_until_missing( w, marker ) );
+    CHECK( w.is_map_quad_missing( never_saved ) );
+
+    SECTION( "saved and missing quads are hits" ) {
+        CHECK( read_quad( w, saved ) == "[1]" );
+        CHECK( read_quad( w, never_saved ) == "<missing>" );
+        CHECK( w.get_map_prefetch_stats().hits == 2 );
+        CHECK( w.get_map_prefetch_stats().misses == 0 );
+    }
+    SECTION( "quads written after the prefetch are read again" ) {
+        write_quad( w, saved, "[2]" );
+        write_quad( w, never_saved, "[3]" );
+        CHECK_FALSE( w.is_map_quad_missing( never_saved ) );
+        CHECK( read_quad( w, saved ) == "[2]" );
+        CHECK( read_quad( w, never_saved ) == "[3]" );
+        CHECK( w.get_map_prefetch_stats().hits == 0 );
+        CHECK( w.get_map_prefetch_stats().stale == 2 );
+    }
+    SECTION( "quads written in an unfinished save are read again" ) {
+        w.start_save_tx();
+        write_quad( w, saved, "[2]" );
+        CHECK( read_quad( w, saved ) == "[2]" );
+        w.commit_save_tx();
+        CHECK( w.get_map_prefetch_stats().hits == 0 );
+        CHECK( w.get_map_prefetch_stats().stale == 1 );
+    }
+
+    remove_tree( info.folder_path() );
+}
+
+TEST_CASE( "only uncommitted quad writes are remembered", "[world]" )
+{
+    WORLDINFO info;
+    info.world_name = "quad_write_epochs_test";
+    info.world_save_format = save_format::V2_COMPRESSED_SQLITE3;
+    remove_tree( info.folder_path() );
+
+    world w( &info );
+    // A prefetch that is never taken doesn't hold on to anything
+    w.prefetch_map_quads( { tripoint( -1, -1, 0 ) } );
+    REQUIRE( wait_until_missing( w, tripoint( -1, -1, 0 ) ) );
+
+    for( int x = 0; x < 1000; x++ ) {
+        write_quad( w, tripoint( x, 0, 0 ), "[]" );
+    }
+    CHECK( w.get_tracked_map_quad_writes() == 0 );
+
+    w.start_save_tx();
+    for( int x = 0; x < 100; x++ ) {
+        write_quad( w, tripoint( x, 1, 0 ), "[]" );
+    }
+    CHECK( w.get_tracked_map_quad_writes() == 100 );
+    w.commit_save_tx();
+    CHECK( w.get_tracked_map_quad_writes() == 0 );
+
+    remove_tree( info.folder_path() );
+}
+
+TEST_CASE( "pregenerated terrain loads without generating again", "[world][map]" )
+{
+    clear_all_state();
+    // Far enough from the reality bubble that nothing has touched it.
+    const tripoint omt = get_avatar().global_omt_location().raw() + tripoint( 30, 0, 0 );
+    const tripoint sm = omt_to_sm_copy( omt );
+    REQUIRE_FALSE( MAPBUFFER.is_submap_loaded( sm ) );
+
+    world &w = *g->get_active_world();
+    w.prefetch_map_quads( { omt } );
+    REQUIRE( wait_until_missing( w, omt ) );
+
+    g->pregenerate_map( { omt } );
+    REQUIRE( MAPBUFFER.is_submap_loaded( sm ) );
+
+    // Generating the submap again would overwrite the marker.
+    submap *pregenerated = MAPBUFFER.lookup_submap( sm );
+    const ter_id marker = pregenerated->get_ter( point_zero ) == t_floor ? t_dirt : t_floor;
+    pregenerated->set_ter( point_zero, marker );
+
+    tinymap tm;
+    tm.load( tripoint_abs_sm( sm ), false );
+    CHECK( tm.ter( tripoint( point_zero, omt.z ) ) == marker );
+}
+
+TEST_CASE( "submaps of a failed save are written again", "[world][map]" )
+{
+    clear_all_state();
+    world &w = *g->get_active_world();
+    REQUIRE( w.info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 );
+    // Tests don't save the map unless told to.
+    restore_on_out_of_scope<bool> restore_disable_mapgen( disable_mapgen );
+    disable_mapgen = false;
+
+    submap *sm = MAPBUFFER.lookup_submap( get_map().get_abs_sub() );
+    REQUIRE( sm != nullptr );
+    sm->is_uniform = false;
+    sm->mark_modified();
+    REQUIRE( sm->needs_save() );
+
+    // A reader in the middle of a transaction keeps the save from committing.
+    sqlite3 *reader = nullptr;
+    REQUIRE( sqlite3_open_v2( ( w.info->folder_path() + "/map.sqlite3" ).c_str(), &reader,
+                              SQLITE_OPEN_READONLY, nullptr ) == SQLITE_OK );
+    REQUIRE( sqlite3_exec( reader, "BEGIN; SELECT count(*) FROM files;", nullptr, nullptr,
+                           nullptr ) == SQLITE_OK );
+
+    w.start_save_tx();
+    MAPBUFFER.save();
+    CHECK_THROWS( w.commit_save_tx() );
+    CHECK( sm->needs_save() );
+
+    sqlite3_exec( reader, "COMMIT", nullptr, nullptr, nullptr );
+    sqlite3_close( reader );
+
+    w.start_save_tx();
+    MAPBUFFER.save();
+    CHECK( MAPBUFFER.get_num_quads_written() > 0 );
+    w.commit_save_tx();
+    CHECK_FALSE( sm->needs_save() );
+}
+
+static int map_db_query_int( const WORLDINFO &info, const char *sql )
+{
+    sqlite3 *db = nullptr;
+    REQUIRE( sqlite3_open_v2( ( info.folder_path() + "/map.sqlite3" ).c_str(), &db,
+                              SQLITE_OPEN_READWRITE, nullptr ) == SQLITE_OK );
+    sqlite3_stmt *stmt = nullptr;
+    REQUIRE( sqlite3_prepare_v2( db, sql, -1, &stmt, nullptr ) == SQLITE_OK );
+    const int ret = sqlite3_step( stmt ) == SQLITE_ROW ? sqlite3_column_int( stmt, 0 ) : -1;
+    sqlite3_finalize( stmt );
+    sqlite3_close( db );
+    return ret;
+}
+
+TEST_CASE( "map writes switch to a dictionary trained in the background", "[world]" )
+{
+    WORLDINFO info;
+    info.world_name = "map_dictionary_test";
+    info.world_save_format = save_format::V2_COMPRESSED_SQLITE3;
+    remove_tree( info.folder_path() );
+
+    const auto quad_json = []( const tripoint & om_addr ) {
+        return string_format(
+                   R"([{"version":33,"coordinates":[%d,%d,0],"turn_last_touched":1,"temperature":0,)"
+                   R"("terrain":[["t_grass",100],"t_dirt",["t_floor",43]],"furniture":[[1,2,"f_chair"]],)"
+                   R"("items":[3,4,[{"typeid":"rock","charges":0,"birthday":0}]],"traps":[],"fields":[]}])",
+                   om_addr.x * 2, om_addr.y * 2 );
+    };
+    const auto write_quads = [&]( world & w, const int from, const int to ) {
+        w.start_save_tx();
+        for( int i = from; i < to; i++ ) {
+            const tripoint om_addr( i % 32, i / 32, 0 );
+            REQUIRE( w.write_map_quad( om_addr, [&]( std::ostream & fout ) {
+                fout << quad_json( om_addr );
+            } ) );
+        }
+        w.commit_save_tx();
+    };
+
+    {
+        world w( &info );
+        // Too few quads to train on
+        write_quads( w, 0, 100 );
+        write_quads( w, 0, 100 );
+        CHECK( map_db_query_int( info, "SELECT count(*) FROM dictionaries" ) == 0 );
+
+        write_quads( w, 100, 300 );
+        // Training runs in the background, it is picked up by a later save
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds( 30 );
+        while( map_db_query_int( info, "SELECT count(*) FROM dictionaries" ) == 0 &&
+               std::chrono::steady_clock::now() < deadline ) {
+            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+            write_quads( w, 300, 301 );
+        }
+        REQUIRE( map_db_query_int( info, "SELECT count(*) FROM dictionaries" ) == 1 );
+        CHECK( map_db_query_int( info, "PRAGMA user_version" ) == 1 );
+
+        write_quads( w, 0, 1 );
+        CHECK( map_db_query_int( info, "SELECT count(*) FROM files WHERE path = 'maps/0.0.0/0.0.0.map' "
+                                 "AND compression LIKE 'zlib_dict:%'" ) == 1 );
+    }
+
+    // Rows written with the dictionary read back in a new session
+    {
+        world w( &info );
+        const tripoint om_addr( 0, 0, 0 );
+        std::string read;
+        REQUIRE( w.read_map_quad( om_addr, [&]( std::istream & fin, const std::string & ) {
+            read.assign( std::istreambuf_iterator<char>( fin ), std::istreambuf_iterator<char>() );
+        } ) );
+        CHECK( read == quad_json( om_addr ) );
+    }
+
+    SECTION( "newer map data is refused" ) {
+        sqlite3 *db = nullptr;
+        REQUIRE( sqlite3_open_v2( ( info.folder_path() + "/map.sqlite3" ).c_str(), &db,
+                                  SQLITE_OPEN_READWRITE, nullptr ) == SQLITE_OK );
+        REQUIRE( sqlite3_exec( db, "PRAGMA user_version = 99", nullptr, nullptr, nullptr ) == SQLITE_OK );
+        sqlite3_close( db );
+        CHECK_THROWS( world( &info ) );
+    }
+
+    remove_tree( info.folder_path() );
+}